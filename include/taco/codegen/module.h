@@ -2,6 +2,7 @@
 #define TACO_MODULE_H
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
 #include <utility>
@@ -11,6 +12,8 @@
 #include "taco/ir/ir.h"
 
 namespace taco {
+class Allocator;
+
 namespace ir {
 
 class Module {
@@ -22,6 +25,9 @@ public:
     setJITTmpdir();
   }
 
+  /// Releases the workspaces that the compiled functions keep across calls
+  ~Module();
+
   /// Compile the source into a library, returning its full path
   std::string compile();
   
@@ -65,6 +71,10 @@ public:
   
   /// Set the source of the module
   void setSource(std::string source);
+
+  /// Returns the allocator that the compiled functions allocate with, which
+  /// is the allocator that was installed when the module was compiled.
+  std::shared_ptr<Allocator> getAllocator() const;
   
 private:
   std::stringstream source;
@@ -72,6 +82,7 @@ private:
   std::string libname;
   std::string tmpdir;
   void* lib_handle;
+  std::shared_ptr<Allocator> allocator;
   std::vector<Stmt> funcs;
   
   // true iff the module was created from user-provided source
@@ -81,6 +92,7 @@ private:
   
   void setJITLibname();
   void setJITTmpdir();
+  void releaseWorkspaces();
 
   static std::string chars;
   static std::default_random_engine gen;
@@ -19,6 +19,8 @@ extern const std::string expr_einsum_missformed;
 // compile error messages
 extern const std::string compile_without_expr;
 extern const std::string compile_tensor_name_collision;
+extern const std::string compile_dictionary_encoded_result;
+extern const std::string compile_symmetric_result;
 
 // assemble error messages
 extern const std::string assemble_without_compile;
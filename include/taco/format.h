@@ -67,10 +67,55 @@ public:
   /// Sets the types of the coordinate arrays for each level
   void setLevelArrayTypes(std::vector<std::vector<Datatype>> levelArrayTypes);
 
+  /// Returns true if tensors of this format are symmetric in two of their
+  /// modes and store only one triangle of the symmetric components.
+  bool isSymmetric() const;
+
+  /// Gets the two modes in which tensors of this format are symmetric, or an
+  /// empty vector if they are not symmetric.
+  const std::vector<int>& getSymmetricModes() const;
+
+  /// Declares that tensors of this format are symmetric in modes `modes[0]`
+  /// and `modes[1]`. Only the components whose coordinate in `modes[0]` is at
+  /// least their coordinate in `modes[1]` (the lower triangle of a matrix) are
+  /// stored, and kernels apply every stored off-diagonal component also as
+  /// its mirrored component.
+  void setSymmetricModes(std::vector<int> modes);
+
+  /// Returns true if tensors of this format are pattern tensors, which store
+  /// the coordinates of their nonzero components but no values.
+  bool isPattern() const;
+
+  /// Declares whether tensors of this format are pattern tensors. Every
+  /// stored component of a pattern tensor has the value one (true for Bool
+  /// tensors), so pattern tensors have no values array and kernels read no
+  /// values from them.
+  void setPattern(bool pattern);
+
+  /// Returns true if the values of tensors of this format are dictionary
+  /// encoded.
+  bool isDictionaryEncoded() const;
+
+  /// Gets the type of the codes of dictionary-encoded values, or an undefined
+  /// type if the values are not encoded.
+  Datatype getValueCodeType() const;
+
+  /// Declares that the values of tensors of this format are dictionary
+  /// encoded with codes of type `codeType` (UInt8 or UInt16), or that they
+  /// are not encoded if `codeType` is undefined. The values array of an
+  /// encoded tensor stores, for every component, the index of its value in a
+  /// dictionary of the distinct values of the tensor, and kernels decode the
+  /// values through the dictionary. Encoded tensors are packed from inserted
+  /// components and can only be read by kernels.
+  void setValueEncoding(Datatype codeType);
+
 private:
   std::vector<ModeFormatPack> modeFormatPacks;
   std::vector<int> modeOrdering;
   std::vector<std::vector<Datatype>> levelArrayTypes;
+  std::vector<int> symmetricModes;
+  bool pattern = false;
+  Datatype valueCodeType;
 };
 
 bool operator==(const Format&, const Format&);
@@ -87,12 +132,22 @@ public:
   static ModeFormat dense;       /// e.g., first mode in CSR
   static ModeFormat compressed;  /// e.g., second mode in CSR
   static ModeFormat singleton;   /// e.g., second mode in COO
+  static ModeFormat hashed;      /// e.g., random-access sparse outputs
+  static ModeFormat bitmap;      /// e.g., medium-density rows
+  static ModeFormat ell;         /// e.g., second mode in ELLPACK
+  static ModeFormat dia;         /// e.g., second mode in DIA
+  static ModeFormat rle;         /// e.g., rows with runs of nonzeros
 
   static ModeFormat sparse;      /// alias for compressed
   static ModeFormat Dense;       /// alias for dense
   static ModeFormat Compressed;  /// alias for compressed
   static ModeFormat Sparse;      /// alias for compressed
   static ModeFormat Singleton;   /// alias for singleton
+  static ModeFormat Hashed;      /// alias for hashed
+  static ModeFormat Bitmap;      /// alias for bitmap
+  static ModeFormat Ell;         /// alias for ell
+  static ModeFormat Dia;         /// alias for dia
+  static ModeFormat Rle;         /// alias for rle
 
   /// Properties of a mode format
   enum Property {
@@ -190,21 +245,54 @@ extern const ModeFormat Dense;
 extern const ModeFormat Compressed;
 extern const ModeFormat Sparse;
 extern const ModeFormat Singleton;
+extern const ModeFormat Hashed;
+extern const ModeFormat Bitmap;
+extern const ModeFormat Ell;
+extern const ModeFormat Dia;
+extern const ModeFormat Rle;
 
 extern const ModeFormat dense;
 extern const ModeFormat compressed;
 extern const ModeFormat sparse;
 extern const ModeFormat singleton;
+extern const ModeFormat hashed;
+extern const ModeFormat bitmap;
 
 extern const Format CSR;
 extern const Format CSC;
 extern const Format DCSR;
 extern const Format DCSC;
+extern const Format ELL;
+extern const Format RLE;
+extern const Format BCSR;
 
 const Format COO(int order, bool isUnique = true, bool isOrdered = true, 
                  bool isAoS = false, const std::vector<int>& modeOrdering = {});
+
+/// Returns a blocked compressed sparse fiber format for tensors of the given
+/// order, whose first `order` levels compress blocks and whose last `order`
+/// levels store dense blocks (see makeBlocked).
+const Format BCSF(int order);
+
+/// Returns a DIA format that stores the diagonals with the given offsets of a
+/// matrix, where the offset of diagonal A(i,j) is j-i. Every row stores one
+/// slot per diagonal plus an overflow slot that receives components off the
+/// diagonals. Packing such components is an error, while kernels that compute
+/// into DIA results drop them.
+const Format DIA(const std::vector<int>& offsets);
 /// @}
 
+/// Returns the narrowest integer type that can store every coordinate of a 
+/// mode with the given dimension (8-bit, 16-bit or 32-bit).
+Datatype narrowestCoordinateType(int dimension);
+
+/// Returns a copy of the format where the coordinate (`crd`) arrays of 
+/// compressed and singleton levels store coordinates in the narrowest type 
+/// that can represent the corresponding mode dimension.  For example, a CSR 
+/// matrix with fewer than 65537 columns stores 16-bit column coordinates.
+Format narrowCoordinateTypes(const Format& format,
+                             const std::vector<int>& dimensions);
+
 /// True if all modes are dense.
 bool isDense(const Format&);
 
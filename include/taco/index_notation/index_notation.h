@@ -359,6 +359,8 @@ public:
   Literal(long);
   Literal(long long);
   Literal(int8_t);
+  Literal(float16);
+  Literal(bfloat16);
   Literal(float);
   Literal(double);
   Literal(std::complex<float>);
@@ -627,10 +629,15 @@ public:
   /// variables sizes therefore equals the size of the original index
   /// variable.  Note that in the generated code, when the size of the
   /// inner index variable does not perfectly divide the original index
-  /// variable, a \textit{tail strategy} is employed such as emitting a variable
-  /// sized loop that handles remaining iterations.
+  /// variable, a \textit{tail strategy} handles the remaining iterations:
+  /// TailStrategy::GuardWithIf guards every iteration of the inner loop,
+  /// whereas TailStrategy::Peel checks once per outer iteration whether the
+  /// inner loop may run past the original index variable and, only if so,
+  /// runs a guarded copy of the inner loop, which leaves the main inner loop
+  /// branch-free (e.g., for vectorization and unrolling).
   /// Preconditions: splitFactor is a positive nonzero integer
-  IndexStmt split(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFactor) const; // TODO: TailStrategy
+  IndexStmt split(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFactor,
+                  TailStrategy tailStrategy=TailStrategy::GuardWithIf) const;
 
   /// The divide transformation splits one index variable into
   /// two nested index variables, where the size of the outer
@@ -641,9 +648,11 @@ public:
   /// starting point of a tile can require an $O(n)$ or $O(\log (n))$
   /// search.  Therefore, if we want to parallelize a blocked
   /// loop, then we want a fixed number of blocks and not a number
-  /// proportional to the tensor size.
+  /// proportional to the tensor size.  The last block may be shorter, which
+  /// is handled by a tail strategy as for split.
   /// Preconditions: divideFactor is a positive nonzero integer
-  IndexStmt divide(IndexVar i, IndexVar i1, IndexVar i2, size_t divideFactor) const; // TODO: TailStrategy
+  IndexStmt divide(IndexVar i, IndexVar i1, IndexVar i2, size_t divideFactor,
+                   TailStrategy tailStrategy=TailStrategy::GuardWithIf) const;
 
 
   /// The reorder transformation swaps two directly nested index
@@ -765,7 +774,14 @@ public:
 
   /// The precompute transformation is described in kjolstad2019
   /// allows us to leverage scratchpad memories and
-  /// reorder computations to increase locality
+  /// reorder computations to increase locality.
+  /// Workspace vectors that are stored in a hashed level (e.g., with
+  /// `Format({Hashed})`) accumulate into hash tables that are sized to the
+  /// number of values scattered into them (see WorkspaceStrategy::Hash), which
+  /// suits workspaces whose dense counterparts would be too large.  Hashed
+  /// workspaces must be vectors whose values are copied to a sparse result;
+  /// a high-order contraction must therefore precompute into a hashed
+  /// workspace vector inside the loops over its other workspace dimensions.
   IndexStmt precompute(IndexExpr expr, IndexVar i, IndexVar iw, TensorVar workspace) const;
 
   ///  The precompute transformation is described in kjolstad2019
@@ -785,7 +801,11 @@ public:
   IndexStmt bound(IndexVar i, IndexVar i1, size_t bound, BoundType bound_type) const;
 
   /// The unroll primitive unrolls the corresponding loop by a statically-known
-  /// integer number of iterations
+  /// integer number of iterations, followed by a loop over the remaining
+  /// iterations. Loops nested in the unrolled loop whose bounds do not depend
+  /// on it, such as a loop over the nonzeros of a sparse row, are jammed so
+  /// that a single loop runs the unrolled iterations together
+  /// (unroll-and-jam).
   /// Preconditions: unrollFactor is a positive nonzero integer
   IndexStmt unroll(IndexVar i, size_t unrollFactor) const;
 
@@ -809,6 +829,19 @@ public:
   /// Workspace can be accessed by the IndexVars in the accelIndexVars.
   IndexStmt wsaccel(TensorVar& ws, bool shouldAccel = true,const std::vector<IndexVar>& accelIndexVars ={});
 
+  /// The wsstrategy primitive specifies how an accelerated workspace vector
+  /// accumulates the values that are scattered into it (see
+  /// WorkspaceStrategy).  Dense workspaces are sized to the dimension, while
+  /// hash and heap workspaces only grow to the number of values scattered
+  /// into them, which makes them suit wide rows of sparse matrix products
+  /// that have few nonzeros.
+  ///
+  /// Preconditions:
+  /// The workspace is the temporary of a where statement and can be
+  /// accelerated (see wsaccel), and heap workspaces are accumulated by
+  /// additions.
+  IndexStmt wsstrategy(TensorVar& ws, WorkspaceStrategy strategy);
+
   /// Casts index statement to specified subtype.
   template <typename SubType>
   SubType as() {
@@ -834,8 +867,11 @@ public:
   Assignment(const AssignmentNode*);
 
   /// Create an assignment. Can specify an optional operator `op` that turns the
-  /// assignment into a compound assignment, e.g. `+=`.
-  Assignment(Access lhs, IndexExpr rhs, IndexExpr op = IndexExpr());
+  /// assignment into a compound assignment, e.g. `+=`, and an optional type
+  /// `accumulatorType` in which the right-hand side is computed and reduced
+  /// before it is converted to the type of the left-hand side.
+  Assignment(Access lhs, IndexExpr rhs, IndexExpr op = IndexExpr(),
+             Datatype accumulatorType = Datatype());
 
   /// Create an assignment. Can specify an optional operator `op` that turns the
   /// assignment into a compound assignment, e.g. `+=`. Additionally, specify
@@ -854,6 +890,10 @@ public:
   /// expression if the assignment is not compound (`=`).
   IndexExpr getOperator() const;
 
+  /// Return the type in which the right-hand side is computed and reduced, or
+  /// an undefined type if it is computed in the type of the left-hand side.
+  Datatype getAccumulatorType() const;
+
   /// Return the free index variables in the assignment, which are those used to
   /// access the left-hand side.
   const std::vector<IndexVar>& getFreeVars() const;
@@ -1196,6 +1236,14 @@ public:
   /// Set the acceleration dimensions
   void setAccelIndexVars(const std::vector<IndexVar>& accelIndexVars, bool shouldAccel);
 
+  /// Gets the strategy that the tensor variable accumulates with when it is
+  /// used as an accelerated workspace
+  WorkspaceStrategy getWorkspaceStrategy() const;
+
+  /// Set the strategy that the tensor variable accumulates with when it is
+  /// used as an accelerated workspace
+  void setWorkspaceStrategy(WorkspaceStrategy strategy);
+
   /// Set the fill value of the tensor variable
   void setFill(const Literal& fill);
 
@@ -1366,6 +1414,11 @@ IndexStmt generatePackStmt(TensorVar tensor,
                            std::string otherName, Format otherFormat, 
                            std::vector<IndexVar> indexVars, bool otherIsOnRight);
 
+/// Returns `packStmt`, which packs `result`, scheduled to assemble `result`
+/// with ungrouped insertion (see IndexStmt::assemble) if its levels cannot be
+/// assembled by appending coordinates in order.
+IndexStmt setPackAssembleStrategy(IndexStmt packStmt, TensorVar result);
+
 /// Same as generatePackStmt, where otherFormat is COO.
 IndexStmt generatePackCOOStmt(TensorVar tensor, 
                               std::vector<IndexVar> indexVars, bool otherIsOnRight);
@@ -373,8 +373,9 @@ struct IndexVarNode::Content {
 
 // Index Statements
 struct AssignmentNode : public IndexStmtNode {
-  AssignmentNode(const Access& lhs, const IndexExpr& rhs, const IndexExpr& op)
-      : lhs(lhs), rhs(rhs), op(op) {}
+  AssignmentNode(const Access& lhs, const IndexExpr& rhs, const IndexExpr& op,
+                 Datatype accumulatorType = Datatype())
+      : lhs(lhs), rhs(rhs), op(op), accumulatorType(accumulatorType) {}
 
   void accept(IndexStmtVisitorStrict* v) const {
     v->visit(this);
@@ -383,6 +384,7 @@ struct AssignmentNode : public IndexStmtNode {
   Access    lhs;
   IndexExpr rhs;
   IndexExpr op;
+  Datatype  accumulatorType;
 };
 
 struct YieldNode : public IndexStmtNode {
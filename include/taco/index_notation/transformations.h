@@ -234,9 +234,39 @@ std::ostream &operator<<(std::ostream &, const SetMergeStrategy&);
  * The preconditions are:
  * 1. The loop iterates over only one data structure,
  * 2. Every result iterator has the insert capability, and
- * 3. No cross-thread reductions.
+ * 3. No cross-thread reductions, unless `privatizeReductions` is set and the
+ *    threads can accumulate the reductions into private copies of dense
+ *    results (see OutputRaceStrategy::Temporary).
  */
-IndexStmt parallelizeOuterLoop(IndexStmt stmt);
+IndexStmt parallelizeOuterLoop(IndexStmt stmt, 
+                               bool privatizeReductions = false);
+
+/**
+ * Parallelize the two outer forall loops over CPU threads such that threads
+ * compute with about the same number of nonzeros, which balances the load of
+ * matrices whose rows have very different numbers of nonzeros (e.g., 
+ * power-law graphs).  The loops are fused and iterate over the positions of 
+ * the second level of a sparse operand, whose nonzeros are partitioned into 
+ * chunks of `chunkSize` nonzeros.  Every chunk finds its first row by binary 
+ * searching the level's pos array, so rows with many nonzeros are split across 
+ * chunks, and rows split across chunks are reduced into the result with 
+ * atomics.  Returns an undefined statement if the outer loops do not iterate 
+ * over a row-major operand with a dense first level and a sparse second 
+ * level, or cannot be parallelized.
+ */
+IndexStmt parallelizeOuterLoopsByNonzeros(IndexStmt stmt, size_t chunkSize);
+
+/**
+ * Parallelize the outer forall loop of a computation whose result has sparse
+ * levels that are assembled by appending, which must be serial.  The result
+ * is instead assembled in two phases (see SetAssembleStrategy): a parallel 
+ * loop counts the entries of every result segment, the counts are combined 
+ * into the pos arrays by a parallel prefix sum, and a parallel loop then 
+ * inserts the coordinates and values of every segment.  Returns an undefined 
+ * statement if the result cannot be assembled by insertion or the loops 
+ * cannot be parallelized.
+ */
+IndexStmt parallelizeAssembly(IndexStmt stmt);
 
 /**
  * Topologically reorder ForAlls so that all tensors are iterated in order.
@@ -258,5 +288,25 @@ IndexStmt scalarPromote(IndexStmt stmt);
  */
 IndexStmt insertTemporaries(IndexStmt stmt);
 
+/**
+ * Returns the strategy that a workspace vector of `dimension` components
+ * should accumulate with when about `rowSize` of its components are
+ * accumulated into at a time (e.g., the expected number of nonzeros in a row
+ * of a sparse matrix product).  Dense workspaces are chosen when they are small
+ * enough to stay in cache or when rows fill a good part of them, heaps when
+ * rows are tiny, and hash tables otherwise.
+ */
+WorkspaceStrategy chooseWorkspaceStrategy(double rowSize, int64_t dimension);
+
+/**
+ * Returns whether `numThreads` threads that compute about `work` components 
+ * (e.g., the nonzeros of a sparse operand) and reduce them into a dense result
+ * of `resultSize` components should accumulate into private copies of the 
+ * result.  Reducing the private copies touches numThreads * resultSize
+ * components, so they pay off when the result is small relative to the work.
+ */
+bool shouldPrivatizeReductions(int64_t resultSize, int64_t work, 
+                               int numThreads);
+
 }
 #endif
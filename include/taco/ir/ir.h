@@ -80,7 +80,8 @@ enum class TensorProperty {
   Indices,
   Values,
   FillValue,
-  ValuesSize
+  ValuesSize,
+  ValuesDictionary
 };
 
 /** Base class for backend IR */
@@ -713,9 +714,11 @@ struct Allocate : public StmtNode<Allocate> {
   Expr old_elements; // used for realloc in CUDA
   bool is_realloc;
   bool clear; // Whether to use calloc to allocate this memory.
+  bool pooled; // Whether to reuse the memory of previous kernel invocations.
   
   static Stmt make(Expr var, Expr num_elements, bool is_realloc=false,
-                   Expr old_elements=Expr(), bool clear=false);
+                   Expr old_elements=Expr(), bool clear=false,
+                   bool pooled=false);
   
   static const IRNodeType _type_info = IRNodeType::Allocate;
 };
@@ -792,6 +795,11 @@ struct GetProperty : public ExprNode<GetProperty> {
   static Expr make(Expr tensor, TensorProperty property, int mode=0);
   static Expr make(Expr tensor, TensorProperty property, int mode,
                    int index, std::string name);
+
+  /// Construct an index array property whose elements are of the given type
+  /// (e.g., a `crd` array of 16-bit coordinates).
+  static Expr make(Expr tensor, TensorProperty property, int mode,
+                   int index, std::string name, Datatype type);
   
   static const IRNodeType _type_info = IRNodeType::GetProperty;
 };
@@ -27,5 +27,20 @@ Stmt doubleSizeIfFull(Expr a, Expr size, Expr loc);
 /// least equal to `loc` if it is full (loc cannot be written to).
 Stmt atLeastDoubleSizeIfFull(Expr a, Expr size, Expr loc);
 
+/// Generate a statement that replaces `a[0..size)` by its inclusive prefix 
+/// sum.  The sum is computed by CPU threads in parallel, which scan one block 
+/// of the array each before adding the sums of the preceding blocks.
+Stmt parallelPrefixSum(Expr a, Expr size);
+
+/// Unroll the serial loops in `stmt` that have an unroll factor. Every
+/// iteration of an unrolled loop runs as many copies of the loop body as the
+/// unroll factor, and a remainder loop runs the iterations that do not fill a
+/// block of copies; loops that run exactly one block of copies are replaced
+/// by it. Loops nested in the body whose bounds do not depend on the
+/// unrolled loop are jammed: a single copy of them runs the copies of their
+/// bodies (unroll-and-jam). Loops that cannot be unrolled keep their unroll
+/// factor.
+Stmt unrollLoops(Stmt stmt);
+
 }}
 #endif
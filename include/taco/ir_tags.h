@@ -4,7 +4,8 @@
 namespace taco {
 
 /// ParallelUnit::CPUThread generates a pragma to parallelize over CPU threads
-/// ParallelUnit::CPUVector generates a pragma to utilize a CPU vector unit
+/// ParallelUnit::CPUVector generates explicit vector code to utilize a CPU vector unit
+///   (loops whose bodies are not straight-line code fall back to a vectorization pragma)
 /// ParallelUnit::GPUBlock must be used with GPUThread to create blocks of GPU threads
 /// ParallelUnit::GPUWarp can be optionally used to allow for GPU warp-level primitives
 /// ParallelUnit::GPUThread causes for every iteration to be executed on a separate GPU thread
@@ -16,7 +17,10 @@ extern const char *ParallelUnit_NAMES[];
 /// OutputRaceStrategy::NoRaces raises a compile-time error if an output race exists
 /// OutputRaceStrategy::Atomics replace racing instructions with atomics
 /// OutputRaceStrategy::Temporary uses a temporary array for outputs that is serially reduced
+///   (on CPU threads, every thread accumulates into a private copy of dense outputs,
+///   and the copies are reduced in parallel after the loop)
 /// OutputRaceStrategy::ParallelReduction uses reduction operations across a warp/vector
+///   (on CPU threads, as for OutputRaceStrategy::Temporary)
 /// OutputRaceStrategy::IgnoreRaces allows the user to specify that races can be safely ignored
 enum class OutputRaceStrategy {
   IgnoreRaces, NoRaces, Atomics, Temporary, ParallelReduction
@@ -35,11 +39,35 @@ extern const char *AssembleStrategy_NAMES[];
 
 /// MergeStrategy::TwoFinger merges iterators by incrementing one at a time
 /// MergeStrategy::Galloping merges iterators by exponential search (galloping)
+/// MergeStrategy::MergePath merges iterators with two fingers, but loops
+/// parallelized by CPU threads first partition the merged coordinates into
+/// equally sized ranges by binary searches (merge path partitioning)
 enum class MergeStrategy {
-  TwoFinger, Gallop
+  TwoFinger, Gallop, MergePath
 };
 extern const char *MergeStrategy_NAMES[];
 
+/// WorkspaceStrategy::Dense accumulates into an array sized to the dimension
+/// WorkspaceStrategy::Hash accumulates into a hash table sized to the number
+/// of coordinates that are accumulated into
+/// WorkspaceStrategy::Heap appends every contribution to a heap ordered by
+/// coordinate and combines the contributions to a coordinate as it pops them
+enum class WorkspaceStrategy {
+  Dense, Hash, Heap
+};
+extern const char *WorkspaceStrategy_NAMES[];
+
+/// TailStrategy::GuardWithIf guards every iteration of the inner loop of a
+/// split or divide whose index may fall outside of the range of the original
+/// index variable
+/// TailStrategy::Peel checks once per outer iteration whether the inner loop
+/// stays within the range, and runs a guarded copy of the inner loop only if
+/// it does not, so the main body of the inner loop is branch-free
+enum class TailStrategy {
+  GuardWithIf, Peel
+};
+extern const char *TailStrategy_NAMES[];
+
 }
 
 #endif //TACO_IR_TAGS_H
@@ -72,10 +72,13 @@ public:
   bool isBranchless() const;
   bool isCompact() const;
   bool isZeroless() const;
+  bool isPadded() const;
 
   /// Capabilities supported by levels being iterated.
   bool hasCoordIter() const;
   bool hasPosIter() const;
+  bool hasWordIter() const;
+  bool hasRunIter() const;
   bool hasLocate() const;
   bool hasInsert() const;
   bool hasAppend() const;
@@ -140,10 +143,27 @@ public:
   ModeFunction posBounds(const ir::Expr& parentPos) const;
   ModeFunction posAccess(const ir::Expr& pos, 
                          const std::vector<ir::Expr>& coords) const;
+
+  /// Return code for level functions that implement word iteration.
+  ModeFunction wordBounds(const ir::Expr& parentPos) const;
+  ModeFunction wordAccess(const ir::Expr& wordPos) const;
+  ModeFunction wordLocate(const ir::Expr& parentPos, const ir::Expr& wordPos,
+                          const ir::Expr& bit) const;
+  
+  /// Return code for level functions that implement run iteration.
+  ModeFunction runBounds(const ir::Expr& parentPos) const;
+  ModeFunction runAccess(const ir::Expr& runPos) const;
+  ModeFunction runLocate(const ir::Expr& pos) const;
   
   /// Returns code for level function that implements locate capability.
   ModeFunction locate(const std::vector<ir::Expr>& coords) const;
 
+  /// Returns code for level function that implements locate capability,
+  /// relative to the given parent position instead of the parent iterator's
+  /// position variable.
+  ModeFunction locate(const ir::Expr& parentPos,
+                      const std::vector<ir::Expr>& coords) const;
+
   /// Return code for level functions that implement insert capabilitiy.
   ir::Stmt getInsertCoord(const ir::Expr& p,
                           const std::vector<ir::Expr>& i) const;
@@ -173,6 +193,11 @@ public:
   ir::Stmt getSeqInsertEdge(const ir::Expr& parentPos, 
       const std::vector<ir::Expr>& coords, 
       const std::vector<AttrQueryResult>& queries) const;
+  ir::Stmt getParInsertEdge(const ir::Expr& parentPos, 
+      const std::vector<ir::Expr>& coords, 
+      const std::vector<AttrQueryResult>& queries) const;
+  ir::Stmt getParFinalizeEdges(const ir::Expr& prevSize, 
+      const std::vector<AttrQueryResult>& queries) const;
   ir::Stmt getInitCoords(const ir::Expr& prevSize, 
       const std::vector<AttrQueryResult>& queries) const;
   ir::Stmt getInitYieldPos(const ir::Expr& prevSize) const;
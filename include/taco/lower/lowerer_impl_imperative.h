@@ -63,6 +63,14 @@ protected:
   /// Lower an assignment statement.
   virtual ir::Stmt lowerAssignment(Assignment assignment);
 
+  /// Lower the update of the result component that mirrors the component
+  /// updated by an assignment that reads a tensor storing one triangle of a
+  /// symmetric tensor, where `rhs` is the lowered right-hand side of the
+  /// assignment. The update is guarded to skip the diagonal.
+  virtual ir::Stmt lowerMirroredAssignment(Assignment assignment,
+                                           Access symmetricAccess,
+                                           ir::Expr rhs);
+
   /// Lower a yield statement.
   virtual ir::Stmt lowerYield(Yield yield);
 
@@ -116,6 +124,26 @@ protected:
                                        std::set<Access> reducedAccesses,
                                        ir::Stmt recoveryStmt);
 
+  /// Returns true if the padding of a padded level that is iterated over by a
+  /// position loop cannot change the result of the loop, so that the loop 
+  /// need not check for padding.
+  bool isPaddingInert(Forall forall, Iterator iterator, 
+                      MergeLattice caseLattice, 
+                      std::vector<Iterator> inserters,
+                      std::vector<Iterator> appenders);
+
+  /// Lower a position loop over a level that supports word iteration into a
+  /// loop over words that scans the set bits of each word.
+  ir::Stmt lowerWordIteration(Forall forall, Iterator iterator,
+                              std::vector<Iterator> locators,
+                              MergeLattice caseLattice, ir::Expr wordPos,
+                              ir::Expr bit, ir::Stmt body);
+
+  /// Lower a position loop over a level that supports run iteration into a
+  /// loop over runs that iterates over the positions of each run.
+  ir::Stmt lowerRunIteration(Forall forall, Iterator iterator, ir::Expr runPos,
+                             ir::Expr crdOffset, ir::Stmt body);
+
   virtual ir::Stmt lowerForallFusedPosition(Forall forall, Iterator iterator,
                                        std::vector<Iterator> locaters,
                                        std::vector<Iterator> inserters,
@@ -128,6 +156,13 @@ protected:
   /// search for the start of the iteration of the loop (a separate kernel on GPUs)
   virtual ir::Stmt searchForFusedPositionStart(Forall forall, Iterator posIterator);
 
+  /// Returns the location in the values array of a dense result that a 
+  /// segmented reduction in a fused position loop adds into, or an undefined 
+  /// expression if the result is not dense or if it is indexed by the 
+  /// innermost fused ancestor, whose coordinate changes at every position.
+  ir::Expr getSegmentedReductionLoc(Access result, 
+                                    std::vector<IndexVar> underivedAncestors);
+
     /**
      * Lower the merge lattice to code that iterates over the sparse iteration
      * space of coordinates and computes the concrete index notation statement.
@@ -147,7 +182,8 @@ protected:
      *      A concrete index notation statement to compute at the points in the
      *      sparse iteration space described by the merge lattice.
      * \param mergeStrategy
-     *      A strategy for merging iterators. One of TwoFinger or Gallop.
+     *      A strategy for merging iterators. One of TwoFinger, Gallop, or
+     *      MergePath.
      *
      * \return
      *       IR code to compute the forall loop.
@@ -157,6 +193,27 @@ protected:
                                      const std::set<Access>& reducedAccesses, 
                                      MergeStrategy mergeStrategy);
 
+  /// Lower the while loops of every point of a merge lattice, which merge
+  /// iterators whose position variables have been initialized.
+  virtual ir::Stmt lowerMergeLoops(MergeLattice lattice, ir::Expr coordinate,
+                                   IndexVar coordinateVar, IndexStmt statement,
+                                   const std::set<Access>& reducedAccesses,
+                                   MergeStrategy mergeStrategy);
+
+  /**
+   * Lower a merge lattice of a forall loop that is merged by merge path and 
+   * parallelized over CPU threads.  The merged coordinates are partitioned 
+   * into one range per thread, such that every range holds about the same 
+   * number of coordinates of the merged iterators, by binary searching the 
+   * coordinate space for the splitters of the ranges.  Every thread then 
+   * narrows the position ranges of the iterators to its range of coordinates 
+   * and merges them as in lowerMergeLattice.
+   */
+  virtual ir::Stmt lowerMergeLatticePartitioned(Forall forall,
+                                                MergeLattice lattice,
+                                                IndexVar coordinateVar,
+                                                const std::set<Access>& reducedAccesses);
+
   virtual ir::Stmt resolveCoordinate(std::vector<Iterator> mergers, ir::Expr coordinate, bool emitVarDecl, bool mergeWithMax);
 
     /**
@@ -270,6 +327,10 @@ protected:
   /// Retrieve the values array of the tensor var.
   ir::Expr getValuesArray(TensorVar) const;
 
+  /// Load the value at location `loc` of an operand tensor var, decoding
+  /// the value through the dictionary of dictionary-encoded operands.
+  ir::Expr loadValue(TensorVar, ir::Expr loc) const;
+
   /// Retrieve the dimension of an index variable (the values it iterates over),
   /// which is encoded as the interval [0, result).
   ir::Expr getDimension(IndexVar indexVar) const;
@@ -373,12 +434,39 @@ protected:
   std::vector<ir::Stmt> codeToInitializeTemporary(Where where);
   std::vector<ir::Stmt> codeToInitializeTemporaryParallel(Where where, ParallelUnit parallelUnit);
   std::vector<ir::Stmt> codeToInitializeLocalTemporaryParallel(Where where, ParallelUnit parallelUnit);
+
+  /// Privatizes the dense results that the iterations of a loop parallelized
+  /// over CPU threads reduce into (see OutputRaceStrategy::Temporary).  Every
+  /// thread accumulates into a private copy of the results, which are then 
+  /// reduced into the results in parallel, one block of components per 
+  /// thread.  Returns the code that allocates the private copies, the code 
+  /// that declares the copy of the running thread in the loop body, and the
+  /// code that reduces and frees the copies.
+  std::vector<ir::Stmt> codeToPrivatizeResults(Forall forall);
   /// Gets the size of a temporary tensorVar in the where statement
   ir::Expr getTemporarySize(Where where);
 
   /// Initializes helper arrays to give dense workspaces sparse acceleration
   std::vector<ir::Stmt> codeToInitializeDenseAcceleratorArrays(Where where, bool parallel = false);
 
+  /// Initializes the arrays of an accelerated workspace that accumulates into
+  /// a hash table or a heap instead of a dense array
+  std::vector<ir::Stmt> codeToInitializeSparseAccumulator(Where where);
+
+  /// Lower an update of a hash or heap workspace at the workspace coordinate
+  /// `coordinate`. `firstUpdate` initializes the value of a coordinate that
+  /// is accumulated into for the first time, and `update` accumulates into
+  /// the value of a coordinate that has been accumulated into before.
+  ir::Stmt lowerSparseAccumulatorUpdate(TensorVar temporary,
+                                        ir::Expr coordinate,
+                                        ir::Stmt firstUpdate,
+                                        ir::Stmt update);
+
+  /// Lower a consumer loop that iterates over the coordinates of a heap
+  /// workspace, combining the values of every coordinate as it pops them.
+  ir::Stmt lowerForallHeapAccumulator(Forall forall, TensorVar temporary,
+                                      ir::Stmt body);
+
   /// Recovers a derived indexvar from an underived variable.
   ir::Stmt codeToRecoverDerivedIndexVar(IndexVar underived, IndexVar indexVar, bool emitVarDecl);
 
@@ -391,6 +479,10 @@ protected:
   /// Create statements to append coordinate to result modes.
   ir::Stmt appendCoordinate(std::vector<Iterator> appenders, ir::Expr coord);
 
+  /// Create statements to insert coordinates into result modes that record
+  /// the coordinates stored at inserted positions (e.g., bitmap modes).
+  ir::Stmt insertCoordinates(std::vector<Iterator> inserters);
+
   /// Create statements to append positions to result modes.
   ir::Stmt generateAppendPositions(std::vector<Iterator> appenders);
 
@@ -508,6 +600,13 @@ private:
   int markAssignsAtomicDepth = 0;
   ParallelUnit atomicParallelUnit;
 
+  /// Type that tensor values are converted to when they are loaded by the 
+  /// assignment being lowered, or undefined if they are not converted.
+  Datatype accumulatorType;
+
+  /// Map from scalar results to the types they are reduced in.
+  std::map<TensorVar, Datatype> scalarAccumulatorTypes;
+
   std::set<TensorVar> assembledByUngroupedInsert;
 
   std::set<ir::Expr> nonFullyInitializedResults;
@@ -538,6 +637,30 @@ private:
   /// Map form temporary to bitGuard var if accelerating dense workspace
   std::map<TensorVar, ir::Expr> tempToBitGuard;
 
+  /// The arrays of an accelerated workspace that accumulates into a hash
+  /// table or a heap (see WorkspaceStrategy). The values of the workspace are
+  /// stored in the order their coordinates are first accumulated into, at the
+  /// location `loc`, and the index list (of hash workspaces) and the values
+  /// grow to `capacity`. Hash tables map the coordinates in `hashKeys` to the
+  /// locations in `hashLocs`, and `hashSlots` records the slot of every
+  /// location so that the table can be cleared. Heaps store pairs of
+  /// coordinates and locations.
+  struct SparseAccumulatorArrays {
+    ir::Expr loc;
+    ir::Expr capacity;
+    ir::Expr hashKeys;
+    ir::Expr hashLocs;
+    ir::Expr hashSlots;
+    ir::Expr hashSize;
+    ir::Expr heap;
+    bool sorted = false;
+  };
+  std::map<TensorVar, SparseAccumulatorArrays> tempToSparseAccumulator;
+
+  /// Map from results that are privatized by the threads of a parallel loop
+  /// to the values array of the private copy of the running thread.
+  std::map<TensorVar, ir::Expr> privatizedResultValues;
+
   std::set<TensorVar> guardedTemps;
 
   /// Map from result tensors to variables tracking values array capacity.
@@ -546,6 +669,10 @@ private:
   /// Map from index variables to their dimensions, currently [0, expr).
   std::map<IndexVar, ir::Expr> dimensions;
 
+  /// Map from index variables that iterate over the dense levels of blocks of
+  /// a small constant size to that size (see getFixedBlockSize).
+  std::map<IndexVar, int> fixedBlockSizes;
+
   /// Map from index variables to their bounds, currently also [0, expr) but allows adding minimum in future too
   std::map<IndexVar, std::vector<ir::Expr>> underivedBounds;
 
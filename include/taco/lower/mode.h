@@ -2,6 +2,7 @@
 #define TACO_MODE_H
 
 #include <string>
+#include <vector>
 
 #include "taco/format.h"
 
@@ -76,6 +77,12 @@ public:
   ModePack(size_t numModes, ModeFormat modeType, ir::Expr tensor, int mode, 
            int level);
 
+  /// Construct a mode pack whose index arrays store elements of the given 
+  /// types.  The type of the ith array is given by `arrayTypes[i]`; arrays 
+  /// without a corresponding type store 32-bit integers.
+  ModePack(size_t numModes, ModeFormat modeType, ir::Expr tensor, int mode, 
+           int level, const std::vector<Datatype>& arrayTypes);
+
   /// Returns number of tensor modes belonging to mode pack.
   size_t getNumModes() const;
 
@@ -0,0 +1,62 @@
+#ifndef TACO_MODE_FORMAT_BITMAP_H
+#define TACO_MODE_FORMAT_BITMAP_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// A bitmap level stores, for every parent position, one bit per coordinate in
+/// an array of 64-bit words that marks which coordinates are nonzero. Values 
+/// are stored densely, so positions that are not marked store the fill value.
+/// Bitmap levels support word iteration, which scans the set bits of each word
+/// and lets co-iteration with other bitmaps intersect 64 coordinates at once.
+class BitmapModeFormat : public ModeFormatImpl {
+public:
+  using ModeFormatImpl::getInsertCoord;
+
+  BitmapModeFormat();
+  BitmapModeFormat(bool isZeroless);
+
+  ~BitmapModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  ModeFunction posIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction posIterAccess(ir::Expr pos, std::vector<ir::Expr> coords,
+                             Mode mode) const override;
+
+  bool hasWordIter() const override;
+  ModeFunction wordIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction wordIterAccess(ir::Expr wordPos, Mode mode) const override;
+  ModeFunction wordIterLocate(ir::Expr parentPos, ir::Expr wordPos,
+                              ir::Expr bit, Mode mode) const override;
+
+  ModeFunction locate(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                      Mode mode) const override;
+
+  ir::Stmt getInsertCoord(ir::Expr p, const std::vector<ir::Expr>& i,
+                          Mode mode) const override;
+  ir::Expr getWidth(Mode mode) const override;
+  ir::Stmt getInsertInitCoords(ir::Expr pBegin, ir::Expr pEnd,
+                               Mode mode) const override;
+  ir::Stmt getInsertInitLevel(ir::Expr szPrev, ir::Expr sz,
+                              Mode mode) const override;
+  ir::Stmt getInsertFinalizeLevel(ir::Expr szPrev, ir::Expr sz,
+                                  Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+protected:
+  ir::Expr getSizeArray(ModePack pack) const;
+  ir::Expr getBitsArray(ModePack pack) const;
+
+  ir::Expr getBitsCapacity(Mode mode) const;
+
+  /// Returns the number of words that store the bits of one parent position.
+  ir::Expr getNumWords(Mode mode) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef TACO_MODE_FORMAT_DIA_H
+#define TACO_MODE_FORMAT_DIA_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// A DIA level stores, for every parent position, one slot per diagonal in a
+/// fixed set of diagonals followed by one overflow slot. The coordinate of a
+/// slot is not stored but computed as the parent coordinate plus the offset of
+/// the slot's diagonal, so values of banded operators are stored contiguously
+/// without a coordinate array. Slots whose coordinates fall outside the mode
+/// store the fill value. Coordinates that do not lie on any of the diagonals
+/// are inserted into the overflow slot, which is never iterated over, so
+/// packing nonzeros off the diagonals is an error and kernels that compute
+/// them into a DIA result drop them.
+///
+/// The offsets are part of the format and are also stored in the offset array
+/// of every tensor, which holds the number of diagonals followed by the
+/// offsets in ascending order.
+class DiaModeFormat : public ModeFormatImpl {
+public:
+  DiaModeFormat();
+  DiaModeFormat(bool isZeroless, std::vector<int> offsets);
+
+  ~DiaModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  ModeFunction posIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction posIterAccess(ir::Expr pos, std::vector<ir::Expr> coords,
+                             Mode mode) const override;
+
+  ModeFunction locate(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                      Mode mode) const override;
+
+  ir::Expr getWidth(Mode mode) const override;
+  ir::Stmt getInsertInitLevel(ir::Expr szPrev, ir::Expr sz,
+                              Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+  const std::vector<int>& getOffsets() const;
+
+protected:
+  ir::Expr getOffsetArray(ModePack pack) const;
+  ir::Expr getDimension(ModePack pack) const;
+
+  /// Returns the number of diagonals, excluding the overflow slot.
+  ir::Expr getNumDiagonals() const;
+
+  /// Returns the parent coordinate of the coordinates `coords` of a level,
+  /// which is zero for the first level.
+  ir::Expr getParentCoord(const std::vector<ir::Expr>& coords) const;
+
+  bool equals(const ModeFormatImpl& other) const override;
+
+  const std::vector<int> offsets;
+};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef TACO_MODE_FORMAT_ELL_H
+#define TACO_MODE_FORMAT_ELL_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// An ELL level stores the same number of coordinates (the width) for every
+/// parent position, so that the coordinates of a parent position lie at fixed
+/// offsets in the coordinate array. Parent positions with fewer coordinates
+/// are padded with the sentinel coordinate -1 and the fill value, which lets
+/// loops that iterate over the level run for a fixed trip count without
+/// branching on the number of stored coordinates.
+///
+/// A sliced ELL level groups `sliceHeight` consecutive parent positions into a
+/// slice and picks the width of each slice separately, which limits the
+/// padding of levels whose parent positions store very different numbers of
+/// coordinates. A slice height of zero yields a plain ELL level with a single
+/// width.
+///
+/// ELL levels are assembled with ungrouped insertion, which computes the
+/// widths from the number of coordinates of each parent position.
+class EllModeFormat : public ModeFormatImpl {
+public:
+  using ModeFormatImpl::getInsertCoord;
+
+  EllModeFormat();
+  EllModeFormat(bool isZeroless, long long sliceHeight = 0);
+
+  ~EllModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  std::vector<AttrQuery>
+  attrQueries(std::vector<IndexVar> parentCoords,
+              std::vector<IndexVar> childCoords) const override;
+
+  ModeFunction posIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction posIterAccess(ir::Expr pos, std::vector<ir::Expr> coords,
+                             Mode mode) const override;
+
+  ir::Expr getAssembledSize(ir::Expr prevSize, Mode mode) const override;
+  ir::Stmt getSeqInitEdges(ir::Expr prevSize,
+                           std::vector<AttrQueryResult> queries,
+                           Mode mode) const override;
+  ir::Stmt getSeqInsertEdge(ir::Expr parentPos,
+                            std::vector<ir::Expr> coords,
+                            std::vector<AttrQueryResult> queries,
+                            Mode mode) const override;
+  ir::Stmt getInitCoords(ir::Expr prevSize,
+                         std::vector<AttrQueryResult> queries,
+                         Mode mode) const override;
+  ir::Stmt getInitYieldPos(ir::Expr prevSize, Mode mode) const override;
+  ModeFunction getYieldPos(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                           Mode mode) const override;
+  ir::Stmt getInsertCoord(ir::Expr parentPos, ir::Expr pos,
+                          std::vector<ir::Expr> coords,
+                          Mode mode) const override;
+  ir::Stmt getFinalizeYieldPos(ir::Expr prevSize, Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+protected:
+  /// Returns the slice array, which stores the slice height followed by the
+  /// offset of every slice in the coordinate array. Plain ELL levels store a
+  /// slice height of zero followed by the width.
+  ir::Expr getSliceArray(ModePack pack) const;
+  ir::Expr getCoordArray(ModePack pack) const;
+
+  /// Returns the array that counts the coordinates that have been inserted
+  /// for every parent position during assembly.
+  ir::Expr getCountArray(Mode mode) const;
+
+  ir::Expr getNumSlices(ir::Expr prevSize) const;
+
+  /// Returns the offset of the slice of a parent position and the width of
+  /// that slice.
+  ir::Expr getSliceBegin(ir::Expr parentPos, Mode mode) const;
+  ir::Expr getSliceWidth(ir::Expr parentPos, Mode mode) const;
+
+  /// Returns the first position of a parent position.
+  ir::Expr getBegin(ir::Expr parentPos, Mode mode) const;
+
+  bool equals(const ModeFormatImpl& other) const override;
+
+  const long long sliceHeight;
+};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef TACO_MODE_FORMAT_HASHED_H
+#define TACO_MODE_FORMAT_HASHED_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// A hashed level stores, for every parent position, an open-addressing hash
+/// table whose slots lie between two consecutive entries of a pos array, like
+/// the coordinates of a compressed level. Empty slots store the coordinate -1
+/// and the fill value, so locating a coordinate that is not stored yields a
+/// position holding the fill value.
+///
+/// Hashed levels are assembled with ungrouped insertion, which sizes the table
+/// of every parent position by the number of coordinates that are inserted
+/// into it: tables have twice as many slots as coordinates, but no more slots
+/// than the dimension and no fewer than `width` slots (or one slot if `width`
+/// is zero). Since ungrouped insertion supports one such level per tensor, a
+/// tensor can have at most one hashed level.
+class HashedModeFormat : public ModeFormatImpl {
+public:
+  using ModeFormatImpl::getInsertCoord;
+
+  HashedModeFormat();
+  HashedModeFormat(bool isZeroless, long long width = 0);
+
+  ~HashedModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  std::vector<AttrQuery>
+  attrQueries(std::vector<IndexVar> parentCoords,
+              std::vector<IndexVar> childCoords) const override;
+
+  ModeFunction posIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction posIterAccess(ir::Expr pos, std::vector<ir::Expr> coords,
+                             Mode mode) const override;
+
+  ModeFunction locate(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                      Mode mode) const override;
+
+  ir::Expr getAssembledSize(ir::Expr prevSize, Mode mode) const override;
+  ir::Stmt getSeqInitEdges(ir::Expr prevSize,
+                           std::vector<AttrQueryResult> queries,
+                           Mode mode) const override;
+  ir::Stmt getSeqInsertEdge(ir::Expr parentPos,
+                            std::vector<ir::Expr> coords,
+                            std::vector<AttrQueryResult> queries,
+                            Mode mode) const override;
+  ir::Stmt getParInsertEdge(ir::Expr parentPos,
+                            std::vector<ir::Expr> coords,
+                            std::vector<AttrQueryResult> queries,
+                            Mode mode) const override;
+  ir::Stmt getParFinalizeEdges(ir::Expr prevSize,
+                               std::vector<AttrQueryResult> queries,
+                               Mode mode) const override;
+  ir::Stmt getInitCoords(ir::Expr prevSize,
+                         std::vector<AttrQueryResult> queries,
+                         Mode mode) const override;
+  ModeFunction getYieldPos(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                           Mode mode) const override;
+  ir::Stmt getInsertCoord(ir::Expr parentPos, ir::Expr pos,
+                          std::vector<ir::Expr> coords,
+                          Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+protected:
+  ir::Expr getPosArray(ModePack pack) const;
+  ir::Expr getCoordArray(ModePack pack) const;
+  ir::Expr getDimension(ModePack pack) const;
+
+  /// Returns the number of slots of the table of a parent position into which
+  /// the coordinates counted by the attribute queries are inserted.
+  ir::Expr getTableWidth(std::vector<ir::Expr> coords,
+                         std::vector<AttrQueryResult> queries,
+                         Mode mode) const;
+
+  /// Returns the position of `coords.back()` in the table of a parent
+  /// position or, if it is not stored, of the empty slot it is inserted into.
+  ir::Expr getSlot(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                   Mode mode) const;
+
+  bool equals(const ModeFormatImpl& other) const override;
+
+  const long long width;
+};
+
+}
+
+#endif
@@ -49,7 +49,8 @@ std::ostream& operator<<(std::ostream&, const AttrQuery&);
 class AttrQueryResult {
 public:
   AttrQueryResult() = default;
-  AttrQueryResult(ir::Expr resultVar, ir::Expr resultValues);
+  AttrQueryResult(ir::Expr resultVar, ir::Expr resultValues,
+                  std::vector<ir::Expr> resultDims = {});
 
   ir::Expr getResult(const std::vector<ir::Expr>& indices, 
                      const std::string& attr) const;
@@ -59,6 +60,7 @@ public:
 private:
   ir::Expr resultVar;
   ir::Expr resultValues;
+  std::vector<ir::Expr> resultDims;
 };
 
 std::ostream& operator<<(std::ostream&, const AttrQueryResult&);
@@ -147,13 +149,59 @@ public:
 
   /// The position iteration capability's access function maps a position
   /// iterator variable to a coordinate (result[0]) and reports if a coordinate
-  /// could not be found (result[1]).
+  /// could not be found (result[1]). Padded levels may also return a
+  /// coordinate that is safe to use at padding positions (result[2]), which
+  /// lets the lowerer skip the check when padding cannot affect the result.
   /// `pos_iter_access(p_{k}, i_{1}, ..., i_{k−1}) -> i_{k}, found`
   virtual ModeFunction posIterAccess(ir::Expr pos, 
                                      std::vector<ir::Expr> coords,
                                      Mode mode) const;
 
 
+  /// Returns true if the level supports the word iteration capability.
+  virtual bool hasWordIter() const;
+
+  /// The word iteration capability iterates over a level whose positions are
+  /// marked by the set bits of an array of 64-bit words (e.g., a bitmap). The
+  /// iterator function computes a range [result[0], result[1]) of word 
+  /// positions to iterate over.
+  /// `word_iter_bounds(p_{k−1}) -> begin_{k}, end_{k}`
+  virtual ModeFunction wordIterBounds(ir::Expr parentPos, Mode mode) const;
+
+  /// The word iteration capability's access function loads the word at a word
+  /// position (result[0]).
+  /// `word_iter_access(w_{k}) -> word_{k}`
+  virtual ModeFunction wordIterAccess(ir::Expr wordPos, Mode mode) const;
+
+  /// The word iteration capability's locate function maps bit `bit` of the 
+  /// word at a word position to a position (result[0]) and a coordinate 
+  /// (result[1]).
+  /// `word_iter_locate(p_{k−1}, w_{k}, bit) -> p_{k}, i_{k}`
+  virtual ModeFunction wordIterLocate(ir::Expr parentPos, ir::Expr wordPos,
+                                      ir::Expr bit, Mode mode) const;
+
+
+  /// Returns true if the level supports the run iteration capability.
+  virtual bool hasRunIter() const;
+
+  /// The run iteration capability iterates over a level whose coordinates are
+  /// stored as runs of consecutive coordinates. The iterator function computes
+  /// a range [result[0], result[1]) of runs to iterate over.
+  /// `run_iter_bounds(p_{k−1}) -> begin_{k}, end_{k}`
+  virtual ModeFunction runIterBounds(ir::Expr parentPos, Mode mode) const;
+
+  /// The run iteration capability's access function maps a run to the range
+  /// [result[0], result[1]) of positions it stores and to the coordinate of
+  /// its first position (result[2]).
+  /// `run_iter_access(r_{k}) -> begin_{k}, end_{k}, i_{k}`
+  virtual ModeFunction runIterAccess(ir::Expr runPos, Mode mode) const;
+
+  /// The run iteration capability's locate function maps a position to the run
+  /// that stores it (result[0]).
+  /// `run_iter_locate(p_{k}) -> r_{k}`
+  virtual ModeFunction runIterLocate(ir::Expr pos, Mode mode) const;
+
+
   /// The locate capability locates the position of a coordinate (result[0])
   /// and reports if the coordinate could not be found (result[1]).
   /// `locate(p_{k−1}, i_{1}, ..., i_{k}) -> p_{k}, found`
@@ -213,6 +261,18 @@ public:
   getSeqInsertEdge(ir::Expr parentPos, std::vector<ir::Expr> coords,
                    std::vector<AttrQueryResult> queries, Mode mode) const;
 
+  /// Levels may also insert edges in parallel, by storing the edge of every 
+  /// parent position independently (getParInsertEdge) and then combining the
+  /// edges of all parent positions (getParFinalizeEdges).  Levels that return
+  /// undefined statements insert edges sequentially.
+  virtual ir::Stmt
+  getParInsertEdge(ir::Expr parentPos, std::vector<ir::Expr> coords,
+                   std::vector<AttrQueryResult> queries, Mode mode) const;
+
+  virtual ir::Stmt
+  getParFinalizeEdges(ir::Expr prevSize, std::vector<AttrQueryResult> queries,
+                      Mode mode) const;
+
   virtual ir::Stmt
   getInitCoords(ir::Expr prevSize, std::vector<AttrQueryResult> queries, 
                 Mode mode) const;
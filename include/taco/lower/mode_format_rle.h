@@ -0,0 +1,81 @@
+#ifndef TACO_MODE_FORMAT_RLE_H
+#define TACO_MODE_FORMAT_RLE_H
+
+#include "taco/lower/mode_format_impl.h"
+
+namespace taco {
+
+/// A run-length level is a compressed level whose coordinates are stored as
+/// runs of consecutive coordinates instead of one coordinate per position.
+/// The run array stores the number of runs, followed by the first coordinate
+/// and first position of every run, followed by the number of positions in the
+/// level. The pos array stores, for every parent position, the range of runs
+/// of its segment. A run of any length thus takes two integers, which makes
+/// the level smaller than a compressed level whenever runs are longer than two
+/// coordinates on average (e.g., banded rows and dense time windows).
+///
+/// Run-length levels support run iteration, which decodes the coordinates of
+/// a run by incrementing the first coordinate of the run, as well as position
+/// iteration, which locates the run of a position with a binary search and
+/// thus lets position loops be split and parallelized as for compressed levels.
+class RleModeFormat : public ModeFormatImpl {
+public:
+  RleModeFormat();
+  RleModeFormat(bool isZeroless, long long allocSize = DEFAULT_ALLOC_SIZE);
+
+  ~RleModeFormat() override {}
+
+  ModeFormat copy(std::vector<ModeFormat::Property> properties) const override;
+
+  ModeFunction posIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction posIterAccess(ir::Expr pos, std::vector<ir::Expr> coords,
+                             Mode mode) const override;
+
+  bool hasRunIter() const override;
+  ModeFunction runIterBounds(ir::Expr parentPos, Mode mode) const override;
+  ModeFunction runIterAccess(ir::Expr runPos, Mode mode) const override;
+  ModeFunction runIterLocate(ir::Expr pos, Mode mode) const override;
+
+  ir::Stmt getAppendCoord(ir::Expr pos, ir::Expr coord,
+                          Mode mode) const override;
+  ir::Stmt getAppendEdges(ir::Expr parentPos, ir::Expr posBegin,
+                          ir::Expr posEnd, Mode mode) const override;
+  ir::Expr getSize(ir::Expr parentSize, Mode mode) const override;
+  ir::Stmt getAppendInitEdges(ir::Expr parentPosBegin,
+                              ir::Expr parentPosEnd, Mode mode) const override;
+  ir::Stmt getAppendInitLevel(ir::Expr parentSize, ir::Expr size,
+                              Mode mode) const override;
+  ir::Stmt getAppendFinalizeLevel(ir::Expr parentSize, ir::Expr size,
+                                  Mode mode) const override;
+
+  std::vector<ir::Expr> getArrays(ir::Expr tensor, int mode,
+                                  int level) const override;
+
+protected:
+  ir::Expr getPosArray(ModePack pack) const;
+  ir::Expr getRunArray(ModePack pack) const;
+
+  /// Returns the location in the run array of the first coordinate of a run.
+  /// The first position of the run is stored at the following location.
+  ir::Expr getRunLoc(ir::Expr runPos) const;
+
+  ir::Expr getPosCapacity(Mode mode) const;
+  ir::Expr getRunCapacity(Mode mode) const;
+
+  /// Returns the variable that counts the runs appended to the level.
+  ir::Expr getNumRunsVar(Mode mode) const;
+
+  /// Returns the variable that holds the coordinate that extends the last
+  /// appended run, or -1 if the next appended coordinate starts a new run.
+  ir::Expr getNextCoordVar(Mode mode) const;
+
+  ir::Expr getModeVar(Mode mode, const std::string& suffix) const;
+
+  bool equals(const ModeFormatImpl& other) const override;
+
+  const long long allocSize;
+};
+
+}
+
+#endif
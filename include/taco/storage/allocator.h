@@ -0,0 +1,141 @@
+#ifndef TACO_STORAGE_ALLOCATOR_H
+#define TACO_STORAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "taco/taco_tensor_t.h"
+
+namespace taco {
+
+/// An allocator allocates the arrays of tensors, both the arrays that are
+/// allocated on the host (Arrays with the Deallocate policy) and the arrays
+/// that generated kernels allocate. Allocators must be thread safe, since
+/// parallel kernels may allocate from several threads.
+class Allocator {
+public:
+  virtual ~Allocator() {}
+
+  /// Allocates `size` bytes.
+  virtual void* allocate(size_t size) = 0;
+
+  /// Resizes the allocation `ptr` to `size` bytes, preserving its contents,
+  /// and returns the resized allocation.  A null `ptr` allocates `size` bytes.
+  virtual void* reallocate(void* ptr, size_t size) = 0;
+
+  /// Deallocates the allocation `ptr`, which may be null.
+  virtual void deallocate(void* ptr) = 0;
+
+  /// Returns the alignment in bytes that every allocation is guaranteed to
+  /// have, or zero if allocations are only aligned as by malloc.  Kernels
+  /// generated while an aligned allocator is installed assume that the values
+  /// arrays of their tensors have this alignment.
+  virtual size_t getAlignment() const;
+};
+
+/// An allocator that allocates with the C malloc, realloc, and free functions.
+class MallocAllocator : public Allocator {
+public:
+  void* allocate(size_t size) override;
+  void* reallocate(void* ptr, size_t size) override;
+  void deallocate(void* ptr) override;
+};
+
+/// An allocator whose allocations are aligned to a power-of-two number of
+/// bytes (by default a cache line, which is also the width of AVX-512
+/// vectors).  Every allocation is preceded by a header that records its size,
+/// so allocations can be resized without knowing their size.
+class AlignedAllocator : public Allocator {
+public:
+  AlignedAllocator(size_t alignment = 64);
+
+  void* allocate(size_t size) override;
+  void* reallocate(void* ptr, size_t size) override;
+  void deallocate(void* ptr) override;
+  size_t getAlignment() const override;
+
+protected:
+  /// Allocates a block of `size` bytes that is aligned to the alignment.
+  virtual void* allocateBlock(size_t size);
+
+  /// Deallocates a block returned by allocateBlock.
+  virtual void deallocateBlock(void* block);
+
+  const size_t alignment;
+};
+
+/// An aligned allocator that backs large allocations by transparent huge
+/// pages.  Allocations of at least a huge page are aligned to huge pages and
+/// advised (with madvise) to be backed by huge pages, which reduces the TLB
+/// misses of kernels that stream through large arrays.  On systems without
+/// transparent huge pages this allocator behaves as an AlignedAllocator.
+class HugePageAllocator : public AlignedAllocator {
+public:
+  HugePageAllocator(size_t alignment = 64, size_t hugePageSize = 2 << 20);
+
+protected:
+  void* allocateBlock(size_t size) override;
+
+  const size_t hugePageSize;
+};
+
+/// An aligned allocator that allocates from large chunks of memory by
+/// incrementing an offset.  Deallocating is free and does not reclaim memory;
+/// instead, all allocations are released at once when the arena is reset or
+/// destroyed.  Arenas suit sequences of kernels that allocate many temporary
+/// tensors that all die together.  Arrays allocated from an arena keep the
+/// arena alive.
+class ArenaAllocator : public AlignedAllocator {
+public:
+  ArenaAllocator(size_t alignment = 64, size_t chunkSize = 64 << 20);
+  ~ArenaAllocator() override;
+
+  /// Releases all allocations of the arena.  Allocations must not be used
+  /// after the arena has been reset.
+  void reset();
+
+  /// Returns the number of bytes of the chunks of the arena.
+  size_t getCapacity() const;
+
+protected:
+  void* allocateBlock(size_t size) override;
+  void deallocateBlock(void* block) override;
+
+private:
+  const size_t chunkSize;
+  std::vector<std::pair<char*,size_t>> chunks;
+  size_t chunkOffset = 0;
+  mutable std::mutex mutex;
+};
+
+/// Returns the allocator that tensors and kernels allocate with.
+std::shared_ptr<Allocator> getAllocator();
+
+/// Sets the allocator that tensors and kernels allocate with.  Arrays keep
+/// the allocator they were allocated with, and kernels keep the allocator that
+/// was installed when they were compiled, so memory is always reallocated and
+/// deallocated by the allocator that allocated it.
+void setAllocator(std::shared_ptr<Allocator> allocator);
+
+/// Returns the allocation functions that generated kernels call, which
+/// allocate with `allocator`.  The allocator must outlive the kernels.
+taco_allocator_t getKernelAllocator(Allocator* allocator);
+
+/// Check if kernels should keep the workspaces of their temporaries (e.g.,
+/// the dense workspaces introduced by precompute) in a pool that survives
+/// across kernel invocations, instead of allocating and freeing them in every
+/// invocation.  Pooled workspaces are disabled by default.
+bool should_use_workspace_pool();
+
+/// Enable/Disable pooled workspaces for kernels compiled after the call.
+/// Every kernel keeps one pool per thread, which holds on to the largest
+/// workspaces the kernel has used on that thread until the module of the
+/// kernel is destroyed.  Pooled workspaces are allocated and released with
+/// the allocator of the module, so they must not be allocated from an arena
+/// that is reset before the module is destroyed.
+void set_workspace_pool_enabled(bool enabled);
+
+}
+#endif
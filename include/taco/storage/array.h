@@ -8,6 +8,7 @@
 #include "taco/util/collections.h"
 
 namespace taco {
+class Allocator;
 
 /// An array is a smart pointer to raw memory together with an element type,
 /// a size (number of elements) and a reclamation policy.
@@ -15,8 +16,11 @@ class Array {
 public:
   /// The memory reclamation policy of Array objects. UserOwns means the Array
   /// object will not free its data, free means it will reclaim data  with the
-  /// C free function and delete means it will reclaim data with delete[].
-  enum Policy {UserOwns, Free, Delete};
+  /// C free function, delete means it will reclaim data with delete[] and
+  /// deallocate means it will reclaim data with the allocator that was
+  /// installed when the Array object was constructed, or with the allocator
+  /// it was constructed with (see allocator.h).
+  enum Policy {UserOwns, Free, Delete, Deallocate};
 
   /// Construct an empty array of undefined elements.
   Array();
@@ -24,6 +28,11 @@ public:
   /// Construct an array of elements of the given type.
   Array(Datatype type, void* data, size_t size, Policy policy=Free);
 
+  /// Construct an array of elements of the given type, whose data was
+  /// allocated with, and is reclaimed with, the given allocator.
+  Array(Datatype type, void* data, size_t size,
+        std::shared_ptr<Allocator> allocator);
+
   /// Returns the type of the array elements
   const Datatype& getType() const;
 
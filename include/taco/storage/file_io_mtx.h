@@ -25,13 +25,15 @@ TensorBase readMTX(std::istream& stream, const ModeFormat& modetype,
 /// Read an mtx matrix from a stream.
 TensorBase readMTX(std::istream& stream, const Format& format, bool pack=true);
 
+/// Read the entries of an mtx coordinate matrix from a stream. The entries of
+/// `pattern` matrices have no values and are read as ones.
 TensorBase readSparse(std::istream& stream, const ModeFormat& modetype, 
-                      bool symm = false);
+                      bool symm = false, bool pattern = false);
 TensorBase readDense(std::istream& stream, const ModeFormat& modetype, 
                      bool symm = false);
 
 TensorBase readSparse(std::istream& stream, const Format& format, 
-                      bool symm = false);
+                      bool symm = false, bool pattern = false);
 TensorBase readDense(std::istream& stream, const Format& format, 
                      bool symm = false);
 
@@ -55,6 +55,10 @@ public:
   /// Returns the tensor component value array.
   Array getValues();
 
+  /// Returns the dictionary of distinct values that the codes in the value
+  /// array index into, if the values are dictionary encoded.
+  const Array& getValuesDictionary() const;
+
   /// Returns the full value attached to the tensor storage
   Literal getFillValue();
 
@@ -70,6 +74,9 @@ public:
   /// Set the tensor component value array.
   void setValues(const Array& values);
 
+  /// Set the dictionary of distinct values of dictionary-encoded storage.
+  void setValuesDictionary(const Array& dictionary);
+
 
 private:
   struct Content;
@@ -84,5 +91,10 @@ bool equals(TensorStorage a, TensorStorage b);
 /// Print Storage objects to a stream.
 std::ostream& operator<<(std::ostream&, const TensorStorage&);
 
+/// Asserts that the values arrays of `tensors` (taco_tensor_t pointers that
+/// are passed to a kernel) have `alignment`, which kernels that are compiled
+/// with an aligned allocator assume.  An alignment of zero checks nothing.
+void checkValuesAlignment(const std::vector<void*>& tensors, size_t alignment);
+
 }
 #endif
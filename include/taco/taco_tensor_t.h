@@ -1,11 +1,12 @@
-/// This file defines the runtime struct used to pass raw tensors to generated
-/// code.  Note: this file must be valid C99, not C++.
+/// This file defines the runtime structs used to pass raw tensors and the
+/// allocator to generated code.  Note: this file must be valid C99, not C++.
 /// This *must* be kept in sync with the version used in codegen_c.cpp
 /// TODO: Remove `vals_size` after old lowering machinery has been replaced.
 
 #ifndef TACO_TENSOR_T_DEFINED
 #define TACO_TENSOR_T_DEFINED
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef enum { taco_mode_dense, taco_mode_sparse } taco_mode_t;
@@ -20,8 +21,16 @@ typedef struct taco_tensor_t {
   uint8_t*     vals;          // tensor values
   uint8_t*     fill_value;    // tensor fill value
   int32_t      vals_size;     // values array size
+  uint8_t*     vals_dict;     // dictionary of encoded values
 } taco_tensor_t;
 
+typedef struct taco_allocator_t {
+  void* context;                              // allocator of the kernels
+  void* (*allocate)(void*, size_t);           // allocates memory
+  void* (*reallocate)(void*, void*, size_t);  // resizes allocated memory
+  void  (*deallocate)(void*, void*);          // deallocates memory
+} taco_allocator_t;
+
 taco_tensor_t *init_taco_tensor_t(int32_t order, int32_t csize,
                                   int32_t* dimensions, int32_t* modeOrdering,
                                   taco_mode_t* mode_types, void* fill_ptr);
@@ -8,6 +8,7 @@
 #include <utility>
 #include <array>
 #include <mutex>
+#include <set>
 
 #include "taco/type.h"
 #include "taco/format.h"
@@ -127,6 +128,11 @@ public:
   /// Get the expression to be evaluated when calling compute or assemble.
   Assignment getAssignment() const;
 
+  /// Set the type in which the expression is computed and reduced before it
+  /// is converted to the component type of the tensor (e.g., to accumulate
+  /// float products in double).
+  void setAccumulatorType(Datatype accumulatorType);
+
   /// Reserve space for `numCoordinates` additional coordinates.
   void reserve(size_t numCoordinates);
 
@@ -540,6 +546,10 @@ private:
   struct Content;
   std::shared_ptr<Content> content;
 
+  // Kernels are only reused while the allocator that they were compiled
+  // with is installed (see ir::Module::getAllocator), since they allocate
+  // with it and assume its alignment. Compute kernels are also cached with
+  // whether they pool their workspaces.
   typedef std::vector<std::tuple<Format,
                                  Datatype,
                                  std::vector<int>,
@@ -547,8 +557,9 @@ private:
   static HelperFuncsCache helperFunctions;
   static std::mutex helperFunctionsMutex;
 
-  typedef std::vector<std::pair<IndexStmt, 
-                                std::shared_ptr<ir::Module>>> KernelsCache;
+  typedef std::vector<std::tuple<IndexStmt,
+                                 bool,
+                                 std::shared_ptr<ir::Module>>> KernelsCache;
   static KernelsCache computeKernels;
   static std::mutex computeKernelsMutex;
 };
@@ -867,7 +878,6 @@ void getCSCArrays(const TensorBase& tensor,
   *vals   = static_cast<T*>(storage.getValues().getData());
 }
 
-
 /// Pack the operands in the given expression.
 void packOperands(const TensorBase& tensor);
 
@@ -877,6 +887,61 @@ Tensor<CType> iterate(const TensorBase& tensor) {
   return Tensor<CType>(tensor);
 }
 
+/// Factory function to construct a blocked sparse tensor (e.g. in the BCSR or
+/// BCSF format) from `tensor` by splitting every mode into blocks of the
+/// given constant size. The result has twice the order of `tensor`: its
+/// first modes index blocks and its last modes index components within a
+/// block. Components of stored blocks that are not stored in `tensor` are
+/// filled in with explicit zeros, and the ratio of the number of components
+/// in stored blocks to the number of components stored in `tensor` is
+/// written to `fillRatio` if it is not null.
+template<typename CType>
+Tensor<CType> makeBlocked(const std::string& name, const TensorBase& tensor,
+                          const std::vector<int>& blockSizes, Format format,
+                          double* fillRatio = nullptr) {
+  const int order = tensor.getOrder();
+  taco_uassert(blockSizes.size() == (size_t)order) <<
+      "The number of block sizes (" << blockSizes.size() << ") must match " <<
+      "the order of " << tensor.getName() << " (" << order << ")";
+  taco_uassert(format.getOrder() == 2 * order) <<
+      "The format of a blocked tensor must have twice the order of " <<
+      tensor.getName();
+
+  std::vector<int> dimensions(2 * order);
+  for (int i = 0; i < order; ++i) {
+    taco_uassert(blockSizes[i] > 0) << "Block sizes must be positive";
+    dimensions[i] = (tensor.getDimension(i) + blockSizes[i] - 1) / 
+                    blockSizes[i];
+    dimensions[order + i] = blockSizes[i];
+  }
+  Tensor<CType> blocked(name, dimensions, format);
+
+  size_t numComponents = 0;
+  std::set<std::vector<int>> blocks;
+  std::vector<int> coordinate(2 * order);
+  for (auto& value : iterate<CType>(tensor)) {
+    for (int i = 0; i < order; ++i) {
+      coordinate[i] = value.first[i] / blockSizes[i];
+      coordinate[order + i] = value.first[i] % blockSizes[i];
+    }
+    blocks.insert(std::vector<int>(coordinate.begin(), 
+                                   coordinate.begin() + order));
+    blocked.insert(coordinate, value.second);
+    ++numComponents;
+  }
+  blocked.pack();
+
+  if (fillRatio != nullptr) {
+    size_t blockSize = 1;
+    for (int size : blockSizes) {
+      blockSize *= size;
+    }
+    *fillRatio = (numComponents == 0) ? 1.0 : 
+                 (double)(blocks.size() * blockSize) / numComponents;
+  }
+  return blocked;
+}
+
 // ------------------------------------------------------------
 // TensorBase::Content
 // ------------------------------------------------------------
@@ -1316,18 +1381,48 @@ TensorBase::const_iterator<T,CType> Tensor<CType>::endTyped() {
 template <typename CType>
 void Tensor<CType>::operator=(const IndexExpr& expr) {TensorBase::operator=(expr);}
 
+/// ParallelSchedule::Static and ParallelSchedule::Dynamic distribute the
+/// iterations of the parallel outer loop over threads with the OpenMP static
+/// and dynamic schedules.  ParallelSchedule::Balanced instead distributes the
+/// nonzeros of a sparse matrix operand equally over threads, splitting rows
+/// if necessary (see parallelizeOuterLoopsByNonzeros), and falls back to the
+/// static schedule for computations without such an operand.
 enum class ParallelSchedule {
-  Static, Dynamic
+  Static, Dynamic, Balanced
 };
 
 /// Set schedule to use for parallel execution of tensor computations.  This 
-/// will be replaced by a scheduling language in the future.
+/// will be replaced by a scheduling language in the future.  The chunk size
+/// of the balanced schedule is the number of nonzeros per chunk, which must
+/// be set when the computation is compiled.
 void taco_set_parallel_schedule(ParallelSchedule sched, int chunk_size = 0);
 
 /// Get schedule to use for parallel execution of tensor computations.  This 
 /// will be replaced by a scheduling language in the future.
 void taco_get_parallel_schedule(ParallelSchedule *sched, int *chunk_size);
 
+/// Set whether computations with sparse results are parallelized by 
+/// assembling their results in two phases, where the entries of every result
+/// segment are first counted and then inserted (see parallelizeAssembly).  
+/// Sparse results are otherwise assembled serially by appending.  This must 
+/// be set when the computation is compiled.
+void taco_set_parallel_assembly(bool parallel_assembly);
+
+/// Get whether computations with sparse results are parallelized by 
+/// assembling their results in two phases.
+bool taco_get_parallel_assembly();
+
+/// Set whether computations that reduce into small dense results have their
+/// outer reduction loops parallelized, with every thread accumulating into a
+/// private copy of the result (see shouldPrivatizeReductions).  These loops 
+/// are otherwise left serial.  This must be set when the computation is 
+/// compiled.
+void taco_set_privatized_reductions(bool privatized_reductions);
+
+/// Get whether computations that reduce into small dense results have their
+/// outer reduction loops parallelized with private copies of the result.
+bool taco_get_privatized_reductions();
+
 /// Set maximum number of threads to use for parallel execution of tensor
 /// computations. This will be replaced by a scheduling language in the future.
 void taco_set_num_threads(int num_threads);
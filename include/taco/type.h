@@ -28,6 +28,8 @@ public:
     Int32,
     Int64,
     Int128,
+    Float16,
+    BFloat16,
     Float32,
     Float64,
     Complex64,
@@ -82,6 +84,8 @@ extern Datatype Int32;
 extern Datatype Int64;
 extern Datatype Int128;
 Datatype Float(int bits = sizeof(double)*8);
+extern Datatype Float16;
+extern Datatype BFloat16;
 extern Datatype Float32;
 extern Datatype Float64;
 Datatype Complex(int bits);
@@ -90,6 +94,40 @@ extern Datatype Complex128;
 
 Datatype max_type(Datatype a, Datatype b);
 
+/// A half-precision (IEEE 754 binary16) floating-point number. Half-precision
+/// numbers only store values; arithmetic converts them to float.
+class float16 {
+public:
+  float16() : bits(0) {}
+  float16(float value);
+  operator float() const;
+
+  /// Returns the binary16 encoding of the number.
+  uint16_t getBits() const { return bits; }
+
+private:
+  uint16_t bits;
+};
+
+/// A bfloat16 floating-point number, which has the exponent range of float but
+/// only an 8-bit significand. Like half-precision numbers, bfloat16 numbers
+/// only store values; arithmetic converts them to float.
+class bfloat16 {
+public:
+  bfloat16() : bits(0) {}
+  bfloat16(float value);
+  operator float() const;
+
+  /// Returns the upper 16 bits of the float encoding of the number.
+  uint16_t getBits() const { return bits; }
+
+private:
+  uint16_t bits;
+};
+
+std::ostream& operator<<(std::ostream&, const float16&);
+std::ostream& operator<<(std::ostream&, const bfloat16&);
+
 template<typename T> inline Datatype type() {
   taco_ierror << "Unsupported type";
   return Int32;
@@ -143,6 +181,14 @@ template<> inline Datatype type<int8_t>() {
   return Int8;
 }
 
+template<> inline Datatype type<float16>() {
+  return Float16;
+}
+
+template<> inline Datatype type<bfloat16>() {
+  return BFloat16;
+}
+
 template<> inline Datatype type<float>() {
   return Float32;
 }
@@ -175,6 +221,8 @@ union ComponentTypeUnion {
   int64_t int64Value;
   long long int128Value;
 
+  float16 float16Value;
+  bfloat16 bfloat16Value;
   float float32Value;
   double float64Value;
 
@@ -11,6 +11,7 @@ std::string getNpType(const taco::Datatype& dtype) {
   if (dtype.isBool()) return "bool_";
   else if (dtype.isInt()) return "int" + std::to_string(dtype.getNumBits());
   else if (dtype.isUInt()) return "uint" + std::to_string(dtype.getNumBits());
+  else if (dtype == taco::BFloat16) throw py::type_error("NumPy has no bfloat16 data type");
   else if (dtype.isFloat()) return "float" + std::to_string(dtype.getNumBits());
   else if (dtype.isComplex()) return "complex" + std::to_string(dtype.getNumBits());
   else throw py::type_error("Datatype must be defined for conversion");
@@ -98,6 +99,11 @@ PyTaco exports the following data types:
 
 :attr:`pytaco.uint64` - A 64 bit unsigned integer.
 
+:attr:`pytaco.float16` - A 16 bit IEEE floating point number.
+
+:attr:`pytaco.bfloat16` - A 16 bit brain floating point number with the exponent range of a float32. It has no NumPy
+equivalent.
+
 :attr:`pytaco.float32` or :attr:`pytaco.float` - A 32 bit floating point number.
 
 :attr:`pytaco.float64` or :attr:`pytaco.double` - A 64 bit floating point number.
@@ -155,6 +161,8 @@ Returns True if the data type is a float or double and False otherwise.
   m.attr("int16")      = Int16;
   m.attr("int32")      = Int32;
   m.attr("int64")      = Int64;
+  m.attr("float16")    = Float16;
+  m.attr("bfloat16")   = BFloat16;
   m.attr("float")      = Float32;
   m.attr("float32")    = Float32;
   m.attr("float64")    = Float64;
@@ -1,5 +1,6 @@
 #include "codegen.h"
 #include "taco/cuda.h"
+#include "taco/storage/allocator.h"
 #include "codegen_cuda.h"
 #include "codegen_c.h"
 #include <algorithm>
@@ -70,7 +71,14 @@ bool CodeGen::checkForAlloc(const Function *func) {
 // helper to translate from taco type to C type
 string CodeGen::printCType(Datatype type, bool is_ptr) {
   stringstream ret;
-  ret << type;
+  // 16-bit floats are stored as their bit patterns and converted to and from
+  // float by the taco_*_to_float and taco_float_to_* routines
+  if (type.getKind() == Float16 || type.getKind() == BFloat16) {
+    ret << "uint16_t";
+  }
+  else {
+    ret << type;
+  }
 
   if (is_ptr) {
     ret << "*";
@@ -101,6 +109,12 @@ string CodeGen::printCUDAType(Datatype type, bool is_ptr) {
   return CodeGen::printCType(type, is_ptr);
 }
 
+// helper to print the element type of an index array; 32-bit index arrays 
+// are printed as plain ints
+string CodeGen::printIndexType(Datatype type) {
+  return (type == Int32) ? "int" : printCType(type, false);
+}
+
 string CodeGen::printType(Datatype type, bool is_ptr) {
   switch (codeGenType) {
     case C:
@@ -201,10 +215,10 @@ string CodeGen::printTensorProperty(string varname, const GetProperty* op, bool
     varname += "_ptr";
   }
 
-  auto tensor = op->tensor.as<Var>();
-  if (op->property == TensorProperty::Values) {
+  if (op->property == TensorProperty::Values ||
+      op->property == TensorProperty::ValuesDictionary) {
     // for the values, it's in the last slot
-    ret << printType(tensor->type, true) << star;
+    ret << printType(op->type, true) << star;
     ret << " " << varname;
     return ret.str();
   } else if (op->property == TensorProperty::ValuesSize) {
@@ -222,7 +236,7 @@ string CodeGen::printTensorProperty(string varname, const GetProperty* op, bool
     ret << tp << " " << varname;
   } else {
     taco_iassert(op->property == TensorProperty::Indices);
-    tp = "int*" + star;
+    tp = printIndexType(op->type) + "*" + star;
     ret << tp << " " << varname;
   }
 
@@ -235,11 +249,22 @@ string CodeGen::unpackTensorProperty(string varname, const GetProperty* op,
   ret << "  ";
 
   auto tensor = op->tensor.as<Var>();
-  if (op->property == TensorProperty::Values) {
+  if (op->property == TensorProperty::Values ||
+      op->property == TensorProperty::ValuesDictionary) {
     // for the values, it's in the last slot
-    ret << printType(tensor->type, true);
-    ret << " " << restrictKeyword() << " " << varname << " = (" << printType(tensor->type, true) << ")(";
-    ret << tensor->name << "->vals);\n";
+    string array = tensor->name + "->" +
+        (op->property == TensorProperty::Values ? "vals" : "vals_dict");
+    // Values arrays have the alignment of the allocator, which lets the C
+    // compiler vectorize loops over them without peeling
+    const size_t alignment = getAllocator()->getAlignment();
+    if (codeGenType == C && op->property == TensorProperty::Values &&
+        alignment > 0) {
+      array = "__builtin_assume_aligned(" + array + ", " +
+              std::to_string(alignment) + ")";
+    }
+    ret << printType(op->type, true);
+    ret << " " << restrictKeyword() << " " << varname << " = (" << printType(op->type, true) << ")(";
+    ret << array << ");\n";
     return ret.str();
   } else if (op->property == TensorProperty::ValuesSize) {
     ret << "int " << varname << " = " << tensor->name << "->vals_size;\n";
@@ -261,10 +286,10 @@ string CodeGen::unpackTensorProperty(string varname, const GetProperty* op,
         << "->dimensions[" << op->mode << "]);\n";
   } else {
     taco_iassert(op->property == TensorProperty::Indices);
-    tp = "int*";
+    tp = printIndexType(op->type) + "*";
     auto nm = op->index;
     ret << tp << " " << restrictKeyword() << " " << varname << " = ";
-    ret << "(int*)(" << tensor->name << "->indices[" << op->mode;
+    ret << "(" << tp << ")(" << tensor->name << "->indices[" << op->mode;
     ret << "][" << nm << "]);\n";
   }
 
@@ -285,7 +310,8 @@ string CodeGen::packTensorProperty(string varname, Expr tnsr,
   } else if (property == TensorProperty::ValuesSize) {
     ret << tensor->name << "->vals_size = " << varname << ";\n";
     return ret.str();
-  } else if (property == TensorProperty::FillValue) {
+  } else if (property == TensorProperty::FillValue ||
+             property == TensorProperty::ValuesDictionary) {
     return "";
   }
 
@@ -474,14 +500,16 @@ void CodeGen::resetUniqueNameCounters() {
 }
 
 string CodeGen::genUniqueName(string name) {
-  stringstream os;
-  os << name;
+  string uniqueName = name;
   if (uniqueNameCounters.count(name) > 0) {
-    os << uniqueNameCounters[name]++;
-  } else {
-    uniqueNameCounters[name] = 0;
-  }
-  return os.str();
+    // Skip names that were already generated (e.g. i0 for a variable named i0
+    // must not be reused for a copy of a variable named i)
+    do {
+      uniqueName = name + to_string(uniqueNameCounters[name]++);
+    } while (uniqueNameCounters.count(uniqueName) > 0);
+  }
+  uniqueNameCounters[uniqueName] = 0;
+  return uniqueName;
 }
 
 static vector<const GetProperty*> sortProps(std::map<Expr, std::string, ExprCompare> map) {
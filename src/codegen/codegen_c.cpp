@@ -53,8 +53,84 @@ const string cHeaders =
   "  uint8_t*     vals;          // tensor values\n"
   "  uint8_t*     fill_value;    // tensor fill value\n"
   "  int32_t      vals_size;     // values array size\n"
+  "  uint8_t*     vals_dict;     // dictionary of encoded values\n"
   "} taco_tensor_t;\n"
+  "typedef struct {\n"
+  "  void* context;                              // allocator of the kernels\n"
+  "  void* (*allocate)(void*, size_t);           // allocates memory\n"
+  "  void* (*reallocate)(void*, void*, size_t);  // resizes allocated memory\n"
+  "  void  (*deallocate)(void*, void*);          // deallocates memory\n"
+  "} taco_allocator_t;\n"
   "#endif\n"
+  // Kernels allocate through the allocator that taco installs when it loads
+  // the kernels, which defaults to malloc, realloc and free.
+  "void* taco_default_allocate(void* context, size_t size) {\n"
+  "  return malloc(size);\n"
+  "}\n"
+  "void* taco_default_reallocate(void* context, void* ptr, size_t size) {\n"
+  "  return realloc(ptr, size);\n"
+  "}\n"
+  "void taco_default_deallocate(void* context, void* ptr) {\n"
+  "  free(ptr);\n"
+  "}\n"
+  "taco_allocator_t taco_allocator = {NULL, taco_default_allocate,\n"
+  "    taco_default_reallocate, taco_default_deallocate};\n"
+  "#define taco_malloc(_s) \\\n"
+  "    (taco_allocator.allocate(taco_allocator.context, (_s)))\n"
+  "#define taco_realloc(_p,_s) \\\n"
+  "    (taco_allocator.reallocate(taco_allocator.context, (_p), (_s)))\n"
+  "#define taco_free(_p) \\\n"
+  "    (taco_allocator.deallocate(taco_allocator.context, (_p)))\n"
+  "void* taco_calloc(size_t num, size_t size) {\n"
+  "  void* ptr = taco_malloc(num * size);\n"
+  "  memset(ptr, 0, num * size);\n"
+  "  return ptr;\n"
+  "}\n"
+  // Pooled workspaces keep their memory across kernel invocations and only
+  // grow. Workspaces that must be cleared are cleared when they are allocated,
+  // and kernels clear the entries they set before they return. Every
+  // workspace records the allocator that owns its memory and is linked into
+  // a list of the workspaces of the module, which taco releases when it
+  // destroys the module.
+  "typedef struct taco_workspace_t {\n"
+  "  void*  data;\n"
+  "  size_t size;\n"
+  "  taco_allocator_t allocator;\n"
+  "  struct taco_workspace_t* next;\n"
+  "} taco_workspace_t;\n"
+  "taco_workspace_t* taco_workspaces = NULL;\n"
+  "void* taco_workspace(taco_workspace_t** pool, size_t size, int clear) {\n"
+  "  taco_workspace_t* workspace = *pool;\n"
+  "  if (workspace == NULL) {\n"
+  "    workspace = (taco_workspace_t*)calloc(1, sizeof(taco_workspace_t));\n"
+  "    workspace->allocator = taco_allocator;\n"
+  "    workspace->next = __atomic_load_n(&taco_workspaces, __ATOMIC_RELAXED);\n"
+  "    while (!__atomic_compare_exchange_n(&taco_workspaces, &workspace->next,\n"
+  "        workspace, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));\n"
+  "    *pool = workspace;\n"
+  "  }\n"
+  "  if (workspace->size < size) {\n"
+  "    taco_allocator_t allocator = workspace->allocator;\n"
+  "    allocator.deallocate(allocator.context, workspace->data);\n"
+  "    workspace->data = allocator.allocate(allocator.context, size);\n"
+  "    if (clear) {\n"
+  "      memset(workspace->data, 0, size);\n"
+  "    }\n"
+  "    workspace->size = size;\n"
+  "  }\n"
+  "  return workspace->data;\n"
+  "}\n"
+  "void taco_release_workspaces() {\n"
+  "  taco_workspace_t* workspace =\n"
+  "      __atomic_exchange_n(&taco_workspaces, NULL, __ATOMIC_ACQUIRE);\n"
+  "  while (workspace != NULL) {\n"
+  "    taco_workspace_t* next = workspace->next;\n"
+  "    workspace->allocator.deallocate(workspace->allocator.context,\n"
+  "                                    workspace->data);\n"
+  "    free(workspace);\n"
+  "    workspace = next;\n"
+  "  }\n"
+  "}\n"
   "#if !_OPENMP\n"
   "int omp_get_thread_num() { return 0; }\n"
   "int omp_get_max_threads() { return 1; }\n"
@@ -126,6 +202,190 @@ const string cHeaders =
   "  }\n"
   "  return lowerBound;\n"
   "}\n"
+  // Returns the first position in [arrayStart, arrayEnd) whose coordinate is
+  // not less than `target`, or `arrayEnd` if there is no such position.
+  "int taco_lowerBound(int *array, int arrayStart, int arrayEnd, int target) {\n"
+  "  while (arrayStart < arrayEnd) {\n"
+  "    int mid = arrayStart + (arrayEnd - arrayStart) / 2;\n"
+  "    if (array[mid] < target) {\n"
+  "      arrayStart = mid + 1;\n"
+  "    }\n"
+  "    else {\n"
+  "      arrayEnd = mid;\n"
+  "    }\n"
+  "  }\n"
+  "  return arrayStart;\n"
+  "}\n"
+  // Linearly probe the hash table of `width` slots starting at `tableStart`
+  // for `target`. Returns the slot storing `target` or, if `target` is not
+  // stored, the empty slot it should be inserted into. Returns the position
+  // following the table if the table is full and does not store `target`.
+  "int taco_hash_locate(int *array, int tableStart, int width, int target) {\n"
+  "  int slot = (int)(((uint32_t)target * 2654435761u) % (uint32_t)width);\n"
+  "  for (int probe = 0; probe < width; probe++) {\n"
+  "    int pos = tableStart + slot;\n"
+  "    if (array[pos] == target || array[pos] < 0) {\n"
+  "      return pos;\n"
+  "    }\n"
+  "    slot = (slot + 1 == width) ? 0 : slot + 1;\n"
+  "  }\n"
+  "  return tableStart + width;\n"
+  "}\n"
+  // Push the pair of `coord` and `loc` onto a binary min-heap of `size` pairs
+  // of coordinates and locations that is ordered by coordinate. Returns the
+  // size of the heap after the push.
+  "int taco_heap_push(int *heap, int size, int coord, int loc) {\n"
+  "  int child = size;\n"
+  "  while (child > 0) {\n"
+  "    int parent = (child - 1) / 2;\n"
+  "    if (heap[2 * parent] <= coord) {\n"
+  "      break;\n"
+  "    }\n"
+  "    heap[2 * child] = heap[2 * parent];\n"
+  "    heap[2 * child + 1] = heap[2 * parent + 1];\n"
+  "    child = parent;\n"
+  "  }\n"
+  "  heap[2 * child] = coord;\n"
+  "  heap[2 * child + 1] = loc;\n"
+  "  return size + 1;\n"
+  "}\n"
+  // Pop the pair with the smallest coordinate off a heap of `size` pairs.
+  // Returns the size of the heap after the pop.
+  "int taco_heap_pop(int *heap, int size) {\n"
+  "  size--;\n"
+  "  int coord = heap[2 * size];\n"
+  "  int loc = heap[2 * size + 1];\n"
+  "  int parent = 0;\n"
+  "  while (2 * parent + 1 < size) {\n"
+  "    int child = 2 * parent + 1;\n"
+  "    if (child + 1 < size && heap[2 * child + 2] < heap[2 * child]) {\n"
+  "      child++;\n"
+  "    }\n"
+  "    if (coord <= heap[2 * child]) {\n"
+  "      break;\n"
+  "    }\n"
+  "    heap[2 * parent] = heap[2 * child];\n"
+  "    heap[2 * parent + 1] = heap[2 * child + 1];\n"
+  "    parent = child;\n"
+  "  }\n"
+  "  heap[2 * parent] = coord;\n"
+  "  heap[2 * parent + 1] = loc;\n"
+  "  return size;\n"
+  "}\n"
+  // Returns the slot of the diagonal with offset `target` in the offset array
+  // of a DIA level, or the overflow slot if no diagonal has that offset.
+  "int taco_dia_locate(int *array, int target) {\n"
+  "  for (int d = 0; d < array[0]; d++) {\n"
+  "    if (array[d + 1] == target) {\n"
+  "      return d;\n"
+  "    }\n"
+  "  }\n"
+  "  return array[0];\n"
+  "}\n"
+  // Returns the run that stores position `pos` of a run-length level, whose
+  // run array stores the number of runs followed by the first coordinate and
+  // first position of every run.
+  "int taco_rle_run(int *array, int pos) {\n"
+  "  int lowerBound = 0; // always <= run of pos\n"
+  "  int upperBound = array[0]; // always > run of pos\n"
+  "  while (upperBound - lowerBound > 1) {\n"
+  "    int mid = (upperBound + lowerBound) / 2;\n"
+  "    if (array[2 * mid + 2] <= pos) {\n"
+  "      lowerBound = mid;\n"
+  "    }\n"
+  "    else {\n"
+  "      upperBound = mid;\n"
+  "    }\n"
+  "  }\n"
+  "  return lowerBound;\n"
+  "}\n"
+  "int taco_rle_coord(int *array, int pos) {\n"
+  "  int run = taco_rle_run(array, pos);\n"
+  "  return array[2 * run + 1] + (pos - array[2 * run + 2]);\n"
+  "}\n"
+  // Bit manipulation routines for levels whose positions are marked by the
+  // bits of 64-bit words (e.g., bitmaps).
+  "uint64_t taco_bit(int bit) {\n"
+  "  return (uint64_t)1 << (bit & 63);\n"
+  "}\n"
+  "bool taco_bit_test(uint64_t *words, int wordStart, int bit) {\n"
+  "  return (words[wordStart + (bit >> 6)] >> (bit & 63)) & 1;\n"
+  "}\n"
+  "int taco_ctz(uint64_t word) {\n"
+  "  return __builtin_ctzll(word);\n"
+  "}\n"
+  // Conversion routines for 16-bit floats, which are stored as uint16_t bit
+  // patterns and loaded as floats. These must round like taco::float16 and
+  // taco::bfloat16.
+  "float taco_half_to_float(uint16_t h) {\n"
+  "  uint32_t sign = (uint32_t)(h & 0x8000) << 16;\n"
+  "  uint32_t exp = (h >> 10) & 0x1f;\n"
+  "  uint32_t man = h & 0x3ff;\n"
+  "  uint32_t bits;\n"
+  "  if (exp == 0x1f) {\n"
+  "    bits = sign | 0x7f800000 | (man << 13);\n"
+  "  } else if (exp != 0) {\n"
+  "    bits = sign | ((exp + 112) << 23) | (man << 13);\n"
+  "  } else if (man != 0) {\n"
+  "    exp = 113;\n"
+  "    while (!(man & 0x400)) {\n"
+  "      man <<= 1;\n"
+  "      exp--;\n"
+  "    }\n"
+  "    bits = sign | (exp << 23) | ((man & 0x3ff) << 13);\n"
+  "  } else {\n"
+  "    bits = sign;\n"
+  "  }\n"
+  "  float f;\n"
+  "  memcpy(&f, &bits, sizeof(f));\n"
+  "  return f;\n"
+  "}\n"
+  "uint16_t taco_float_to_half(float f) {\n"
+  "  uint32_t bits;\n"
+  "  memcpy(&bits, &f, sizeof(bits));\n"
+  "  uint16_t sign = (bits >> 16) & 0x8000;\n"
+  "  uint32_t abs = bits & 0x7fffffff;\n"
+  "  if (abs > 0x7f800000) {\n"
+  "    return sign | 0x7e00;\n"
+  "  }\n"
+  "  if (abs >= 0x477ff000) {\n"
+  "    return sign | 0x7c00;\n"
+  "  }\n"
+  "  if (abs < 0x38800000) {\n"
+  "    if (abs < 0x33000000) {\n"
+  "      return sign;\n"
+  "    }\n"
+  "    uint32_t man = (abs & 0x7fffff) | 0x800000;\n"
+  "    int shift = 126 - (int)(abs >> 23);\n"
+  "    uint32_t half = man >> shift;\n"
+  "    uint32_t rem = man & ((1u << shift) - 1);\n"
+  "    uint32_t mid = 1u << (shift - 1);\n"
+  "    if (rem > mid || (rem == mid && (half & 1))) {\n"
+  "      half++;\n"
+  "    }\n"
+  "    return sign | half;\n"
+  "  }\n"
+  "  uint32_t half = ((abs >> 13) - (112 << 10));\n"
+  "  uint32_t rem = abs & 0x1fff;\n"
+  "  if (rem > 0x1000 || (rem == 0x1000 && (half & 1))) {\n"
+  "    half++;\n"
+  "  }\n"
+  "  return sign | half;\n"
+  "}\n"
+  "float taco_bfloat16_to_float(uint16_t h) {\n"
+  "  uint32_t bits = (uint32_t)h << 16;\n"
+  "  float f;\n"
+  "  memcpy(&f, &bits, sizeof(f));\n"
+  "  return f;\n"
+  "}\n"
+  "uint16_t taco_float_to_bfloat16(float f) {\n"
+  "  uint32_t bits;\n"
+  "  memcpy(&bits, &f, sizeof(bits));\n"
+  "  if ((bits & 0x7fffffff) > 0x7f800000) {\n"
+  "    return (bits >> 16) | 0x40;\n"
+  "  }\n"
+  "  return (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;\n"
+  "}\n"
   "taco_tensor_t* init_taco_tensor_t(int32_t order, int32_t csize,\n"
   "                                  int32_t* dimensions, int32_t* mode_ordering,\n"
   "                                  taco_mode_t* mode_types) {\n"
@@ -420,6 +680,585 @@ static string getAtomicPragma() {
   return "#pragma omp atomic";
 }
 
+// Vectorized loops whose bodies are straight-line code are emitted as explicit
+// vector code on GCC/Clang vector types, since compilers often refuse to 
+// vectorize sparse loops from pragmas alone (and gcc ignores clang pragmas).
+// Every iteration of the vector loop computes `lanes` iterations of the loop: 
+// loads and stores at locations that increase with the loop variable become 
+// vector loads and stores, loads at other locations (e.g., at coordinates 
+// loaded from crd arrays) become gathers, and scalars that the loop reduces 
+// into are accumulated in vectors that are reduced horizontally after the 
+// loop.  The remaining iterations are computed by a scalar loop.
+class CodeGen_C::VectorLoop {
+public:
+  VectorLoop(const For* loop, CodeGen_C* codeGen) 
+      : loop(loop), codeGen(codeGen) {
+    // The vector and remainder loops both step through unit strides
+    vectorizable = isa<Literal>(loop->increment) && 
+                   to<Literal>(loop->increment)->equalsScalar(1) && 
+                   collectStmts(loop->contents) && classify() && 
+                   chooseLanes();
+  }
+
+  /// Returns true if the loop can be emitted as explicit vector code.
+  bool isVectorizable() const {
+    return vectorizable;
+  }
+
+  /// Emit the vector loop followed by the scalar remainder loop.
+  void emit();
+
+private:
+  /// An expression is either invariant in the loop, contiguous (i.e., an 
+  /// invariant plus the loop variable, such as the locations of dense loads 
+  /// and stores), or varying.
+  enum Kind {Invariant, Contiguous, Varying};
+
+  struct VarsAndLoads : public IRVisitor {
+    using IRVisitor::visit;
+    vector<const Var*> vars;
+    vector<const Load*> loads;
+    void visit(const Var* op) {
+      vars.push_back(op);
+    }
+    void visit(const Load* op) {
+      loads.push_back(op);
+      IRVisitor::visit(op);
+    }
+  };
+
+  static bool isVectorType(Datatype type) {
+    return (type.isFloat() || type.isInt()) && 
+           (type.getNumBits() == 32 || type.getNumBits() == 64);
+  }
+
+  bool collectStmts(Stmt stmt);
+  bool classify();
+  bool chooseLanes();
+  Kind getKind(Expr expr) const;
+  bool isSupported(Expr expr);
+  void addType(Datatype type);
+  string getVectorType(Datatype type, bool unaligned=false) const;
+  void emitScalarExpr(Expr expr);
+  void emitVectorExpr(Expr expr, Datatype type);
+  void emitGatherLocations(Expr expr);
+  void emitStmt(Stmt stmt);
+
+  const For* loop;
+  CodeGen_C* codeGen;
+  bool vectorizable;
+  int lanes = 0;
+  bool hasRemainder = true;
+  vector<Stmt> stmts;
+  vector<Datatype> types;
+
+  /// The kinds of the loop variable and the variables declared in the body
+  map<Expr,Kind,ExprCompare> kinds;
+
+  /// The vector accumulators of variables that the loop reduces into
+  map<Expr,string,ExprCompare> reductions;
+
+  /// The location vectors of the gathers of the statement being emitted
+  map<Expr,string,ExprCompare> gatherLocations;
+};
+
+bool CodeGen_C::VectorLoop::collectStmts(Stmt stmt) {
+  if (!stmt.defined() || isa<Comment>(stmt) || isa<BlankLine>(stmt)) {
+    return true;
+  }
+  if (isa<Scope>(stmt)) {
+    return collectStmts(to<Scope>(stmt)->scopedStmt);
+  }
+  if (isa<Block>(stmt)) {
+    for (const auto& contained : to<Block>(stmt)->contents) {
+      if (!collectStmts(contained)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (isa<VarDecl>(stmt) || isa<Assign>(stmt) || isa<Store>(stmt)) {
+    stmts.push_back(stmt);
+    return true;
+  }
+  return false;
+}
+
+CodeGen_C::VectorLoop::Kind CodeGen_C::VectorLoop::getKind(Expr expr) const {
+  VarsAndLoads uses;
+  expr.accept(&uses);
+  bool isInvariant = true;
+  for (const Var* var : uses.vars) {
+    if (kinds.count(var) && kinds.at(var) != Invariant) {
+      isInvariant = false;
+    }
+  }
+  if (isInvariant) {
+    return Invariant;
+  }
+  if (isa<Var>(expr)) {
+    return kinds.at(expr);
+  }
+  if (isa<Add>(expr)) {
+    Kind a = getKind(to<Add>(expr)->a);
+    Kind b = getKind(to<Add>(expr)->b);
+    if ((a == Contiguous && b == Invariant) || 
+        (a == Invariant && b == Contiguous)) {
+      return Contiguous;
+    }
+  }
+  if (isa<Sub>(expr) && getKind(to<Sub>(expr)->a) == Contiguous && 
+      getKind(to<Sub>(expr)->b) == Invariant) {
+    return Contiguous;
+  }
+  return Varying;
+}
+
+bool CodeGen_C::VectorLoop::classify() {
+  kinds[loop->var] = Contiguous;
+  set<Expr,ExprCompare> assigned;
+  for (const auto& stmt : stmts) {
+    if (isa<VarDecl>(stmt)) {
+      Expr var = to<VarDecl>(stmt)->var;
+      if (kinds.count(var) || to<Var>(var)->is_ptr) {
+        return false;
+      }
+      kinds[var] = Invariant;
+    } else if (isa<Assign>(stmt)) {
+      assigned.insert(to<Assign>(stmt)->lhs);
+    }
+  }
+  if (assigned.count(loop->var)) {
+    return false;
+  }
+
+  // Variables that are assigned in the loop are varying if any of the values 
+  // they are assigned is not invariant, and the kinds of variables depend on 
+  // the kinds of the variables they are computed from.
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const auto& stmt : stmts) {
+      Expr var, value;
+      if (isa<VarDecl>(stmt)) {
+        var = to<VarDecl>(stmt)->var;
+        value = to<VarDecl>(stmt)->rhs;
+      } else if (isa<Assign>(stmt) && 
+                 kinds.count(to<Assign>(stmt)->lhs)) {
+        var = to<Assign>(stmt)->lhs;
+        value = to<Assign>(stmt)->rhs;
+      } else {
+        continue;
+      }
+      Kind kind = getKind(value);
+      if (kind != Invariant && assigned.count(var)) {
+        kind = Varying;
+      }
+      if (kind > kinds[var]) {
+        kinds[var] = kind;
+        changed = true;
+      }
+    }
+  }
+
+  map<Expr,Expr,ExprCompare> storeLocs;
+  for (const auto& stmt : stmts) {
+    if (isa<VarDecl>(stmt)) {
+      const VarDecl* decl = to<VarDecl>(stmt);
+      if (kinds[decl->var] == Varying && 
+          !(decl->rhs.type() == decl->var.type() && isSupported(decl->rhs))) {
+        return false;
+      }
+      if (kinds[decl->var] == Varying) {
+        addType(decl->var.type());
+      }
+    } else if (isa<Assign>(stmt)) {
+      const Assign* assign = to<Assign>(stmt);
+      if (assign->use_atomics) {
+        return false;
+      }
+      if (kinds.count(assign->lhs)) {
+        if (kinds[assign->lhs] == Varying && 
+            !(assign->rhs.type() == assign->lhs.type() && 
+              isSupported(assign->rhs))) {
+          return false;
+        }
+        continue;
+      }
+
+      // Variables declared outside the loop may only be reduced into
+      const Add* add = assign->rhs.as<Add>();
+      if (!isa<Var>(assign->lhs) || to<Var>(assign->lhs)->is_ptr || 
+          add == nullptr || add->a != assign->lhs || 
+          reductions.count(assign->lhs) ||
+          getKind(add->b) == Invariant || 
+          add->b.type() != assign->lhs.type() || !isSupported(add->b)) {
+        return false;
+      }
+      addType(assign->lhs.type());
+      reductions.insert({assign->lhs, 
+          codeGen->genUniqueName(to<Var>(assign->lhs)->name + "_vec")});
+    } else {
+      const Store* store = to<Store>(stmt);
+      if (store->use_atomics || getKind(store->loc) != Contiguous || 
+          getKind(store->arr) != Invariant || 
+          store->data.type() != store->arr.type() || 
+          !isSupported(store->data) ||
+          (storeLocs.count(store->arr) && 
+           storeLocs.at(store->arr) != store->loc)) {
+        return false;
+      }
+      addType(store->arr.type());
+      storeLocs.insert({store->arr, store->loc});
+    }
+  }
+
+  // Arrays that are stored into may only be loaded at the stored locations, 
+  // and reduction variables may only be used by their reduction, since lanes 
+  // do not see the stores and reductions of other lanes.
+  VarsAndLoads uses;
+  for (const auto& stmt : stmts) {
+    stmt.accept(&uses);
+  }
+  for (const Load* load : uses.loads) {
+    if (storeLocs.count(load->arr) && 
+        storeLocs.at(load->arr) != load->loc) {
+      return false;
+    }
+  }
+  for (const auto& reduction : reductions) {
+    if (count(uses.vars.begin(), uses.vars.end(), 
+              to<Var>(reduction.first)) != 2) {
+      return false;
+    }
+  }
+  return !types.empty();
+}
+
+bool CodeGen_C::VectorLoop::chooseLanes() {
+  if (loop->vec_width > 1) {
+    lanes = loop->vec_width;
+  } else {
+    // Fill 256-bit vectors, which compilers split for narrower targets
+    int maxBytes = 0;
+    for (const auto& type : types) {
+      maxBytes = std::max(maxBytes, type.getNumBytes());
+    }
+    lanes = std::max(2, 32 / maxBytes);
+  }
+
+  const Literal* start = loop->start.as<Literal>();
+  const Literal* end = loop->end.as<Literal>();
+  if (start != nullptr && end != nullptr && start->type.isInt() && 
+      end->type.isInt()) {
+    const long long numIterations = end->getIntValue() - start->getIntValue();
+    while (lanes > numIterations && lanes > 1) {
+      lanes /= 2;
+    }
+    hasRemainder = (numIterations % lanes != 0);
+  }
+  return lanes > 1;
+}
+
+bool CodeGen_C::VectorLoop::isSupported(Expr expr) {
+  if (!isVectorType(expr.type())) {
+    return false;
+  }
+  addType(expr.type());
+
+  Kind kind = getKind(expr);
+  if (kind != Varying || isa<Var>(expr)) {
+    return true;
+  }
+  if (isa<Load>(expr)) {
+    const Load* load = to<Load>(expr);
+    if (getKind(load->arr) != Invariant) {
+      return false;
+    }
+    return getKind(load->loc) == Contiguous || 
+           (load->loc.type().isInt() && isSupported(load->loc));
+  }
+  if (isa<Neg>(expr)) {
+    return to<Neg>(expr)->a.type() == expr.type() && 
+           isSupported(to<Neg>(expr)->a);
+  }
+
+  Expr a, b;
+  if (isa<Add>(expr)) {
+    a = to<Add>(expr)->a; b = to<Add>(expr)->b;
+  } else if (isa<Sub>(expr)) {
+    a = to<Sub>(expr)->a; b = to<Sub>(expr)->b;
+  } else if (isa<Mul>(expr)) {
+    a = to<Mul>(expr)->a; b = to<Mul>(expr)->b;
+  } else if (isa<Div>(expr)) {
+    a = to<Div>(expr)->a; b = to<Div>(expr)->b;
+  } else {
+    return false;
+  }
+  return a.type() == expr.type() && b.type() == expr.type() && 
+         isSupported(a) && isSupported(b);
+}
+
+void CodeGen_C::VectorLoop::addType(Datatype type) {
+  if (!util::contains(types, type)) {
+    types.push_back(type);
+  }
+}
+
+string CodeGen_C::VectorLoop::getVectorType(Datatype type, 
+                                            bool unaligned) const {
+  return "taco_v" + to_string(lanes) + "_" + printCType(type, false) + 
+         (unaligned ? "_u" : "");
+}
+
+void CodeGen_C::VectorLoop::emitScalarExpr(Expr expr) {
+  codeGen->parentPrecedence = BOTTOM;
+  expr.accept(codeGen);
+}
+
+void CodeGen_C::VectorLoop::emitVectorExpr(Expr expr, Datatype type) {
+  ostream& stream = codeGen->stream;
+  switch (getKind(expr)) {
+    case Invariant:
+      // Broadcast invariants to every lane
+      stream << "((" << getVectorType(type) << "){";
+      for (int l = 0; l < lanes; l++) {
+        stream << (l > 0 ? ", " : "");
+        emitScalarExpr(expr);
+      }
+      stream << "})";
+      return;
+    case Contiguous:
+      stream << "(";
+      emitScalarExpr(expr);
+      stream << " + (" << getVectorType(type) << "){";
+      for (int l = 0; l < lanes; l++) {
+        stream << (l > 0 ? ", " : "") << l;
+      }
+      stream << "})";
+      return;
+    case Varying:
+      break;
+  }
+
+  if (isa<Var>(expr)) {
+    expr.accept(codeGen);
+  } else if (isa<Load>(expr)) {
+    const Load* load = to<Load>(expr);
+    if (getKind(load->loc) == Contiguous) {
+      stream << "(*(" << getVectorType(type, true) << "*)(&";
+      emitScalarExpr(load->arr);
+      stream << "[";
+      emitScalarExpr(load->loc);
+      stream << "]))";
+    } else {
+      // Gather the lanes at the locations of the location vector, which 
+      // emitGatherLocations declares unless it is a variable
+      stream << "((" << getVectorType(type) << "){";
+      for (int l = 0; l < lanes; l++) {
+        stream << (l > 0 ? ", " : "");
+        emitScalarExpr(load->arr);
+        stream << "[";
+        if (gatherLocations.count(load->loc)) {
+          stream << gatherLocations.at(load->loc);
+        } else {
+          emitVectorExpr(load->loc, load->loc.type());
+        }
+        stream << "[" << l << "]]";
+      }
+      stream << "})";
+    }
+  } else if (isa<Neg>(expr)) {
+    stream << "(-";
+    emitVectorExpr(to<Neg>(expr)->a, type);
+    stream << ")";
+  } else {
+    Expr a, b;
+    string op;
+    if (isa<Add>(expr)) {
+      a = to<Add>(expr)->a; b = to<Add>(expr)->b; op = " + ";
+    } else if (isa<Sub>(expr)) {
+      a = to<Sub>(expr)->a; b = to<Sub>(expr)->b; op = " - ";
+    } else if (isa<Mul>(expr)) {
+      a = to<Mul>(expr)->a; b = to<Mul>(expr)->b; op = " * ";
+    } else {
+      taco_iassert(isa<Div>(expr));
+      a = to<Div>(expr)->a; b = to<Div>(expr)->b; op = " / ";
+    }
+    stream << "(";
+    emitVectorExpr(a, type);
+    stream << op;
+    emitVectorExpr(b, type);
+    stream << ")";
+  }
+}
+
+void CodeGen_C::VectorLoop::emitGatherLocations(Expr expr) {
+  if (getKind(expr) != Varying) {
+    return;
+  }
+
+  ostream& stream = codeGen->stream;
+  if (isa<Load>(expr)) {
+    const Load* load = to<Load>(expr);
+    if (getKind(load->loc) == Contiguous || isa<Var>(load->loc) ||
+        gatherLocations.count(load->loc)) {
+      return;
+    }
+    emitGatherLocations(load->loc);
+    const string name = codeGen->genUniqueName("loc");
+    codeGen->doIndent();
+    stream << getVectorType(load->loc.type()) << " " << name << " = ";
+    emitVectorExpr(load->loc, load->loc.type());
+    stream << ";" << endl;
+    gatherLocations.insert({load->loc, name});
+  } else if (isa<Neg>(expr)) {
+    emitGatherLocations(to<Neg>(expr)->a);
+  } else if (isa<Add>(expr)) {
+    emitGatherLocations(to<Add>(expr)->a);
+    emitGatherLocations(to<Add>(expr)->b);
+  } else if (isa<Sub>(expr)) {
+    emitGatherLocations(to<Sub>(expr)->a);
+    emitGatherLocations(to<Sub>(expr)->b);
+  } else if (isa<Mul>(expr)) {
+    emitGatherLocations(to<Mul>(expr)->a);
+    emitGatherLocations(to<Mul>(expr)->b);
+  } else if (isa<Div>(expr)) {
+    emitGatherLocations(to<Div>(expr)->a);
+    emitGatherLocations(to<Div>(expr)->b);
+  }
+}
+
+void CodeGen_C::VectorLoop::emitStmt(Stmt stmt) {
+  ostream& stream = codeGen->stream;
+  // Location vectors are declared before the statement that gathers with 
+  // them, since the variables they are computed from may change later
+  gatherLocations.clear();
+  if (isa<VarDecl>(stmt) && kinds.at(to<VarDecl>(stmt)->var) == Varying) {
+    const VarDecl* decl = to<VarDecl>(stmt);
+    emitGatherLocations(decl->rhs);
+    codeGen->doIndent();
+    stream << getVectorType(decl->var.type()) << " ";
+    decl->var.accept(codeGen);
+    stream << " = ";
+    emitVectorExpr(decl->rhs, decl->var.type());
+    stream << ";" << endl;
+  } else if (isa<Assign>(stmt) && reductions.count(to<Assign>(stmt)->lhs)) {
+    const Assign* assign = to<Assign>(stmt);
+    emitGatherLocations(to<Add>(assign->rhs)->b);
+    codeGen->doIndent();
+    stream << reductions.at(assign->lhs) << " += ";
+    emitVectorExpr(to<Add>(assign->rhs)->b, assign->lhs.type());
+    stream << ";" << endl;
+  } else if (isa<Assign>(stmt) && kinds.at(to<Assign>(stmt)->lhs) == Varying) {
+    const Assign* assign = to<Assign>(stmt);
+    emitGatherLocations(assign->rhs);
+    codeGen->doIndent();
+    assign->lhs.accept(codeGen);
+    const Add* add = assign->rhs.as<Add>();
+    if (add != nullptr && add->a == assign->lhs) {
+      stream << " += ";
+      emitVectorExpr(add->b, assign->lhs.type());
+    } else {
+      stream << " = ";
+      emitVectorExpr(assign->rhs, assign->lhs.type());
+    }
+    stream << ";" << endl;
+  } else if (isa<Store>(stmt)) {
+    const Store* store = to<Store>(stmt);
+    emitGatherLocations(store->data);
+    codeGen->doIndent();
+    stream << "*(" << getVectorType(store->arr.type(), true) << "*)(&";
+    emitScalarExpr(store->arr);
+    stream << "[";
+    emitScalarExpr(store->loc);
+    stream << "]) = ";
+    emitVectorExpr(store->data, store->arr.type());
+    stream << ";" << endl;
+  } else {
+    // Invariant and contiguous variables are computed by the first lane
+    stmt.accept(codeGen);
+  }
+}
+
+void CodeGen_C::VectorLoop::emit() {
+  ostream& stream = codeGen->stream;
+  codeGen->doIndent();
+  stream << "{" << endl;
+  codeGen->indent++;
+
+  for (const auto& type : types) {
+    const string size = to_string(lanes * type.getNumBytes());
+    codeGen->doIndent();
+    stream << "typedef " << printCType(type, false) << " " 
+           << getVectorType(type) << " __attribute__((vector_size(" << size 
+           << ")));" << endl;
+    codeGen->doIndent();
+    stream << "typedef " << printCType(type, false) << " " 
+           << getVectorType(type, true) << " __attribute__((vector_size(" 
+           << size << "), aligned(" << type.getNumBytes() 
+           << "), __may_alias__));" << endl;
+  }
+  for (const auto& reduction : reductions) {
+    codeGen->doIndent();
+    stream << getVectorType(reduction.first.type()) << " " 
+           << reduction.second << " = {0};" << endl;
+  }
+
+  codeGen->doIndent();
+  stream << printCType(loop->var.type(), false) << " ";
+  loop->var.accept(codeGen);
+  stream << " = ";
+  codeGen->parentPrecedence = TOP;
+  loop->start.accept(codeGen);
+  stream << ";" << endl;
+
+  codeGen->doIndent();
+  stream << "for (; ";
+  loop->var.accept(codeGen);
+  stream << " + " << lanes << " <= ";
+  emitScalarExpr(loop->end);
+  stream << "; ";
+  loop->var.accept(codeGen);
+  stream << " += " << lanes << ") {" << endl;
+  codeGen->indent++;
+  for (const auto& stmt : stmts) {
+    emitStmt(stmt);
+  }
+  codeGen->indent--;
+  codeGen->doIndent();
+  stream << "}" << endl;
+
+  // Reduce the lanes of the accumulators
+  for (const auto& reduction : reductions) {
+    codeGen->doIndent();
+    reduction.first.accept(codeGen);
+    stream << " += ";
+    for (int l = 0; l < lanes; l++) {
+      stream << (l > 0 ? " + " : "") << reduction.second << "[" << l << "]";
+    }
+    stream << ";" << endl;
+  }
+
+  if (hasRemainder) {
+    codeGen->doIndent();
+    stream << "for (; ";
+    loop->var.accept(codeGen);
+    stream << " < ";
+    emitScalarExpr(loop->end);
+    stream << "; ";
+    loop->var.accept(codeGen);
+    stream << "++) {" << endl;
+    loop->contents.accept(codeGen);
+    codeGen->doIndent();
+    stream << "}" << endl;
+  }
+
+  codeGen->indent--;
+  codeGen->doIndent();
+  stream << "}" << endl;
+}
+
 // The next two need to output the correct pragmas depending
 // on the loop kind (Serial, Static, Dynamic, Vectorized)
 //
@@ -428,6 +1267,13 @@ static string getAtomicPragma() {
 void CodeGen_C::visit(const For* op) {
   switch (op->kind) {
     case LoopKind::Vectorized:
+      if (!emittingCoroutine) {
+        VectorLoop vectorLoop(op, this);
+        if (vectorLoop.isVectorizable()) {
+          vectorLoop.emit();
+          return;
+        }
+      }
       doIndent();
       out << genVectorizePragma(op->vec_width);
       out << "\n";
@@ -536,13 +1382,31 @@ void CodeGen_C::visit(const Max* op) {
 void CodeGen_C::visit(const Allocate* op) {
   string elementType = printCType(op->var.type(), false);
 
+  if (op->pooled) {
+    // Every kernel and thread has its own pool for every workspace
+    taco_iassert(isa<Var>(op->var));
+    const string pool = to<Var>(op->var)->name + "_pool";
+    doIndent();
+    stream << "static __thread taco_workspace_t* " << pool << " = NULL;"
+           << endl;
+    doIndent();
+    op->var.accept(this);
+    stream << " = (" << elementType << "*)taco_workspace(&" << pool
+           << ", sizeof(" << elementType << ") * ";
+    parentPrecedence = MUL;
+    op->num_elements.accept(this);
+    parentPrecedence = TOP;
+    stream << ", " << (op->clear ? 1 : 0) << ");" << endl;
+    return;
+  }
+
   doIndent();
   op->var.accept(this);
   stream << " = (";
   stream << elementType << "*";
   stream << ")";
   if (op->is_realloc) {
-    stream << "realloc(";
+    stream << "taco_realloc(";
     op->var.accept(this);
     stream << ", ";
   }
@@ -550,9 +1414,9 @@ void CodeGen_C::visit(const Allocate* op) {
     // If the allocation was requested to clear the allocated memory,
     // use calloc instead of malloc.
     if (op->clear) {
-      stream << "calloc(1, ";
+      stream << "taco_calloc(1, ";
     } else {
-      stream << "malloc(";
+      stream << "taco_malloc(";
     }
   }
   stream << "sizeof(" << elementType << ")";
@@ -564,6 +1428,15 @@ void CodeGen_C::visit(const Allocate* op) {
     stream << endl;
 }
 
+void CodeGen_C::visit(const Free* op) {
+  doIndent();
+  stream << "taco_free(";
+  parentPrecedence = Precedence::TOP;
+  op->var.accept(this);
+  stream << ");";
+  stream << endl;
+}
+
 void CodeGen_C::visit(const Sqrt* op) {
   taco_tassert(op->type.isFloat() && op->type.getNumBits() == 64) <<
       "Codegen doesn't currently support non-double sqrt";
@@ -601,7 +1474,7 @@ void CodeGen_C::generateShim(const Stmt& func, stringstream &ret) {
   if (returnType.second != Datatype()) {
     ret << "(void**)(parameterPack[0]), ";
     ret << "(char*)(parameterPack[1]), ";
-    ret << "(" << returnType.second << "*)(parameterPack[2]), ";
+    ret << "(" << printCType(returnType.second, true) << ")(parameterPack[2]), ";
     ret << "(int32_t*)(parameterPack[3])";
 
     i = 4;
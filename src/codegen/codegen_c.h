@@ -38,6 +38,7 @@ protected:
   void visit(const Min*);
   void visit(const Max*);
   void visit(const Allocate*);
+  void visit(const Free*);
   void visit(const Sqrt*);
   void visit(const Store*);
   void visit(const Assign*);
@@ -53,6 +54,7 @@ protected:
   bool emittingCoroutine;
 
   class FindVars;
+  class VectorLoop;
 
 private:
   virtual std::string restrictKeyword() const { return "restrict"; }
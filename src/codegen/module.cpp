@@ -15,6 +15,7 @@
 #include "codegen/codegen_c.h"
 #include "codegen/codegen_cuda.h"
 #include "taco/cuda.h"
+#include "taco/storage/allocator.h"
 
 using namespace std;
 
@@ -158,11 +159,20 @@ string Module::compile() {
 
   // use dlsym() to open the compiled library
   if (lib_handle) {
+    releaseWorkspaces();
     dlclose(lib_handle);
   }
   lib_handle = dlopen(fullpath.data(), RTLD_NOW | RTLD_LOCAL);
   taco_uassert(lib_handle) << "Failed to load generated code, error is: " << dlerror();
 
+  // Generated C code allocates through the installed allocator, which the
+  // module keeps alive for as long as the code may use it
+  allocator = taco::getAllocator();
+  auto kernelAllocator = (taco_allocator_t*)dlsym(lib_handle, "taco_allocator");
+  if (kernelAllocator) {
+    *kernelAllocator = getKernelAllocator(allocator.get());
+  }
+
   return fullpath;
 }
 
@@ -171,6 +181,27 @@ void Module::setSource(string source) {
   moduleFromUserSource = true;
 }
 
+Module::~Module() {
+  if (lib_handle) {
+    releaseWorkspaces();
+  }
+}
+
+void Module::releaseWorkspaces() {
+  // Generated C code keeps pooled workspaces until they are released
+  typedef void (*fnptr_t)();
+  void* v_func_ptr = dlsym(lib_handle, "taco_release_workspaces");
+  if (v_func_ptr) {
+    fnptr_t func_ptr;
+    *reinterpret_cast<void**>(&func_ptr) = v_func_ptr;
+    func_ptr();
+  }
+}
+
+std::shared_ptr<Allocator> Module::getAllocator() const {
+  return allocator;
+}
+
 string Module::getSource() {
   return source.str();
 }
@@ -201,6 +232,11 @@ int Module::callFuncPackedRaw(std::string name, void** args) {
     case ParallelSchedule::Dynamic:
       omp_set_schedule(omp_sched_dynamic, tacoChunkSize);
       break;
+    case ParallelSchedule::Balanced:
+      // Chunks hold the same number of nonzeros, so every thread computes 
+      // one contiguous block of chunks.
+      omp_set_schedule(omp_sched_static, 0);
+      break;
     default:
       break;
   }
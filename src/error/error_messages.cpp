@@ -31,6 +31,15 @@ const std::string compile_without_expr =
 const std::string compile_tensor_name_collision =
   "Tensor name collision.";
 
+const std::string compile_dictionary_encoded_result =
+  "Tensors with dictionary-encoded values cannot be computed; insert and pack "
+  "their components instead.";
+
+const std::string compile_symmetric_result =
+  "Tensors that store one triangle of a symmetric tensor cannot be computed, "
+  "since kernels would store both triangles; insert and pack their "
+  "components instead.";
+
 const std::string assemble_without_compile =
   "The compile method must be called before assemble.";
 
@@ -9,6 +9,11 @@
 #include "taco/lower/mode_format_dense.h"
 #include "taco/lower/mode_format_compressed.h"
 #include "taco/lower/mode_format_singleton.h"
+#include "taco/lower/mode_format_hashed.h"
+#include "taco/lower/mode_format_bitmap.h"
+#include "taco/lower/mode_format_ell.h"
+#include "taco/lower/mode_format_dia.h"
+#include "taco/lower/mode_format_rle.h"
 
 #include "taco/error.h"
 #include "taco/util/strings.h"
@@ -99,6 +104,57 @@ void Format::setLevelArrayTypes(std::vector<std::vector<Datatype>> levelArrayTyp
   this->levelArrayTypes = levelArrayTypes;
 }
 
+bool Format::isSymmetric() const {
+  return !symmetricModes.empty();
+}
+
+const std::vector<int>& Format::getSymmetricModes() const {
+  return this->symmetricModes;
+}
+
+void Format::setSymmetricModes(std::vector<int> modes) {
+  taco_uassert(modes.empty() || modes.size() == 2) <<
+      "A format can only be symmetric in two modes";
+  for (int mode : modes) {
+    taco_uassert(0 <= mode && mode < getOrder()) <<
+        "Symmetric mode " << mode << " is not a mode of the format " << *this;
+  }
+  taco_uassert(modes.empty() || modes[0] != modes[1]) <<
+      "A format must be symmetric in two distinct modes";
+  this->symmetricModes = modes;
+}
+
+bool Format::isPattern() const {
+  return this->pattern;
+}
+
+void Format::setPattern(bool pattern) {
+  taco_uassert(!pattern || getOrder() > 0) <<
+      "Scalars cannot be pattern tensors";
+  taco_uassert(!pattern || !isDictionaryEncoded()) <<
+      "Pattern tensors have no values to encode";
+  this->pattern = pattern;
+}
+
+bool Format::isDictionaryEncoded() const {
+  return valueCodeType.getKind() != Datatype::Undefined;
+}
+
+Datatype Format::getValueCodeType() const {
+  return this->valueCodeType;
+}
+
+void Format::setValueEncoding(Datatype codeType) {
+  taco_uassert(codeType.getKind() == Datatype::Undefined ||
+               codeType == UInt8 || codeType == UInt16) <<
+      "Dictionary codes must be of type uint8 or uint16";
+  taco_uassert(codeType.getKind() == Datatype::Undefined || getOrder() > 0) <<
+      "The values of scalars cannot be dictionary encoded";
+  taco_uassert(codeType.getKind() == Datatype::Undefined || !isPattern()) <<
+      "Pattern tensors have no values to encode";
+  this->valueCodeType = codeType;
+}
+
 
 bool operator==(const Format& a, const Format& b){
   const auto aModeTypePacks = a.getModeFormatPacks();
@@ -120,7 +176,15 @@ bool operator==(const Format& a, const Format& b){
       return false;
     }
   } 
-  return true;
+  for (size_t i = 0; i < (size_t)a.getOrder(); ++i) {
+    if (a.getCoordinateTypePos(i) != b.getCoordinateTypePos(i) ||
+        a.getCoordinateTypeIdx(i) != b.getCoordinateTypeIdx(i)) {
+      return false;
+    }
+  }
+  return a.getSymmetricModes() == b.getSymmetricModes() &&
+         a.isPattern() == b.isPattern() &&
+         a.getValueCodeType() == b.getValueCodeType();
 }
 
 bool operator!=(const Format& a, const Format& b) {
@@ -129,7 +193,14 @@ bool operator!=(const Format& a, const Format& b) {
 
 std::ostream &operator<<(std::ostream& os, const Format& format) {
   return os << "(" << util::join(format.getModeFormatPacks(), ",") << "; "
-            << util::join(format.getModeOrdering(), ",") << ")";
+            << util::join(format.getModeOrdering(), ",")
+            << (format.isSymmetric()
+                ? "; symmetric " + util::join(format.getSymmetricModes(), ",")
+                : "")
+            << (format.isPattern() ? "; pattern" : "")
+            << (format.isDictionaryEncoded()
+                ? "; dictionary " + util::toString(format.getValueCodeType())
+                : "") << ")";
 }
 
 
@@ -384,26 +455,46 @@ ModeFormat ModeFormat::Dense(std::make_shared<DenseModeFormat>());
 ModeFormat ModeFormat::Compressed(std::make_shared<CompressedModeFormat>());
 ModeFormat ModeFormat::Sparse = ModeFormat::Compressed;
 ModeFormat ModeFormat::Singleton(std::make_shared<SingletonModeFormat>());
+ModeFormat ModeFormat::Hashed(std::make_shared<HashedModeFormat>());
+ModeFormat ModeFormat::Bitmap(std::make_shared<BitmapModeFormat>());
+ModeFormat ModeFormat::Ell(std::make_shared<EllModeFormat>());
+ModeFormat ModeFormat::Dia(std::make_shared<DiaModeFormat>());
+ModeFormat ModeFormat::Rle(std::make_shared<RleModeFormat>());
 
 ModeFormat ModeFormat::dense = ModeFormat::Dense;
 ModeFormat ModeFormat::compressed = ModeFormat::Compressed;
 ModeFormat ModeFormat::sparse = ModeFormat::Compressed;
 ModeFormat ModeFormat::singleton = ModeFormat::Singleton;
+ModeFormat ModeFormat::hashed = ModeFormat::Hashed;
+ModeFormat ModeFormat::bitmap = ModeFormat::Bitmap;
+ModeFormat ModeFormat::ell = ModeFormat::Ell;
+ModeFormat ModeFormat::dia = ModeFormat::Dia;
+ModeFormat ModeFormat::rle = ModeFormat::Rle;
 
 const ModeFormat Dense = ModeFormat::Dense;
 const ModeFormat Compressed = ModeFormat::Compressed;
 const ModeFormat Sparse = ModeFormat::Compressed;
 const ModeFormat Singleton = ModeFormat::Singleton;
+const ModeFormat Hashed = ModeFormat::Hashed;
+const ModeFormat Bitmap = ModeFormat::Bitmap;
+const ModeFormat Ell = ModeFormat::Ell;
+const ModeFormat Dia = ModeFormat::Dia;
+const ModeFormat Rle = ModeFormat::Rle;
 
 const ModeFormat dense = ModeFormat::Dense;
 const ModeFormat compressed = ModeFormat::Compressed;
 const ModeFormat sparse = ModeFormat::Compressed;
 const ModeFormat singleton = ModeFormat::Singleton;
+const ModeFormat hashed = ModeFormat::Hashed;
+const ModeFormat bitmap = ModeFormat::Bitmap;
 
 const Format CSR({Dense, Sparse}, {0,1});
 const Format CSC({Dense, Sparse}, {1,0});
 const Format DCSR({Sparse, Sparse}, {0,1});
 const Format DCSC({Sparse, Sparse}, {1,0});
+const Format ELL({Dense, Ell}, {0,1});
+const Format RLE({Dense, Rle}, {0,1});
+const Format BCSR({Dense, Sparse, Dense, Dense}, {0,1,2,3});
 
 const Format COO(int order, bool isUnique, bool isOrdered, bool isAoS, 
                  const std::vector<int>& modeOrdering) {
@@ -430,6 +521,58 @@ const Format COO(int order, bool isUnique, bool isOrdered, bool isAoS,
          : Format(modeTypes, modeOrdering);
 }
 
+const Format BCSF(int order) {
+  taco_uassert(order > 0);
+  std::vector<ModeFormatPack> modeTypes(order, Sparse);
+  modeTypes.insert(modeTypes.end(), order, Dense);
+  return Format(modeTypes);
+}
+
+const Format DIA(const std::vector<int>& offsets) {
+  ModeFormat dia(std::make_shared<DiaModeFormat>(false, offsets));
+  return Format({Dense, dia}, {0,1});
+}
+
+Datatype narrowestCoordinateType(int dimension) {
+  if (dimension <= (1 << 8)) {
+    return UInt8;
+  } else if (dimension <= (1 << 16)) {
+    return UInt16;
+  }
+  return Int32;
+}
+
+Format narrowCoordinateTypes(const Format& format, 
+                             const std::vector<int>& dimensions) {
+  taco_uassert(dimensions.size() == (size_t)format.getOrder()) <<
+      "The number of dimensions (" << dimensions.size() << ") must match " <<
+      "the format order (" << format.getOrder() << ")";
+
+  std::vector<std::vector<Datatype>> levelArrayTypes;
+  for (int i = 0; i < format.getOrder(); ++i) {
+    ModeFormat modeFormat = format.getModeFormats()[i];
+    Datatype posType = format.getCoordinateTypePos(i);
+    if (modeFormat.getName() == Compressed.getName() || 
+        modeFormat.getName() == Singleton.getName()) {
+      const int dimension = dimensions[format.getModeOrdering()[i]];
+      levelArrayTypes.push_back({posType, narrowestCoordinateType(dimension)});
+    } else if (i < (int)format.getLevelArrayTypes().size()) {
+      levelArrayTypes.push_back(format.getLevelArrayTypes()[i]);
+    } else if (modeFormat.getName() == Dense.getName() ||
+               modeFormat.getName() == Dia.getName()) {
+      levelArrayTypes.push_back({posType});
+    } else if (modeFormat.getName() == Bitmap.getName()) {
+      levelArrayTypes.push_back({posType, UInt64});
+    } else {
+      levelArrayTypes.push_back({posType, Int32});
+    }
+  }
+
+  Format narrowed = format;
+  narrowed.setLevelArrayTypes(levelArrayTypes);
+  return narrowed;
+}
+
 bool isDense(const Format& format) {
   for (ModeFormat modeFormat : format.getModeFormats()) {
     if (modeFormat != Dense) {
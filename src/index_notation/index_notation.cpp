@@ -208,7 +208,8 @@ struct Isomorphic : public IndexNotationVisitorStrict {
 
   bool check(TensorVar a, TensorVar b) {
     if (!util::contains(isoBTensor, a) && !util::contains(isoATensor, b)) {
-      if (a.getType() != b.getType() || a.getFormat() != b.getFormat()) {
+      if (a.getType() != b.getType() || a.getFormat() != b.getFormat() ||
+          a.getWorkspaceStrategy() != b.getWorkspaceStrategy()) {
         return false;
       }
       isoBTensor.insert({a, b});
@@ -410,7 +411,8 @@ struct Isomorphic : public IndexNotationVisitorStrict {
     auto bnode = to<AssignmentNode>(bStmt.ptr);
     if (!check(anode->lhs, bnode->lhs) ||
         !check(anode->rhs, bnode->rhs) ||
-        !check(anode->op, bnode->op)) {
+        !check(anode->op, bnode->op) ||
+        anode->accumulatorType != bnode->accumulatorType) {
       eq = false;
       return;
     }
@@ -869,7 +871,8 @@ struct Equals : public IndexNotationVisitorStrict {
     }
     auto bnode = to<AssignmentNode>(bStmt.ptr);
     if (!equals(anode->lhs, bnode->lhs) || !equals(anode->rhs, bnode->rhs) ||
-        !equals(anode->op, bnode->op)) {
+        !equals(anode->op, bnode->op) ||
+        anode->accumulatorType != bnode->accumulatorType) {
       eq = false;
       return;
     }
@@ -1246,6 +1249,12 @@ Literal::Literal(long long val) : Literal(new LiteralNode(val)) {
 Literal::Literal(int8_t val) : Literal(new LiteralNode(val)) {
 }
 
+Literal::Literal(float16 val) : Literal(new LiteralNode(val)) {
+}
+
+Literal::Literal(bfloat16 val) : Literal(new LiteralNode(val)) {
+}
+
 Literal::Literal(float val) : Literal(new LiteralNode(val)) {
 }
 
@@ -1269,6 +1278,8 @@ Literal Literal::zero(Datatype type) {
     case Datatype::Int16:       return Literal(int16_t(0));
     case Datatype::Int32:       return Literal(int32_t(0));
     case Datatype::Int64:       return Literal(int64_t(0));
+    case Datatype::Float16:     return Literal(float16());
+    case Datatype::BFloat16:    return Literal(bfloat16());
     case Datatype::Float32:     return Literal(float(0.0));
     case Datatype::Float64:     return Literal(double(0.0));
     case Datatype::Complex64:   return Literal(std::complex<float>());
@@ -1294,6 +1305,8 @@ template int Literal::getVal() const;
 template long Literal::getVal() const;
 template long long Literal::getVal() const;
 template int8_t Literal::getVal() const;
+template float16 Literal::getVal() const;
+template bfloat16 Literal::getVal() const;
 template float Literal::getVal() const;
 template double Literal::getVal() const;
 template std::complex<float> Literal::getVal() const;
@@ -1816,8 +1829,9 @@ IndexStmt IndexStmt::concretize() const {
   return stmt;
 }
 
-IndexStmt IndexStmt::split(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFactor) const {
-  IndexVarRel rel = IndexVarRel(new SplitRelNode(i, i1, i2, splitFactor));
+IndexStmt IndexStmt::split(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFactor,
+                           TailStrategy tailStrategy) const {
+  IndexVarRel rel = IndexVarRel(new SplitRelNode(i, i1, i2, splitFactor, tailStrategy));
   string reason;
 
   // Add predicate to concrete index notation
@@ -1835,8 +1849,9 @@ IndexStmt IndexStmt::split(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFac
   return transformed;
 }
 
-IndexStmt IndexStmt::divide(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFactor) const {
-  IndexVarRel rel = IndexVarRel(new DivideRelNode(i, i1, i2, splitFactor));
+IndexStmt IndexStmt::divide(IndexVar i, IndexVar i1, IndexVar i2, size_t splitFactor,
+                            TailStrategy tailStrategy) const {
+  IndexVarRel rel = IndexVarRel(new DivideRelNode(i, i1, i2, splitFactor, tailStrategy));
   string reason;
 
   // Add predicate to concrete index notation.
@@ -2074,6 +2089,21 @@ IndexStmt IndexStmt::wsaccel(TensorVar& ws, bool shouldAccel, const std::vector<
     return *this;
 }
 
+IndexStmt IndexStmt::wsstrategy(TensorVar& ws, WorkspaceStrategy strategy) {
+  bool isTemporary = false;
+  match(*this,
+    std::function<void(const WhereNode*)>([&](const WhereNode* where) {
+      isTemporary |= (Where(where).getTemporary() == ws);
+    })
+  );
+  taco_uassert(isTemporary) << ws.getName() << " is not a workspace of "
+                            << *this;
+  taco_uassert(ws.getOrder() == 1 || strategy == WorkspaceStrategy::Dense)
+      << "Only workspace vectors can accumulate into hash tables and heaps";
+  ws.setWorkspaceStrategy(strategy);
+  return *this;
+}
+
 std::ostream& operator<<(std::ostream& os, const IndexStmt& expr) {
   if (!expr.defined()) return os << "IndexStmt()";
   IndexNotationPrinter printer(os);
@@ -2085,8 +2115,9 @@ std::ostream& operator<<(std::ostream& os, const IndexStmt& expr) {
 Assignment::Assignment(const AssignmentNode* n) : IndexStmt(n) {
 }
 
-Assignment::Assignment(Access lhs, IndexExpr rhs, IndexExpr op)
-    : Assignment(new AssignmentNode(lhs, rhs, op)) {
+Assignment::Assignment(Access lhs, IndexExpr rhs, IndexExpr op,
+                       Datatype accumulatorType)
+    : Assignment(new AssignmentNode(lhs, rhs, op, accumulatorType)) {
 }
 
 Assignment::Assignment(TensorVar tensor, vector<IndexVar> indices,
@@ -2107,6 +2138,10 @@ IndexExpr Assignment::getOperator() const {
   return getNode(*this)->op;
 }
 
+Datatype Assignment::getAccumulatorType() const {
+  return getNode(*this)->accumulatorType;
+}
+
 const std::vector<IndexVar>& Assignment::getFreeVars() const {
   return getLhs().getIndexVars();
 }
@@ -2548,6 +2583,7 @@ struct TensorVar::Content {
   Literal fill;
   std::vector<IndexVar> accelIndexVars;
   bool shouldAccel;
+  WorkspaceStrategy workspaceStrategy;
 };
 
 TensorVar::TensorVar() : content(nullptr) {
@@ -2582,6 +2618,7 @@ TensorVar::TensorVar(const int& id, const string& name, const Type& type, const
   content->fill = fill.defined()? fill : Literal::zero(type.getDataType());
   content->accelIndexVars = std::vector<IndexVar> {};
   content->shouldAccel = true;
+  content->workspaceStrategy = WorkspaceStrategy::Dense;
 }
 
 int TensorVar::getId() const {
@@ -2638,6 +2675,14 @@ void TensorVar::setAccelIndexVars(const std::vector<IndexVar>& accelIndexVars, b
   content->accelIndexVars = accelIndexVars;
 }
 
+WorkspaceStrategy TensorVar::getWorkspaceStrategy() const {
+  return content->workspaceStrategy;
+}
+
+void TensorVar::setWorkspaceStrategy(WorkspaceStrategy strategy) {
+  content->workspaceStrategy = strategy;
+}
+
 void TensorVar::setFill(const Literal &fill) {
   content->fill = fill;
 }
@@ -3074,7 +3119,8 @@ Assignment makeReductionNotation(Assignment assignment) {
   };
   return Assignment(assignment.getLhs(),
                     MakeReductionNotation(free).einsum(expr),
-                    assignment.getOperator());
+                    assignment.getOperator(),
+                    assignment.getAccumulatorType());
 }
 
 IndexStmt makeReductionNotation(IndexStmt stmt) {
@@ -3088,10 +3134,12 @@ struct ReplaceReductionsWithWheres : IndexNotationRewriter {
 
   Reduction reduction;
   TensorVar t;
+  Datatype accumulatorType;
 
   void visit(const AssignmentNode* node) {
     reduction = Reduction();
     t = TensorVar();
+    accumulatorType = node->accumulatorType;
 
     IndexExpr rhs = rewrite(node->rhs);
 
@@ -3102,10 +3150,12 @@ struct ReplaceReductionsWithWheres : IndexNotationRewriter {
     }
 
     taco_iassert(t.defined() && reduction.defined());
-    IndexStmt consumer = Assignment(node->lhs, rhs, node->op);
+    IndexStmt consumer = Assignment(node->lhs, rhs, node->op,
+                                    node->accumulatorType);
     IndexStmt producer = forall(reduction.getVar(),
                                 Assignment(t, reduction.getExpr(),
-                                           reduction.getOp()));
+                                           reduction.getOp(),
+                                           node->accumulatorType));
     stmt = where(rewrite(consumer), rewrite(producer));
   }
 
@@ -3118,7 +3168,8 @@ struct ReplaceReductionsWithWheres : IndexNotationRewriter {
 
     reduction = node;
     t = TensorVar("t" + util::toString(node->var),
-                  node->getDataType());
+                  accumulatorType.getKind() != Datatype::Undefined
+                  ? accumulatorType : node->getDataType());
     expr = t;
   }
 };
@@ -3153,7 +3204,7 @@ IndexStmt makeConcreteNotation(IndexStmt stmt) {
       }
 
       if (rhs != node->rhs) {
-        stmt = Assignment(node->lhs, rhs, reductionOp);
+        stmt = Assignment(node->lhs, rhs, reductionOp, node->accumulatorType);
         for (auto& i : util::reverse(topLevelReductions)) {
           stmt = forall(i, stmt);
         }
@@ -3258,7 +3309,8 @@ Assignment makeReductionNotationScheduled(Assignment assignment, ProvenanceGraph
   };
   return Assignment(assignment.getLhs(),
                     MakeReductionNotation(free, provGraph).einsum(expr),
-                    assignment.getOperator());
+                    assignment.getOperator(),
+                    assignment.getAccumulatorType());
 }
 
 IndexStmt makeReductionNotationScheduled(IndexStmt stmt, ProvenanceGraph provGraph) {
@@ -3296,7 +3348,7 @@ IndexStmt makeConcreteNotationScheduled(IndexStmt stmt, ProvenanceGraph provGrap
       }
 
       if (rhs != node->rhs) {
-        stmt = Assignment(node->lhs, rhs, Add());
+        stmt = Assignment(node->lhs, rhs, Add(), node->accumulatorType);
         if (forallIndexVars.empty()) {
           for (auto &i : util::reverse(topLevelReductions)) {
             stmt = forall(i, stmt);
@@ -4015,7 +4067,7 @@ private:
       stmt = op;
     }
     else {
-      stmt = new AssignmentNode(op->lhs, rhs, op->op);
+      stmt = new AssignmentNode(op->lhs, rhs, op->op, op->accumulatorType);
     }
   }
 
@@ -4255,23 +4307,32 @@ IndexStmt generatePackStmt(TensorVar tensor,
     packStmt = forall(indexVars[mode], packStmt);
   }
 
+  return setPackAssembleStrategy(packStmt, otherIsOnRight ? tensor : other);
+}
+
+IndexStmt setPackAssembleStrategy(IndexStmt packStmt, TensorVar result) {
+  const Format format = result.getFormat();
   bool doAppend = true;
-  const Format lhsFormat = otherIsOnRight ? format : otherFormat;
-  for (int i = lhsFormat.getOrder() - 1; i >= 0; --i) {
-    const auto modeFormat = lhsFormat.getModeFormats()[i];
-    if (modeFormat.isBranchless() && i != 0) {
-      const auto parentModeFormat = lhsFormat.getModeFormats()[i - 1];
+  bool hasUnassemblableLevel = false;
+  for (int i = format.getOrder() - 1; i >= 0; --i) {
+    const auto modeFormat = format.getModeFormats()[i];
+    if (!modeFormat.hasAppend() && !modeFormat.hasInsert()) {
+      hasUnassemblableLevel = true;
+      doAppend = false;
+    } else if (modeFormat.isBranchless() && i != 0) {
+      const auto parentModeFormat = format.getModeFormats()[i - 1];
       if (parentModeFormat.isUnique() || !parentModeFormat.hasAppend()) {
         doAppend = false;
-        break;
       }
     }
   }
-  if (!doAppend) {
-    packStmt = packStmt.assemble(otherIsOnRight ? tensor : other, AssembleStrategy::Insert);
+  if (doAppend) {
+    return packStmt;
   }
-
-  return packStmt; 
+  // Levels that support neither append nor insert (e.g. ELL) compute their 
+  // attribute queries over fresh index variables
+  return packStmt.assemble(result, AssembleStrategy::Insert, 
+                           hasUnassemblableLevel);
 }
 
 IndexStmt generatePackCOOStmt(TensorVar tensor, 
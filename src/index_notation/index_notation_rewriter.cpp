@@ -166,7 +166,7 @@ void IndexNotationRewriter::visit(const AssignmentNode* op) {
     stmt = op;
   }
   else {
-    stmt = new AssignmentNode(op->lhs, rhs, op->op);
+    stmt = new AssignmentNode(op->lhs, rhs, op->op, op->accumulatorType);
   }
 }
 
@@ -394,7 +394,7 @@ struct ReplaceIndexVars : public IndexNotationRewriter {
       stmt = op;
     }
     else {
-      stmt = new AssignmentNode(lhs, rhs, op->op);
+      stmt = new AssignmentNode(lhs, rhs, op->op, op->accumulatorType);
     }
   }
 
@@ -438,9 +438,8 @@ struct ReplaceTensorVars : public IndexNotationRewriter {
   void visit(const AssignmentNode* node) {
     TensorVar var = node->lhs.getTensorVar();
     if (util::contains(substitutions, var)) {
-      stmt = Assignment(substitutions.at(var),
-                        node->lhs.getIndexVars(), rewrite(node->rhs),
-                        node->op);
+      stmt = Assignment(Access(substitutions.at(var), node->lhs.getIndexVars()),
+                        rewrite(node->rhs), node->op, node->accumulatorType);
     }
     else {
       IndexNotationRewriter::visit(node);
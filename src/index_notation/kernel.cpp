@@ -8,6 +8,7 @@
 #include "taco/storage/storage.h"
 #include "taco/storage/index.h"
 #include "taco/storage/array.h"
+#include "taco/storage/allocator.h"
 #include "taco/taco_tensor_t.h"
 #include <taco/index_notation/transformations.h>
 #include "taco/index_notation/index_notation_nodes.h"
@@ -49,7 +50,8 @@ vector<void*> packArguments(const vector<TensorStorage>& args) {
 
 static inline
 void unpackResults(size_t numResults, const vector<void*> arguments,
-                   const vector<TensorStorage>& args) {
+                   const vector<TensorStorage>& args,
+                   shared_ptr<Allocator> allocator) {
   for (size_t i = 0; i < numResults; i++) {
     taco_tensor_t* tensorData = ((taco_tensor_t*)arguments[i]);
     TensorStorage storage = args[i];
@@ -64,38 +66,91 @@ void unpackResults(size_t numResults, const vector<void*> arguments,
         modeIndices.push_back(ModeIndex({size}));
         num *= ((int*)tensorData->indices[i][0])[0];
       } else if (modeType.getName() == Sparse.getName()) {
-        auto size = ((int*)tensorData->indices[i][0])[num];
-        Array pos = Array(type<int>(), tensorData->indices[i][0],
-                          num+1, Array::UserOwns);
-        Array idx = Array(type<int>(), tensorData->indices[i][1],
-                          size, Array::UserOwns);
+        Array pos = Array(format.getCoordinateTypePos(i), 
+                          tensorData->indices[i][0], num+1, Array::UserOwns);
+        auto size = pos.get(num).getAsIndex();
+        Array idx = Array(format.getCoordinateTypeIdx(i), 
+                          tensorData->indices[i][1], size, Array::UserOwns);
         modeIndices.push_back(ModeIndex({pos, idx}));
         num = size;
+      } else if (modeType.getName() == Hashed.getName()) {
+        Array pos = Array(type<int>(), tensorData->indices[i][0], num+1, 
+                          Array::UserOwns);
+        auto size = pos.get(num).getAsIndex();
+        Array idx = Array(format.getCoordinateTypeIdx(i), 
+                          tensorData->indices[i][1], size, Array::UserOwns);
+        modeIndices.push_back(ModeIndex({pos, idx}));
+        num = size;
+      } else if (modeType.getName() == Bitmap.getName()) {
+        const int size = tensorData->dimensions[tensorData->mode_ordering[i]];
+        const size_t numWords = num * ((size + 63) / 64);
+        Array bits = Array(format.getCoordinateTypeIdx(i), 
+                           tensorData->indices[i][1], numWords, 
+                           Array::UserOwns);
+        modeIndices.push_back(ModeIndex({makeArray({size}), bits}));
+        num *= size;
+      } else if (modeType.getName() == Ell.getName()) {
+        const int* sliceData = (int*)tensorData->indices[i][0];
+        const size_t sliceHeight = sliceData[0];
+        const size_t numSlices = (sliceHeight == 0) ? 0 :
+                                 (num + sliceHeight - 1) / sliceHeight;
+        const size_t size = (sliceHeight == 0) ? num * sliceData[1] :
+                            sliceData[numSlices + 1];
+        Array slices = Array(type<int>(), tensorData->indices[i][0], 
+                             numSlices + 2, Array::UserOwns);
+        Array idx = Array(format.getCoordinateTypeIdx(i), 
+                          tensorData->indices[i][1], size, Array::UserOwns);
+        modeIndices.push_back(ModeIndex({slices, idx}));
+        num = size;
+      } else if (modeType.getName() == Dia.getName()) {
+        const int numDiagonals = ((int*)tensorData->indices[i][0])[0];
+        Array offsets = Array(type<int>(), tensorData->indices[i][0], 
+                              numDiagonals + 1, Array::UserOwns);
+        modeIndices.push_back(ModeIndex({offsets}));
+        num *= numDiagonals + 1;
+      } else if (modeType.getName() == Rle.getName()) {
+        Array pos = Array(format.getCoordinateTypePos(i), 
+                          tensorData->indices[i][0], num+1, Array::UserOwns);
+        const size_t numRuns = pos.get(num).getAsIndex();
+        Array run = Array(format.getCoordinateTypeIdx(i), 
+                          tensorData->indices[i][1], 2*numRuns+3, 
+                          Array::UserOwns);
+        modeIndices.push_back(ModeIndex({pos, run}));
+        num = run.get(2*numRuns+2).getAsIndex();
       } else {
         taco_not_supported_yet;
       }
     }
     storage.setIndex(Index(format, modeIndices));
-    storage.setValues(Array(storage.getComponentType(), tensorData->vals, num));
+    storage.setValues(Array(storage.getComponentType(), tensorData->vals, num,
+                            allocator));
   }
 }
 
 bool Kernel::operator()(const vector<TensorStorage>& args) const {
   vector<void*> arguments = packArguments(args);
+  checkValuesAlignment(arguments,
+                       content->module->getAllocator()->getAlignment());
   int result = content->module->callFuncPacked("evaluate", arguments.data());
-  unpackResults(this->numResults, arguments, args);
+  unpackResults(this->numResults, arguments, args,
+                content->module->getAllocator());
   return (result == 0);
 }
 
 bool Kernel::assemble(const vector<TensorStorage>& args) const {
   vector<void*> arguments = packArguments(args);
+  checkValuesAlignment(arguments,
+                       content->module->getAllocator()->getAlignment());
   int result = content->module->callFuncPacked("assemble", arguments.data());
-  unpackResults(this->numResults, arguments, args);
+  unpackResults(this->numResults, arguments, args,
+                content->module->getAllocator());
   return (result == 0);
 }
 
 bool Kernel::compute(const vector<TensorStorage>& args) const {
   vector<void*> arguments = packArguments(args);
+  checkValuesAlignment(arguments,
+                       content->module->getAllocator()->getAlignment());
   int result = content->module->callFuncPacked("compute", arguments.data());
   return (result == 0);
 }
@@ -120,14 +120,17 @@ struct SplitRelNode::Content {
   IndexVar outerVar;
   IndexVar innerVar;
   size_t splitFactor;
+  TailStrategy tailStrategy;
 };
 
-SplitRelNode::SplitRelNode(IndexVar parentVar, IndexVar outerVar, IndexVar innerVar, size_t splitFactor)
+SplitRelNode::SplitRelNode(IndexVar parentVar, IndexVar outerVar, IndexVar innerVar, size_t splitFactor,
+                           TailStrategy tailStrategy)
   : IndexVarRelNode(SPLIT), content(new Content) {
   content->parentVar = parentVar;
   content->outerVar = outerVar;
   content->innerVar = innerVar;
   content->splitFactor = splitFactor;
+  content->tailStrategy = tailStrategy;
 }
 
 const IndexVar& SplitRelNode::getParentVar() const {
@@ -142,14 +145,22 @@ const IndexVar& SplitRelNode::getInnerVar() const {
 const size_t& SplitRelNode::getSplitFactor() const {
   return content->splitFactor;
 }
+TailStrategy SplitRelNode::getTailStrategy() const {
+  return content->tailStrategy;
+}
 
 void SplitRelNode::print(std::ostream &stream) const {
-  stream << "split(" << getParentVar() << ", " << getOuterVar() << ", " << getInnerVar() << ", " << getSplitFactor() << ")";
+  stream << "split(" << getParentVar() << ", " << getOuterVar() << ", " << getInnerVar() << ", " << getSplitFactor();
+  if (getTailStrategy() != TailStrategy::GuardWithIf) {
+    stream << ", " << TailStrategy_NAMES[(int)getTailStrategy()];
+  }
+  stream << ")";
 }
 
 bool SplitRelNode::equals(const SplitRelNode &rel) const {
   return getParentVar() == rel.getParentVar() && getOuterVar() == rel.getOuterVar()
-        && getInnerVar() == rel.getInnerVar() && getSplitFactor() == rel.getSplitFactor();
+        && getInnerVar() == rel.getInnerVar() && getSplitFactor() == rel.getSplitFactor()
+        && getTailStrategy() == rel.getTailStrategy();
 }
 
 std::vector<IndexVar> SplitRelNode::getParents() const {
@@ -271,14 +282,17 @@ struct DivideRelNode::Content {
   IndexVar outerVar;
   IndexVar innerVar;
   size_t divFactor;
+  TailStrategy tailStrategy;
 };
 
-DivideRelNode::DivideRelNode(IndexVar parentVar, IndexVar outerVar, IndexVar innerVar, size_t divFactor)
+DivideRelNode::DivideRelNode(IndexVar parentVar, IndexVar outerVar, IndexVar innerVar, size_t divFactor,
+                             TailStrategy tailStrategy)
   : IndexVarRelNode(DIVIDE), content(new Content) {
   content->parentVar = parentVar;
   content->outerVar = outerVar;
   content->innerVar = innerVar;
   content->divFactor = divFactor;
+  content->tailStrategy = tailStrategy;
 }
 
 const IndexVar& DivideRelNode::getParentVar() const {
@@ -293,14 +307,22 @@ const IndexVar& DivideRelNode::getInnerVar() const {
 const size_t& DivideRelNode::getDivFactor() const {
   return content->divFactor;
 }
+TailStrategy DivideRelNode::getTailStrategy() const {
+  return content->tailStrategy;
+}
 
 void DivideRelNode::print(std::ostream &stream) const {
-  stream << "divide(" << getParentVar() << ", " << getOuterVar() << ", " << getInnerVar() << ", " << getDivFactor() << ")";
+  stream << "divide(" << getParentVar() << ", " << getOuterVar() << ", " << getInnerVar() << ", " << getDivFactor();
+  if (getTailStrategy() != TailStrategy::GuardWithIf) {
+    stream << ", " << TailStrategy_NAMES[(int)getTailStrategy()];
+  }
+  stream << ")";
 }
 
 bool DivideRelNode::equals(const DivideRelNode &rel) const {
   return getParentVar() == rel.getParentVar() && getOuterVar() == rel.getOuterVar() &&
-    getInnerVar() == rel.getInnerVar() && getDivFactor() == rel.getDivFactor();
+    getInnerVar() == rel.getInnerVar() && getDivFactor() == rel.getDivFactor() &&
+    getTailStrategy() == rel.getTailStrategy();
 }
 
 std::vector<IndexVar> DivideRelNode::getParents() const {
@@ -573,14 +595,11 @@ ir::Expr PosRelNode::recoverVariable(taco::IndexVar indexVar,
   taco_iassert(variableNames.count(getParentVar()) == 1 && variableNames.count(getPosVar()) == 1);
   taco_iassert(parentCoordBounds.count(getParentVar()) == 1);
 
-  ir::Expr coord_array = getAccessCoordArray(iterators, provGraph);
-
   Iterator accessIterator = getAccessIterator(iterators, provGraph);
-  ir::Expr parentPos = accessIterator.getParent().getPosVar();
-  ModeFunction segment_bounds = accessIterator.posBounds(parentPos);
 
   // positions should be with respect to entire array not just segment so don't need to offset variable when projecting.
-  ir::Expr project_result = ir::Load::make(coord_array, variableNames.at(getPosVar()));
+  // levels that do not store a coordinate per position (e.g. run-length levels) decode the coordinate.
+  ir::Expr project_result = accessIterator.posAccess(variableNames.at(getPosVar()), {})[0];
 
   // but need to subtract parentvars start corodbound
   ir::Expr parent_value = ir::Sub::make(project_result, parentCoordBounds[getParentVar()][0]);
@@ -1419,4 +1438,20 @@ bool ProvenanceGraph::isDivided(IndexVar indexVar) const {
   return false;
 }
 
+TailStrategy ProvenanceGraph::getTailStrategy(IndexVar indexVar) const {
+  if (!parentRelMap.count(indexVar)) {
+    return TailStrategy::GuardWithIf;
+  }
+  const IndexVarRel& rel = parentRelMap.at(indexVar);
+  if (rel.getRelType() == SPLIT &&
+      rel.getNode<SplitRelNode>()->getInnerVar() == indexVar) {
+    return rel.getNode<SplitRelNode>()->getTailStrategy();
+  }
+  if (rel.getRelType() == DIVIDE &&
+      rel.getNode<DivideRelNode>()->getInnerVar() == indexVar) {
+    return rel.getNode<DivideRelNode>()->getTailStrategy();
+  }
+  return TailStrategy::GuardWithIf;
+}
+
 }
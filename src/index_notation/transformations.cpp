@@ -5,10 +5,12 @@
 #include "taco/index_notation/index_notation_nodes.h"
 #include "taco/error/error_messages.h"
 #include "taco/util/collections.h"
+#include "taco/util/strings.h"
 #include "taco/lower/iterator.h"
 #include "taco/lower/merge_lattice.h"
 #include "taco/lower/mode.h"
 #include "taco/lower/mode_format_impl.h"
+#include "taco/tensor.h"
 
 #include <iostream>
 #include <algorithm>
@@ -153,6 +155,31 @@ MergeStrategy SetMergeStrategy::getMergeStrategy() const {
   return content->strategy;
 }
 
+/// Returns why the iterators merged by the loop over `i` cannot be partitioned
+/// by merge path, or an empty string if they can.  Merge path partitioning
+/// binary searches the coordinates of every merged iterator, so every merged
+/// iterator must iterate over the positions of an ordered level without
+/// duplicates and with 32-bit coordinates.
+static string checkMergePathIterators(IndexVar i, MergeLattice lattice) {
+  for (auto iterator : lattice.iterators()) {
+    if (!iterator.hasPosIter() || !iterator.isOrdered() ||
+        !iterator.isUnique() || iterator.isWindowed() ||
+        iterator.hasIndexSet() ||
+        !(iterator.getParent().isRoot() || iterator.getParent().isUnique())) {
+      return "Precondition failed: Variable " + i.getName() + " merges " +
+             util::toString(iterator.getTensor()) + ", which is not an " +
+             "ordered level without duplicates and cannot be merged by merge "
+             "path";
+    }
+    if (iterator.getMode().getModePack().getArray(1).type() != Int32) {
+      return "Precondition failed: Variable " + i.getName() + " merges " +
+             util::toString(iterator.getTensor()) + ", whose coordinates are "
+             "not 32-bit integers and cannot be merged by merge path";
+    }
+  }
+  return "";
+}
+
 IndexStmt SetMergeStrategy::apply(IndexStmt stmt, string* reason) const {
   INIT_REASON(reason);
 
@@ -190,6 +217,20 @@ IndexStmt SetMergeStrategy::apply(IndexStmt stmt, string* reason) const {
         Iterators iterators(foralli, tensorVars);
         MergeLattice lattice = MergeLattice::make(foralli, iterators, provGraph, 
                                                   definedIndexVars);
+        MergeStrategy strategy = transformation.getMergeStrategy();
+        if (strategy == MergeStrategy::MergePath) {
+          if (lattice.iterators().size() > 1) {
+            reason = checkMergePathIterators(i, lattice);
+          }
+          if (!reason.empty()) {
+            return;
+          }
+          stmt = Forall(node->indexVar, rewrite(foralli.getStmt()), strategy,
+                        node->parallel_unit, node->output_race_strategy,
+                        node->unrollFactor);
+          return;
+        }
+
         for (auto iterator : lattice.iterators()) {
           if (!iterator.isOrdered()) {
             reason = "Precondition failed: Variable " 
@@ -205,7 +246,6 @@ IndexStmt SetMergeStrategy::apply(IndexStmt stmt, string* reason) const {
           return;
         }
 
-        MergeStrategy strategy = transformation.getMergeStrategy();
         stmt = rewrite(foralli.getStmt());
         stmt = Forall(node->indexVar, stmt, strategy, node->parallel_unit, 
                       node->output_race_strategy, node->unrollFactor);
@@ -379,7 +419,7 @@ static IndexStmt eliminateRedundantReductions(IndexStmt stmt,
       if (op->op.defined() && 
           util::toSet(op->lhs.getIndexVars()) == availableVars[result] &&
           (!candidates || util::contains(*candidates, result))) {
-        stmt = Assignment(op->lhs, op->rhs);
+        stmt = Assignment(op->lhs, op->rhs, IndexExpr(), op->accumulatorType);
         return;
       }
       stmt = op;
@@ -858,7 +898,8 @@ struct ReplaceReductionExpr : public IndexNotationRewriter {
   using IndexNotationRewriter::visit;
   void visit(const AssignmentNode* node) {
     if (util::contains(substitutions, node->lhs)) {
-      stmt = Assignment(substitutions.at(node->lhs), rewrite(node->rhs), node->op);
+      stmt = Assignment(substitutions.at(node->lhs), rewrite(node->rhs),
+                        node->op, node->accumulatorType);
     }
     else {
       IndexNotationRewriter::visit(node);
@@ -915,10 +956,12 @@ IndexStmt Parallelize::apply(IndexStmt stmt, std::string* reason) const {
     set<IndexVar> definedIndexVars;
     set<IndexVar> reductionIndexVars;
     set<ParallelUnit> parentParallelUnits;
+    vector<TensorVar> temporaries;
     std::string reason = "";
 
     IndexStmt rewriteParallel(IndexStmt stmt) {
       provGraph = ProvenanceGraph(stmt);
+      temporaries = getTemporaries(stmt);
 
       const auto reductionVars = getReductionVars(stmt);
 
@@ -961,11 +1004,31 @@ IndexStmt Parallelize::apply(IndexStmt stmt, std::string* reason) const {
                                                   definedIndexVars);
 
         // Precondition 2: No coiteration of modes (i.e., merge lattice has 
-        //                 only one iterator)
+        //                 only one iterator), unless the loop is merged by 
+        //                 merge path and parallelized over CPU threads
         if (lattice.iterators().size() != 1) {
-          reason = "Precondition failed: The loop must not merge tensor "
-                   "dimensions, that is, it must be a for loop;";
-          return;
+          if (foralli.getMergeStrategy() != MergeStrategy::MergePath ||
+              parallelize.getParallelUnit() != ParallelUnit::CPUThread) {
+            reason = "Precondition failed: The loop must not merge tensor "
+                     "dimensions, that is, it must be a for loop, unless it "
+                     "is merged by merge path and parallelized over CPU "
+                     "threads;";
+            return;
+          }
+          if (!provGraph.isUnderived(i) ||
+              parallelize.getOutputRaceStrategy() == 
+                  OutputRaceStrategy::Temporary ||
+              parallelize.getOutputRaceStrategy() == 
+                  OutputRaceStrategy::ParallelReduction) {
+            reason = "Precondition failed: Loops merged by merge path must "
+                     "be over underived variables and cannot use temporaries "
+                     "or parallel reductions to resolve output races;";
+            return;
+          }
+          reason = checkMergePathIterators(i, lattice);
+          if (!reason.empty()) {
+            return;
+          }
         }
 
         vector<IndexVar> underivedAncestors = provGraph.getUnderivedAncestors(i);
@@ -1013,28 +1076,70 @@ IndexStmt Parallelize::apply(IndexStmt stmt, std::string* reason) const {
           }
         }
 
-        if (parallelize.getOutputRaceStrategy() == OutputRaceStrategy::Temporary &&
-            util::contains(reductionIndexVars, underivedForall.getIndexVar())) {
-          // Need to precompute reduction
-
-          // Find all occurrences of reduction in expression
-          vector<const AssignmentNode *> precomputeAssignments;
+        // CPU threads resolve output races of temporaries and parallel 
+        // reductions by accumulating into private copies of the results, 
+        // which are reduced after the loop (see 
+        // LowererImplImperative::codeToPrivatizeResults)
+        OutputRaceStrategy raceStrategy = parallelize.getOutputRaceStrategy();
+        const bool privatize = !should_use_CUDA_codegen() &&
+            parallelize.getParallelUnit() == ParallelUnit::CPUThread &&
+            (raceStrategy == OutputRaceStrategy::Temporary ||
+             raceStrategy == OutputRaceStrategy::ParallelReduction);
+        set<TensorVar> localTemporaries;
+        if (privatize) {
+          raceStrategy = OutputRaceStrategy::Temporary;
           match(foralli.getStmt(),
-                function<void(const AssignmentNode*)>([&](const AssignmentNode* node) {
-                  for (auto underivedVar : underivedAncestors) {
-                    vector<IndexVar> reductionVars = Assignment(node).getReductionVars();
-                    bool reducedByI =
-                            find(reductionVars.begin(), reductionVars.end(), underivedVar) != reductionVars.end();
-                    if (reducedByI) {
-                      precomputeAssignments.push_back(node);
-                      break;
-                    }
-                  }
+                function<void(const WhereNode*)>([&](const WhereNode* node) {
+                  localTemporaries.insert(Where(node).getTemporary());
                 })
           );
-          taco_iassert(!precomputeAssignments.empty());
+        }
+
+        // Find all occurrences of reduction in expression
+        vector<const AssignmentNode *> precomputeAssignments;
+        match(foralli.getStmt(),
+              function<void(const AssignmentNode*)>([&](const AssignmentNode* node) {
+                if (util::contains(localTemporaries, 
+                                   node->lhs.getTensorVar())) {
+                  return;
+                }
+                for (auto underivedVar : underivedAncestors) {
+                  vector<IndexVar> reductionVars = Assignment(node).getReductionVars();
+                  bool reducedByI =
+                          find(reductionVars.begin(), reductionVars.end(), underivedVar) != reductionVars.end();
+                  if (reducedByI) {
+                    precomputeAssignments.push_back(node);
+                    break;
+                  }
+                }
+              })
+        );
 
-          IndexStmt precomputed_stmt = forall(i, foralli.getStmt(), foralli.getMergeStrategy(), parallelize.getParallelUnit(), parallelize.getOutputRaceStrategy(), foralli.getUnrollFactor());
+        if (privatize) {
+          for (auto assignment : precomputeAssignments) {
+            const TensorVar result = assignment->lhs.getTensorVar();
+            if (!isDense(result.getFormat()) || 
+                !assignment->op.defined() || 
+                !isa<taco::Add>(assignment->op)) {
+              reason = "Precondition failed: Threads can only accumulate "
+                       "additions into private copies of dense results";
+              return;
+            }
+            if (util::contains(temporaries, result)) {
+              reason = "Precondition failed: Threads cannot accumulate into "
+                       "private copies of workspaces that are shared by "
+                       "the iterations of the loop";
+              return;
+            }
+          }
+          precomputeAssignments.clear();
+        }
+
+        if (raceStrategy == OutputRaceStrategy::Temporary &&
+            util::contains(reductionIndexVars, underivedForall.getIndexVar()) &&
+            !precomputeAssignments.empty()) {
+          // Need to precompute reduction
+          IndexStmt precomputed_stmt = forall(i, foralli.getStmt(), foralli.getMergeStrategy(), parallelize.getParallelUnit(), raceStrategy, foralli.getUnrollFactor());
           for (auto assignment : precomputeAssignments) {
             // Construct temporary of correct type and size of outer loop
             TensorVar w(string("w_") + ParallelUnit_NAMES[(int) parallelize.getParallelUnit()], Type(assignment->lhs.getDataType(), {Dimension(i)}), taco::dense);
@@ -1043,7 +1148,7 @@ IndexStmt Parallelize::apply(IndexStmt stmt, std::string* reason) const {
             IndexStmt producer = ReplaceReductionExpr(map<Access, Access>({{assignment->lhs, w(i)}})).rewrite(precomputed_stmt);
             taco_iassert(isa<Forall>(producer));
             Forall producer_forall = to<Forall>(producer);
-            producer = forall(producer_forall.getIndexVar(), producer_forall.getStmt(), foralli.getMergeStrategy(), parallelize.getParallelUnit(), parallelize.getOutputRaceStrategy(), foralli.getUnrollFactor());
+            producer = forall(producer_forall.getIndexVar(), producer_forall.getStmt(), foralli.getMergeStrategy(), parallelize.getParallelUnit(), raceStrategy, foralli.getUnrollFactor());
 
             // build consumer that writes from temporary to output, mark consumer as parallel reduction
             ParallelUnit reductionUnit = ParallelUnit::CPUThreadGroupReduction;
@@ -1074,7 +1179,7 @@ IndexStmt Parallelize::apply(IndexStmt stmt, std::string* reason) const {
         }
 
 
-        stmt = forall(i, foralli.getStmt(), foralli.getMergeStrategy(), parallelize.getParallelUnit(), parallelize.getOutputRaceStrategy(), foralli.getUnrollFactor());
+        stmt = forall(i, foralli.getStmt(), foralli.getMergeStrategy(), parallelize.getParallelUnit(), raceStrategy, foralli.getUnrollFactor());
         return;
       }
 
@@ -1225,6 +1330,7 @@ IndexStmt SetAssembleStrategy::apply(IndexStmt stmt, string* reason) const {
         tempReplacements[tmp] = TensorVar("q" + tmp.getName(), 
                                           Type(Bool, tmp.getType().getShape()), 
                                           tmp.getFormat());
+        tempReplacements[tmp].setWorkspaceStrategy(tmp.getWorkspaceStrategy());
       }
 
       queryResults = Assemble::AttrQueryResults();
@@ -1275,7 +1381,15 @@ IndexStmt SetAssembleStrategy::apply(IndexStmt stmt, string* reason) const {
         return;
       }
 
-      if (op->op.defined()) {
+      // Results can only be scattered into if the positions of their 
+      // coordinates do not depend on how often they are inserted (e.g., if 
+      // they are located in hash tables), since the attribute queries of 
+      // scattered results count every contribution to a coordinate
+      if (op->op.defined() && 
+          !util::all(resultTensor.getFormat().getModeFormats(),
+                     [](ModeFormat modeFormat) { 
+                       return modeFormat.isYieldPosPure(); 
+                     })) {
         reason = "Precondition failed: Ungrouped insertion not support for "
                  "output tensors that are scattered into";
         return;
@@ -1319,6 +1433,20 @@ IndexStmt SetAssembleStrategy::apply(IndexStmt stmt, string* reason) const {
             switch (attr.aggr) {
               case AttrQuery::COUNT:
               {
+                // Counting contributions rather than distinct coordinates 
+                // overestimates the counts but avoids a temporary that holds
+                // every coordinate of the result
+                if (op->op.defined()) {
+                  const auto resultName = modeName + "_" + attr.label;
+                  TensorVar queryResult(resultName, Type(Int32, queryDims));
+                  stmt = Assignment(queryResult(groupBy), Cast(rhs, Int()), 
+                                    Add());
+                  insertedResults.insert(queryResult);
+
+                  queryResults[resultTensor][i] = {queryResult};
+                  return;
+                }
+
                 std::vector<IndexVar> dedupCoords = groupBy;
                 dedupCoords.insert(dedupCoords.end(), attr.params.begin(),
                                    attr.params.end());
@@ -1367,6 +1495,11 @@ IndexStmt SetAssembleStrategy::apply(IndexStmt stmt, string* reason) const {
       expr = op;
     }
 
+    // Scaling by a constant does not change which components are nonzero
+    void visit(const LiteralNode* op) {
+      expr = Literal(true);
+    }
+
     void visit(const CallNode* op) {
       std::vector<IndexExpr> args;
       bool rewritten = false;
@@ -1559,7 +1692,146 @@ std::ostream& operator<<(std::ostream& os,
 
 // Autoscheduling functions
 
-IndexStmt parallelizeOuterLoop(IndexStmt stmt) {
+/// Returns true if `stmt` reads a tensor that stores one triangle of a
+/// symmetric tensor. Kernels that read such tensors update two result
+/// components per stored component, which the automatic promotion,
+/// workspace, and parallelization transformations do not account for.
+static bool readsSymmetricTensor(IndexStmt stmt) {
+  bool readsSymmetric = false;
+  match(stmt,
+    function<void(const AssignmentNode*)>([&](const AssignmentNode* op) {
+      match(op->rhs,
+        function<void(const AccessNode*)>([&](const AccessNode* access) {
+          readsSymmetric |= access->tensorVar.getFormat().isSymmetric();
+        })
+      );
+    })
+  );
+  return readsSymmetric;
+}
+
+/// The number of nonzeros per chunk of the balanced parallel schedule if no
+/// chunk size is set.
+static const size_t DEFAULT_NONZEROS_PER_CHUNK = 2048;
+
+IndexStmt parallelizeOuterLoopsByNonzeros(IndexStmt stmt, size_t chunkSize) {
+  taco_iassert(chunkSize > 0);
+
+  // get the two outer foralls, which must be perfectly nested
+  Forall outer;
+  match(stmt,
+        function<void(const ForallNode*,Matcher*)>([&outer](
+                const ForallNode* node, Matcher* ctx) {
+          if (!outer.defined()) outer = node;
+        })
+  );
+  if (!outer.defined() || !isa<Forall>(outer.getStmt())) {
+    return IndexStmt();
+  }
+  Forall inner = to<Forall>(outer.getStmt());
+  IndexVar i = outer.getIndexVar();
+  IndexVar j = inner.getIndexVar();
+  ProvenanceGraph provGraph(stmt);
+  if (!provGraph.isUnderived(i) || !provGraph.isUnderived(j)) {
+    return IndexStmt();
+  }
+
+  // find an operand whose first level is dense and indexed by i and whose 
+  // second level is sparse and indexed by j
+  const vector<Access> arguments = getArgumentAccesses(stmt);
+  auto rowMajor = std::find_if(arguments.begin(), arguments.end(), 
+                               [&](const Access& argument) {
+    const Format format = argument.getTensorVar().getFormat();
+    const vector<IndexVar>& indexVars = argument.getIndexVars();
+    if (format.getOrder() < 2 || indexVars.size() != (size_t)format.getOrder()) {
+      return false;
+    }
+    const vector<int>& modeOrdering = format.getModeOrdering();
+    const vector<ModeFormat> modeFormats = format.getModeFormats();
+    return indexVars[modeOrdering[0]] == i && indexVars[modeOrdering[1]] == j &&
+           modeFormats[0] == Dense && modeFormats[1].hasCoordPosIter() &&
+           modeFormats[1].isOrdered() && modeFormats[1].isCompact() &&
+           !modeFormats[1].isPadded();
+  });
+  if (rowMajor == arguments.end()) {
+    return IndexStmt();
+  }
+
+  // the other operands are located from the recovered coordinates, which the
+  // lowerer only supports for operands that are not indexed by i
+  for (const Access& argument : arguments) {
+    if (&argument != &*rowMajor &&
+        util::contains(argument.getIndexVars(), i)) {
+      return IndexStmt();
+    }
+  }
+
+  IndexVar f, fpos, chunk, chunkPos;
+  IndexStmt balanced = stmt.fuse(i, j, f)
+                           .pos(f, fpos, *rowMajor)
+                           .split(fpos, chunk, chunkPos, chunkSize);
+
+  // rows, and thus their reductions, may be split across chunks
+  const auto reductionVars = getReductionVars(stmt);
+  OutputRaceStrategy raceStrategy = util::contains(reductionVars, j)
+                                    ? OutputRaceStrategy::Atomics 
+                                    : OutputRaceStrategy::NoRaces;
+  string reason;
+  return Parallelize(chunk, ParallelUnit::CPUThread, 
+                     raceStrategy).apply(balanced, &reason);
+}
+
+IndexStmt parallelizeAssembly(IndexStmt stmt) {
+  const vector<TensorVar> results = getResults(stmt);
+  if (results.size() != 1) {
+    return IndexStmt();
+  }
+
+  string reason;
+  IndexStmt assembled = SetAssembleStrategy(results[0], 
+                                            AssembleStrategy::Insert, 
+                                            true).apply(stmt, &reason);
+  if (!assembled.defined() || !isa<Assemble>(assembled)) {
+    return IndexStmt();
+  }
+
+  // the attribute queries use their own index variables, so their outer loop 
+  // is parallelized separately from the outer loop of the computation
+  IndexStmt queries = to<Assemble>(assembled).getQueries();
+  if (isa<Where>(queries)) {
+    queries = to<Where>(queries).getConsumer();
+  }
+  if (!isa<Forall>(queries)) {
+    return IndexStmt();
+  }
+  IndexVar queryVar = to<Forall>(queries).getIndexVar();
+  Forall forall;
+  match(to<Assemble>(assembled).getCompute(),
+        function<void(const ForallNode*,Matcher*)>([&forall](
+                const ForallNode* node, Matcher* ctx) {
+          if (!forall.defined()) forall = node;
+        })
+  );
+  if (!forall.defined()) {
+    return IndexStmt();
+  }
+
+  for (IndexVar var : {queryVar, forall.getIndexVar()}) {
+    assembled = Parallelize(var, ParallelUnit::CPUThread, 
+                            OutputRaceStrategy::NoRaces).apply(assembled, 
+                                                               &reason);
+    if (!assembled.defined()) {
+      return IndexStmt();
+    }
+  }
+  return assembled;
+}
+
+IndexStmt parallelizeOuterLoop(IndexStmt stmt, bool privatizeReductions) {
+  if (readsSymmetricTensor(stmt)) {
+    return stmt;
+  }
+
   // get outer ForAll
   Forall forall;
   bool matched = false;
@@ -1596,7 +1868,26 @@ IndexStmt parallelizeOuterLoop(IndexStmt stmt) {
     return parallelized256;
   }
   else {
+    ParallelSchedule sched;
+    int chunkSize;
+    taco_get_parallel_schedule(&sched, &chunkSize);
+    if (sched == ParallelSchedule::Balanced) {
+      IndexStmt balanced = parallelizeOuterLoopsByNonzeros(stmt, 
+          chunkSize > 0 ? chunkSize : DEFAULT_NONZEROS_PER_CHUNK);
+      if (balanced.defined()) {
+        return balanced;
+      }
+    }
+
     IndexStmt parallelized = Parallelize(forall.getIndexVar(), ParallelUnit::CPUThread, OutputRaceStrategy::NoRaces).apply(stmt, &reason);
+    if (parallelized == IndexStmt() && privatizeReductions) {
+      parallelized = Parallelize(forall.getIndexVar(), ParallelUnit::CPUThread, 
+                                 OutputRaceStrategy::Temporary).apply(stmt, 
+                                                                      &reason);
+    }
+    if (parallelized == IndexStmt() && taco_get_parallel_assembly()) {
+      parallelized = parallelizeAssembly(stmt);
+    }
     if (parallelized == IndexStmt()) {
       // can't parallelize
       return stmt;
@@ -1835,13 +2126,19 @@ IndexStmt reorderLoopsTopologically(IndexStmt stmt) {
 
 IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph, 
                         bool isWholeStmt, bool promoteScalar) {
+  if (readsSymmetricTensor(stmt)) {
+    return stmt;
+  }
+
   std::map<Access,const ForallNode*> hoistLevel;
   std::map<Access,IndexExpr> reduceOp;
+  std::map<Access,Datatype> accumulatorTypes;
   struct FindHoistLevel : public IndexNotationVisitor {
     using IndexNotationVisitor::visit;
 
     std::map<Access,const ForallNode*>& hoistLevel;
     std::map<Access,IndexExpr>& reduceOp;
+    std::map<Access,Datatype>& accumulatorTypes;
     std::map<Access,std::set<IndexVar>> hoistIndices;
     std::set<IndexVar> derivedIndices;
     std::set<IndexVar> indices;
@@ -1851,9 +2148,11 @@ IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph,
     
     FindHoistLevel(std::map<Access,const ForallNode*>& hoistLevel,
                    std::map<Access,IndexExpr>& reduceOp,
+                   std::map<Access,Datatype>& accumulatorTypes,
                    const ProvenanceGraph& provGraph,
                    bool isWholeStmt, bool promoteScalar) : 
-        hoistLevel(hoistLevel), reduceOp(reduceOp), provGraph(provGraph),
+        hoistLevel(hoistLevel), reduceOp(reduceOp),
+        accumulatorTypes(accumulatorTypes), provGraph(provGraph),
         isWholeStmt(isWholeStmt), promoteScalar(promoteScalar) {}
 
     void visit(const ForallNode* node) {
@@ -1863,14 +2162,20 @@ IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph,
       // Don't allow hoisting out of forall's for GPU warp and block reduction
       if (foralli.getParallelUnit() == ParallelUnit::GPUWarpReduction || 
           foralli.getParallelUnit() == ParallelUnit::GPUBlockReduction) {
-        FindHoistLevel findHoistLevel(hoistLevel, reduceOp, provGraph, false, 
-                                      promoteScalar);
+        FindHoistLevel findHoistLevel(hoistLevel, reduceOp, accumulatorTypes,
+                                      provGraph, false, promoteScalar);
         foralli.getStmt().accept(&findHoistLevel);
         return;
       }
 
+      // Don't hoist reductions out of loops that are parallelized over CPU 
+      // threads, since the threads would then share the promoted scalar. 
+      // Hoisting them into the loop instead has every thread reduce its 
+      // iterations into a scalar of its own that it adds to the result once.
       std::vector<Access> resultAccesses;
-      std::tie(resultAccesses, std::ignore) = getResultAccesses(foralli);
+      if (foralli.getParallelUnit() != ParallelUnit::CPUThread) {
+        std::tie(resultAccesses, std::ignore) = getResultAccesses(foralli);
+      }
       for (const auto& resultAccess : resultAccesses) {
         if (!promoteScalar && resultAccess.getIndexVars().empty()) {
           continue;
@@ -1923,10 +2228,13 @@ IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph,
       if (util::contains(reduceOp, op->lhs)) {
         reduceOp[op->lhs] = op->op;
       }
+      if (op->accumulatorType.getKind() != Datatype::Undefined) {
+        accumulatorTypes[op->lhs] = op->accumulatorType;
+      }
     }
   };
-  FindHoistLevel findHoistLevel(hoistLevel, reduceOp, provGraph, isWholeStmt, 
-                                promoteScalar);
+  FindHoistLevel findHoistLevel(hoistLevel, reduceOp, accumulatorTypes,
+                                provGraph, isWholeStmt, promoteScalar);
   stmt.accept(&findHoistLevel);
   
   struct HoistWrites : public IndexNotationRewriter {
@@ -1934,10 +2242,13 @@ IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph,
 
     const std::map<Access,const ForallNode*>& hoistLevel;
     const std::map<Access,IndexExpr>& reduceOp;
+    const std::map<Access,Datatype>& accumulatorTypes;
 
     HoistWrites(const std::map<Access,const ForallNode*>& hoistLevel,
-                const std::map<Access,IndexExpr>& reduceOp) : 
-        hoistLevel(hoistLevel), reduceOp(reduceOp) {}
+                const std::map<Access,IndexExpr>& reduceOp,
+                const std::map<Access,Datatype>& accumulatorTypes) : 
+        hoistLevel(hoistLevel), reduceOp(reduceOp),
+        accumulatorTypes(accumulatorTypes) {}
 
     void visit(const ForallNode* node) {
       Forall foralli(node);
@@ -1949,9 +2260,14 @@ IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph,
         if (resultAccess.second == node) {
           // This assumes the index expression yields at most one result tensor; 
           // will not work correctly if there are multiple results.
+          // Results with an accumulator type are reduced into a temporary of 
+          // that type, which is converted when it is written to the result.
           TensorVar resultVar = resultAccess.first.getTensorVar();
+          Datatype valType = util::contains(accumulatorTypes, resultAccess.first)
+                           ? accumulatorTypes.at(resultAccess.first)
+                           : resultVar.getType().getDataType();
           TensorVar val("t" + i.getName() + resultVar.getName(), 
-                        Type(resultVar.getType().getDataType(), {}));
+                        Type(valType, {}));
           body = ReplaceReductionExpr(
               map<Access,Access>({{resultAccess.first, val()}})).rewrite(body);
 
@@ -1975,7 +2291,7 @@ IndexStmt scalarPromote(IndexStmt stmt, ProvenanceGraph provGraph,
       }
     }
   };
-  HoistWrites hoistWrites(hoistLevel, reduceOp);
+  HoistWrites hoistWrites(hoistLevel, reduceOp, accumulatorTypes);
   return hoistWrites.rewrite(stmt);
 }
 
@@ -2080,8 +2396,27 @@ static IndexStmt optimizeSpMM(IndexStmt stmt) {
                                     w(j) += B(i,k) * C(k,j)))));
 }
 
+WorkspaceStrategy chooseWorkspaceStrategy(double rowSize, int64_t dimension) {
+  // A dense workspace vector of 2^16 double components (plus its bit guards
+  // and index list) still fits in the L2 cache.
+  const int64_t cachedDimension = 1 << 16;
+  if (dimension <= cachedDimension || rowSize * 16 >= dimension) {
+    return WorkspaceStrategy::Dense;
+  }
+  return (rowSize <= 32) ? WorkspaceStrategy::Heap : WorkspaceStrategy::Hash;
+}
+
+bool shouldPrivatizeReductions(int64_t resultSize, int64_t work, 
+                               int numThreads) {
+  return numThreads > 1 && resultSize * numThreads <= work;
+}
+
 IndexStmt insertTemporaries(IndexStmt stmt)
 {
+  if (readsSymmetricTensor(stmt)) {
+    return stmt;
+  }
+
   IndexStmt spmm = optimizeSpMM(stmt);
   if (spmm != stmt) {
     return spmm;
@@ -85,6 +85,12 @@ Expr Literal::zero(Datatype datatype) {
     case Datatype::Int128:
       taco_not_supported_yet;
       break;
+    case Datatype::Float16:
+      zero = Literal::make(float16());
+      break;
+    case Datatype::BFloat16:
+      zero = Literal::make(bfloat16());
+      break;
     case Datatype::Float32:
       zero = Literal::make((float)0.0);
       break;
@@ -157,6 +163,10 @@ uint64_t Literal::getUIntValue() const {
 double Literal::getFloatValue() const {
   taco_iassert(type.isFloat()) << "Type must be floating point";
   switch (type.getKind()) {
+    case Datatype::Float16:
+      return getValue<float16>();
+    case Datatype::BFloat16:
+      return getValue<bfloat16>();
     case Datatype::Float32:
       static_assert(sizeof(float) == 4, "Float not 32 bits");
       return getValue<float>();
@@ -224,6 +234,12 @@ bool Literal::equalsScalar(double scalar) const {
     case Datatype::Int128:
       taco_not_supported_yet;
     break;
+    case Datatype::Float16:
+      return compare<float16>(this, scalar);
+    break;
+    case Datatype::BFloat16:
+      return compare<bfloat16>(this, scalar);
+    break;
     case Datatype::Float32:
       return compare<float>(this, scalar);
     break;
@@ -770,7 +786,8 @@ Stmt Yield::make(std::vector<Expr> coords, Expr val) {
 }
 
 // Allocate
-Stmt Allocate::make(Expr var, Expr num_elements, bool is_realloc, Expr old_elements, bool clear) {
+Stmt Allocate::make(Expr var, Expr num_elements, bool is_realloc, Expr old_elements, bool clear,
+                    bool pooled) {
   taco_iassert(var.as<GetProperty>() ||
                (var.as<Var>() && var.as<Var>()->is_ptr)) <<
       "Can only allocate memory for a pointer-typed Var";
@@ -783,6 +800,8 @@ Stmt Allocate::make(Expr var, Expr num_elements, bool is_realloc, Expr old_eleme
   taco_iassert(!is_realloc || old_elements.ptr != NULL);
   alloc->old_elements = old_elements;
   alloc->clear = clear;
+  taco_iassert(!is_realloc || !pooled);
+  alloc->pooled = pooled;
   return alloc;
 }
 
@@ -836,7 +855,8 @@ Expr GetProperty::make(Expr tensor, TensorProperty property, int mode,
   gp->index = index;
   
   //TODO: deal with the fact that some of these are pointers
-  if (property == TensorProperty::Values)
+  if (property == TensorProperty::Values ||
+      property == TensorProperty::ValuesDictionary)
     gp->type = tensor.type();
   else
     gp->type = Int();
@@ -844,6 +864,21 @@ Expr GetProperty::make(Expr tensor, TensorProperty property, int mode,
   return gp;
 }
 
+Expr GetProperty::make(Expr tensor, TensorProperty property, int mode,
+                       int index, std::string name, Datatype type) {
+  taco_iassert(property == TensorProperty::Indices ||
+               property == TensorProperty::Values)
+      << "Only index and values arrays may have a custom element type";
+  GetProperty* gp = new GetProperty;
+  gp->tensor = tensor;
+  gp->property = property;
+  gp->mode = mode;
+  gp->name = name;
+  gp->index = index;
+  gp->type = type;
+  return gp;
+}
+
 // Sort
 Stmt Sort::make(std::vector<Expr> args) {
   Sort* sort = new Sort;
@@ -860,7 +895,8 @@ Expr GetProperty::make(Expr tensor, TensorProperty property, int mode) {
   gp->mode = mode;
   
   //TODO: deal with the fact that these are pointers.
-  if (property == TensorProperty::Values)
+  if (property == TensorProperty::Values ||
+      property == TensorProperty::ValuesDictionary)
     gp->type = tensor.type();
   else
     gp->type = Int();
@@ -894,6 +930,9 @@ Expr GetProperty::make(Expr tensor, TensorProperty property, int mode) {
     case TensorProperty::FillValue:
       gp->name = tensorVar->name + "_fill_value";
       break;
+    case TensorProperty::ValuesDictionary:
+      gp->name = tensorVar->name + "_vals_dict";
+      break;
   }
   
   return gp;
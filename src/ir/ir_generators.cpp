@@ -1,6 +1,12 @@
 #include "taco/ir/ir_generators.h"
 
+#include <map>
+#include <set>
+
 #include "taco/ir/ir.h"
+#include "taco/ir/ir_rewriter.h"
+#include "taco/ir/ir_visitor.h"
+#include "taco/ir/simplify.h"
 #include "taco/error.h"
 #include "taco/util/strings.h"
 
@@ -46,4 +52,470 @@ Stmt atLeastDoubleSizeIfFull(Expr a, Expr size, Expr needed) {
   return IfThenElse::make(Lte::make(size, needed), ifBody);
 }
 
+Stmt parallelPrefixSum(Expr a, Expr size) {
+  const std::string name = util::toString(a);
+  const Datatype type = a.type();
+  const Datatype indexType = size.type();
+
+  // Every thread scans one block of the array, after which the sums of the 
+  // preceding blocks are added to every block.
+  Expr numBlocks = Var::make(name + "_blocks", indexType);
+  Expr blockSize = Var::make(name + "_block_size", indexType);
+  Expr blockSums = Var::make(name + "_block_sums", type, true);
+  Stmt initBlocks = Block::make(
+      VarDecl::make(numBlocks, Call::make("omp_get_max_threads", {}, 
+                                          indexType)),
+      VarDecl::make(blockSize, 
+                    Div::make(Sub::make(Add::make(size, numBlocks), 1), 
+                              numBlocks)),
+      VarDecl::make(blockSums, 0),
+      Allocate::make(blockSums, numBlocks));
+
+  Expr block = Var::make("b", indexType);
+  Expr lo = Var::make("lo", indexType);
+  Expr hi = Var::make("hi", indexType);
+  Stmt initBounds = Block::make(
+      VarDecl::make(lo, Mul::make(block, blockSize)),
+      VarDecl::make(hi, Min::make(Add::make(lo, blockSize), size)));
+
+  Expr sum = Var::make("sum", type);
+  Expr p = Var::make("p", indexType);
+  Stmt scanBlock = For::make(p, lo, hi, 1, Block::make(
+      compoundAssign(sum, Load::make(a, p)),
+      Store::make(a, p, sum)));
+  Stmt scanBlocks = For::make(block, 0, numBlocks, 1, Block::make(
+      initBounds,
+      VarDecl::make(sum, Literal::zero(type)),
+      scanBlock,
+      Store::make(blockSums, block, sum)), 
+      LoopKind::Static, ParallelUnit::CPUThread);
+
+  Expr carry = Var::make("carry", type);
+  Expr blockSum = Var::make("block_sum", type);
+  Stmt scanSums = Block::make(
+      VarDecl::make(carry, Literal::zero(type)),
+      For::make(block, 0, numBlocks, 1, Block::make(
+          VarDecl::make(blockSum, Load::make(blockSums, block)),
+          Store::make(blockSums, block, carry),
+          compoundAssign(carry, blockSum))));
+
+  Stmt addCarries = For::make(block, 1, numBlocks, 1, Block::make(
+      initBounds,
+      For::make(p, lo, hi, 1, 
+                compoundStore(a, p, Load::make(blockSums, block)))), 
+      LoopKind::Static, ParallelUnit::CPUThread);
+
+  return Block::make(initBlocks, scanBlocks, scanSums, addCarries,
+                     Free::make(blockSums));
+}
+
+namespace {
+/// Replaces the variables declared in the statements it rewrites by new
+/// variables, so that the statements can be emitted more than once.
+struct RenameDeclaredVars : public IRRewriter {
+  std::string suffix;
+  std::map<Expr,Expr> renamed;
+
+  using IRRewriter::visit;
+
+  void visit(const Var* op) {
+    auto it = renamed.find(op);
+    expr = (it != renamed.end()) ? it->second : op;
+  }
+
+  void visit(const VarDecl* op) {
+    Expr rhs = rewrite(op->rhs);
+    const Var* var = op->var.as<Var>();
+    // Pointers keep their names in generated code, so they are made unique
+    Expr renamedVar = Var::make(var->is_ptr ? var->name + suffix : var->name,
+                                var->type, var->is_ptr, var->is_tensor,
+                                var->is_parameter);
+    renamed[op->var] = renamedVar;
+    stmt = VarDecl::make(renamedVar, rhs);
+  }
+};
+
+/// Returns true if `node` reads or writes any of the variables in `vars`.
+template <typename IRHandle>
+bool usesVars(IRHandle node, const std::set<Expr>& vars) {
+  struct UsesVars : public IRVisitor {
+    const std::set<Expr>& vars;
+    bool usesVars = false;
+
+    UsesVars(const std::set<Expr>& vars) : vars(vars) {}
+
+    using IRVisitor::visit;
+
+    void visit(const Var* op) {
+      usesVars = usesVars || vars.count(op);
+    }
+
+    void visit(const VarDecl* op) {
+      op->var.accept(this);
+      op->rhs.accept(this);
+    }
+  };
+
+  if (!node.defined()) {
+    return false;
+  }
+  UsesVars visitor(vars);
+  node.accept(&visitor);
+  return visitor.usesVars;
+}
+
+/// Returns true if `stmt` contains a break or continue that leaves the loop
+/// that encloses `stmt` (rather than a loop that is nested in `stmt`).
+bool exitsLoop(Stmt stmt) {
+  struct ExitsLoop : public IRVisitor {
+    bool exitsLoop = false;
+
+    using IRVisitor::visit;
+
+    void visit(const For* op) {}
+
+    void visit(const While* op) {}
+
+    void visit(const Break* op) {
+      exitsLoop = true;
+    }
+
+    void visit(const Continue* op) {
+      exitsLoop = true;
+    }
+  };
+
+  ExitsLoop visitor;
+  stmt.accept(&visitor);
+  return visitor.exitsLoop;
+}
+
+/// Unrolls a loop by `factor`, jamming nested loops whose bounds do not
+/// depend on the loop variable into the copies of the loop body.
+class UnrollAndJam {
+public:
+  UnrollAndJam(const For* loop, int factor) : loop(loop), factor(factor) {}
+
+  Stmt unroll() {
+    struct ContainsYield : public IRVisitor {
+      bool containsYield = false;
+      using IRVisitor::visit;
+      void visit(const Yield* op) {
+        containsYield = true;
+      }
+    };
+    ContainsYield containsYield;
+    loop->contents.accept(&containsYield);
+    if (containsYield.containsYield || exitsLoop(loop->contents)) {
+      return Stmt();
+    }
+
+    const Var* var = loop->var.as<Var>();
+    Expr blockVar = Var::make(var->name, var->type);
+    copies.resize(factor);
+    std::vector<Stmt> declareCopies;
+    for (int i = 0; i < factor; i++) {
+      copies[i].suffix = "_" + std::to_string(i);
+      declareCopies.push_back(copies[i].rewrite(
+          VarDecl::make(loop->var, ir::simplify(Add::make(blockVar, i)))));
+    }
+
+    // Copies of the body are interleaved statement by statement, so that a
+    // single copy of every loop that does not depend on the loop variable
+    // runs the copies of its body (e.g. the loop over the nonzeros of a row
+    // runs all copies of an unrolled loop over a small dense dimension).
+    // If this is not possible the copies of the body run one after another.
+    Stmt contents = loop->contents;
+    if (const Scope* scope = contents.as<Scope>()) {
+      contents = scope->scopedStmt;
+    }
+    findDependentVars();
+    Stmt jammed = canJam() ? jam(contents) : Stmt();
+    Stmt body;
+    if (jammed.defined()) {
+      body = Block::make(Block::make(declareCopies), jammed);
+    }
+    else {
+      std::vector<Stmt> iterations;
+      for (int i = 0; i < factor; i++) {
+        iterations.push_back(declareCopies[i]);
+        iterations.push_back(copies[i].rewrite(contents));
+      }
+      body = Block::make(iterations);
+    }
+
+    // A loop that runs a single block of copies (e.g. a fully unrolled loop
+    // over a small dense block) is replaced by that block
+    Expr numIterations = ir::simplify(Sub::make(loop->end, loop->start));
+    if (isa<Literal>(numIterations) &&
+        numIterations.as<Literal>()->getIntValue() == factor) {
+      return Scope::make(Block::make(VarDecl::make(blockVar, loop->start),
+                                     body));
+    }
+    Stmt unrolledLoop = For::make(blockVar, loop->start,
+        ir::simplify(Sub::make(loop->end, factor - 1)), factor, body);
+    if (isa<Literal>(numIterations) &&
+        numIterations.as<Literal>()->getIntValue() % factor == 0) {
+      return unrolledLoop;
+    }
+
+    // Iterations that do not fill a block are left to a remainder loop
+    Expr remainderStart = ir::simplify(Add::make(loop->start,
+        Mul::make(Div::make(numIterations, factor), factor)));
+    Stmt remainderLoop = For::make(loop->var, remainderStart, loop->end, 1,
+                                   loop->contents);
+    return Block::make(unrolledLoop, remainderLoop);
+  }
+
+private:
+  const For* loop;
+  int factor;
+  std::vector<RenameDeclaredVars> copies;
+
+  /// Variables whose values differ between copies of the loop body
+  std::set<Expr> dependentVars;
+
+  /// Variables declared in the loop body
+  std::set<Expr> declaredVars;
+
+  void findDependentVars() {
+    struct FindDependentVars : public IRVisitor {
+      std::set<Expr>& dependentVars;
+      std::set<Expr>& declaredVars;
+      bool controlDependent = false;
+
+      FindDependentVars(std::set<Expr>& dependentVars,
+                        std::set<Expr>& declaredVars)
+          : dependentVars(dependentVars), declaredVars(declaredVars) {}
+
+      using IRVisitor::visit;
+
+      void define(Expr var, Expr value) {
+        if (controlDependent || usesVars(value, dependentVars)) {
+          dependentVars.insert(var);
+        }
+      }
+
+      void visitControlDependent(Stmt stmt, bool dependent) {
+        if (!stmt.defined()) {
+          return;
+        }
+        bool wasControlDependent = controlDependent;
+        controlDependent = controlDependent || dependent;
+        stmt.accept(this);
+        controlDependent = wasControlDependent;
+      }
+
+      void visit(const VarDecl* op) {
+        declaredVars.insert(op->var);
+        define(op->var, op->rhs);
+      }
+
+      void visit(const Assign* op) {
+        define(op->lhs, op->rhs);
+      }
+
+      void visit(const For* op) {
+        declaredVars.insert(op->var);
+        bool dependent = usesVars(op->start, dependentVars) ||
+                         usesVars(op->end, dependentVars) ||
+                         usesVars(op->increment, dependentVars);
+        if (dependent) {
+          define(op->var, op->start);
+        }
+        visitControlDependent(op->contents, dependent);
+      }
+
+      void visit(const While* op) {
+        visitControlDependent(op->contents, usesVars(op->cond, dependentVars));
+      }
+
+      void visit(const IfThenElse* op) {
+        bool dependent = usesVars(op->cond, dependentVars);
+        visitControlDependent(op->then, dependent);
+        visitControlDependent(op->otherwise, dependent);
+      }
+
+      void visit(const Case* op) {
+        bool dependent = false;
+        for (auto& clause : op->clauses) {
+          dependent = dependent || usesVars(clause.first, dependentVars);
+        }
+        for (auto& clause : op->clauses) {
+          visitControlDependent(clause.second, dependent);
+        }
+      }
+    };
+
+    dependentVars = {loop->var};
+    size_t numDependentVars;
+    do {
+      numDependentVars = dependentVars.size();
+      FindDependentVars visitor(dependentVars, declaredVars);
+      loop->contents.accept(&visitor);
+    } while (dependentVars.size() != numDependentVars);
+  }
+
+  /// Statements that are emitted once for all copies may only update state
+  /// that is private to an iteration of the loop, since the copies would
+  /// otherwise not see the updates of the other copies.  Variables are private
+  /// if they are declared in the loop body, and array elements are private if
+  /// their locations depend on the loop variable.
+  bool canJam() {
+    struct UpdatesShared : public IRVisitor {
+      const std::set<Expr>& declaredVars;
+      const std::set<Expr>& dependentVars;
+      bool updatesShared = false;
+
+      UpdatesShared(const std::set<Expr>& declaredVars,
+                    const std::set<Expr>& dependentVars)
+          : declaredVars(declaredVars), dependentVars(dependentVars) {}
+
+      using IRVisitor::visit;
+
+      void visit(const Assign* op) {
+        updatesShared = updatesShared || !declaredVars.count(op->lhs);
+      }
+
+      void visit(const Store* op) {
+        updatesShared = updatesShared || !usesVars(op->loc, dependentVars);
+      }
+    };
+
+    UpdatesShared visitor(declaredVars, dependentVars);
+    loop->contents.accept(&visitor);
+    return !visitor.updatesShared;
+  }
+
+  /// Returns true if `stmt` has no effects other than updating variables
+  /// declared in the loop body, so that a single copy of it can stand in for
+  /// all copies.
+  static bool isPrivate(Stmt stmt) {
+    struct IsPrivate : public IRVisitor {
+      bool isPrivate = true;
+
+      using IRVisitor::visit;
+
+      void visit(const Store* op) { isPrivate = false; }
+      void visit(const Allocate* op) { isPrivate = false; }
+      void visit(const Free* op) { isPrivate = false; }
+      void visit(const Sort* op) { isPrivate = false; }
+      void visit(const Print* op) { isPrivate = false; }
+      void visit(const Switch* op) { isPrivate = false; }
+      void visit(const Function* op) { isPrivate = false; }
+    };
+
+    IsPrivate visitor;
+    stmt.accept(&visitor);
+    return visitor.isPrivate;
+  }
+
+  /// Returns `stmt` with its loops and conditionals that do not depend on the
+  /// loop variable emitted once, and its other statements emitted once per
+  /// copy, or an undefined statement if that is not possible.
+  Stmt jam(Stmt stmt) {
+    if (!stmt.defined()) {
+      return stmt;
+    }
+    if (!usesVars(stmt, dependentVars)) {
+      return isPrivate(stmt) ? stmt : Stmt();
+    }
+
+    if (const Block* block = stmt.as<Block>()) {
+      std::vector<Stmt> contents;
+      for (auto& s : block->contents) {
+        Stmt jammed = jam(s);
+        if (!jammed.defined()) {
+          return Stmt();
+        }
+        contents.push_back(jammed);
+      }
+      return Block::make(contents);
+    }
+    if (const Scope* scope = stmt.as<Scope>()) {
+      Stmt scopedStmt = jam(scope->scopedStmt);
+      return scopedStmt.defined() ? Scope::make(scopedStmt) : Stmt();
+    }
+    if (const For* op = stmt.as<For>()) {
+      if (!dependentVars.count(op->var) && !exitsLoop(op->contents)) {
+        Stmt contents = jam(op->contents);
+        return contents.defined()
+               ? For::make(op->var, op->start, op->end, op->increment, contents,
+                           op->kind, op->parallel_unit, op->unrollFactor,
+                           op->vec_width)
+               : Stmt();
+      }
+    }
+    else if (const While* op = stmt.as<While>()) {
+      if (!usesVars(op->cond, dependentVars) && !exitsLoop(op->contents)) {
+        Stmt contents = jam(op->contents);
+        return contents.defined()
+               ? While::make(op->cond, contents, op->kind, op->vec_width)
+               : Stmt();
+      }
+    }
+    else if (const IfThenElse* op = stmt.as<IfThenElse>()) {
+      if (!usesVars(op->cond, dependentVars)) {
+        Stmt then = jam(op->then);
+        Stmt otherwise = jam(op->otherwise);
+        if (!then.defined() || (op->otherwise.defined() && !otherwise.defined())) {
+          return Stmt();
+        }
+        return otherwise.defined() ? IfThenElse::make(op->cond, then, otherwise)
+                                   : IfThenElse::make(op->cond, then);
+      }
+    }
+    else if (const Case* op = stmt.as<Case>()) {
+      bool dependent = false;
+      for (auto& clause : op->clauses) {
+        dependent = dependent || usesVars(clause.first, dependentVars);
+      }
+      if (!dependent) {
+        std::vector<std::pair<Expr,Stmt>> clauses;
+        for (auto& clause : op->clauses) {
+          Stmt jammed = jam(clause.second);
+          if (!jammed.defined()) {
+            return Stmt();
+          }
+          clauses.push_back({clause.first, jammed});
+        }
+        return Case::make(clauses, op->alwaysMatch);
+      }
+    }
+
+    // Statements that depend on the loop variable are emitted once per copy,
+    // which is not possible if they leave the loop they are jammed into
+    if (exitsLoop(stmt)) {
+      return Stmt();
+    }
+    std::vector<Stmt> copiesOfStmt;
+    for (auto& copy : copies) {
+      copiesOfStmt.push_back(copy.rewrite(stmt));
+    }
+    return Block::make(copiesOfStmt);
+  }
+};
+}
+
+Stmt unrollLoops(Stmt stmt) {
+  struct UnrollLoops : public IRRewriter {
+    using IRRewriter::visit;
+
+    void visit(const For* op) {
+      IRRewriter::visit(op);
+      op = stmt.as<For>();
+      if (op->unrollFactor <= 1 || op->kind != LoopKind::Serial ||
+          !isa<Literal>(op->increment) ||
+          !op->increment.as<Literal>()->equalsScalar(1)) {
+        return;
+      }
+      Stmt unrolled = UnrollAndJam(op, op->unrollFactor).unroll();
+      if (unrolled.defined()) {
+        stmt = unrolled;
+      }
+    }
+  };
+  return UnrollLoops().rewrite(stmt);
+}
+
 }}
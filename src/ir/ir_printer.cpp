@@ -97,6 +97,14 @@ void IRPrinter::visit(const Literal* op) {
     case Datatype::Int128:
       taco_not_supported_yet;
     break;
+    case Datatype::Float16:
+      stream << ((op->getValue<float16>() != 0.0f)
+                 ? util::toString(op->getValue<float16>()) : "0.0");
+    break;
+    case Datatype::BFloat16:
+      stream << ((op->getValue<bfloat16>() != 0.0f)
+                 ? util::toString(op->getValue<bfloat16>()) : "0.0");
+    break;
     case Datatype::Float32:
       stream << ((op->getValue<float>() != 0.0)
                  ? util::toString(op->getValue<float>()) : "0.0");
@@ -542,6 +550,8 @@ void IRPrinter::visit(const Allocate* op) {
   doIndent();
   if (op->is_realloc)
     stream << "reallocate ";
+  else if (op->pooled)
+    stream << "allocate pooled ";
   else
     stream << "allocate ";
   op->var.accept(this);
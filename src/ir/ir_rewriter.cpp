@@ -435,7 +435,8 @@ void IRRewriter::visit(const Allocate* op) {
     stmt = op;
   }
   else {
-    stmt = Allocate::make(var, num_elements, op->is_realloc, op->old_elements, op->clear);
+    stmt = Allocate::make(var, num_elements, op->is_realloc, op->old_elements, op->clear,
+                          op->pooled);
   }
 }
 
@@ -488,6 +489,10 @@ void IRRewriter::visit(const GetProperty* op) {
   if (tensor == op->tensor) {
     expr = op;
   }
+  else if (op->property == TensorProperty::Indices) {
+    expr = GetProperty::make(tensor, op->property, op->mode, op->index, 
+                             op->name, op->type);
+  }
   else {
     expr = GetProperty::make(tensor, op->property, op->mode, op->index, op->name);
   }
@@ -6,6 +6,8 @@ const char *ParallelUnit_NAMES[] = {"NotParallel", "DefaultUnit", "GPUBlock", "G
 const char *OutputRaceStrategy_NAMES[] = {"IgnoreRaces", "NoRaces", "Atomics", "Temporary", "ParallelReduction"};
 const char *BoundType_NAMES[] = {"MinExact", "MinConstraint", "MaxExact", "MaxConstraint"};
 const char *AssembleStrategy_NAMES[] = {"Append", "Insert"};
-const char *MergeStrategy_NAMES[] = {"TwoFinger", "Gallop"};
+const char *MergeStrategy_NAMES[] = {"TwoFinger", "Gallop", "MergePath"};
+const char *WorkspaceStrategy_NAMES[] = {"Dense", "Hash", "Heap"};
+const char *TailStrategy_NAMES[] = {"GuardWithIf", "Peel"};
 
 }
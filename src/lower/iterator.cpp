@@ -215,6 +215,12 @@ bool Iterator::isZeroless() const {
   return getMode().defined() && getMode().getModeFormat().isZeroless();
 }
 
+bool Iterator::isPadded() const {
+  taco_iassert(defined());
+  if (isDimensionIterator()) return false;
+  return getMode().defined() && getMode().getModeFormat().isPadded();
+}
+
 bool Iterator::hasCoordIter() const {
   taco_iassert(defined());
   if (isDimensionIterator()) return false;
@@ -227,6 +233,18 @@ bool Iterator::hasPosIter() const {
   return getMode().defined() && getMode().getModeFormat().hasCoordPosIter();
 }
 
+bool Iterator::hasWordIter() const {
+  taco_iassert(defined());
+  if (isDimensionIterator()) return false;
+  return getMode().defined() && getMode().getModeFormat().impl->hasWordIter();
+}
+
+bool Iterator::hasRunIter() const {
+  taco_iassert(defined());
+  if (isDimensionIterator()) return false;
+  return getMode().defined() && getMode().getModeFormat().impl->hasRunIter();
+}
+
 bool Iterator::hasLocate() const {
   taco_iassert(defined());
   if (isDimensionIterator()) return false;
@@ -290,12 +308,51 @@ ModeFunction Iterator::posAccess(const ir::Expr& pos,
   return getMode().getModeFormat().impl->posIterAccess(pos, coords, getMode());
 }
 
+ModeFunction Iterator::wordBounds(const ir::Expr& parentPos) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->wordIterBounds(parentPos, getMode());
+}
+
+ModeFunction Iterator::wordAccess(const ir::Expr& wordPos) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->wordIterAccess(wordPos, getMode());
+}
+
+ModeFunction Iterator::wordLocate(const ir::Expr& parentPos, 
+                                  const ir::Expr& wordPos,
+                                  const ir::Expr& bit) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->wordIterLocate(parentPos, wordPos, 
+                                                        bit, getMode());
+}
+
+ModeFunction Iterator::runBounds(const ir::Expr& parentPos) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->runIterBounds(parentPos, getMode());
+}
+
+ModeFunction Iterator::runAccess(const ir::Expr& runPos) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->runIterAccess(runPos, getMode());
+}
+
+ModeFunction Iterator::runLocate(const ir::Expr& pos) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->runIterLocate(pos, getMode());
+}
+
 ModeFunction Iterator::locate(const std::vector<ir::Expr>& coords) const {
   taco_iassert(defined() && content->mode.defined());
   return getMode().getModeFormat().impl->locate(getParent().getPosVar(),
                                               coords, getMode());
 }
 
+ModeFunction Iterator::locate(const Expr& parentPos,
+                              const std::vector<Expr>& coords) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->locate(parentPos, coords, getMode());
+}
+
 Stmt Iterator::getInsertCoord(const Expr& p, const std::vector<Expr>& coords) const {
   taco_iassert(defined() && content->mode.defined());
   return getMode().getModeFormat().impl->getInsertCoord(p, coords, getMode());
@@ -381,6 +438,21 @@ Stmt Iterator::getSeqInsertEdge(const Expr& parentPos,
                                                           queries, getMode());
 }
 
+Stmt Iterator::getParInsertEdge(const Expr& parentPos, 
+    const std::vector<Expr>& coords, 
+    const std::vector<AttrQueryResult>& queries) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->getParInsertEdge(parentPos, coords, 
+                                                          queries, getMode());
+}
+
+Stmt Iterator::getParFinalizeEdges(const Expr& prevSize, 
+    const std::vector<AttrQueryResult>& queries) const {
+  taco_iassert(defined() && content->mode.defined());
+  return getMode().getModeFormat().impl->getParFinalizeEdges(prevSize, queries,
+                                                             getMode());
+}
+
 Stmt Iterator::getInitCoords(const Expr& prevSize, 
     const std::vector<AttrQueryResult>& queries) const {
   taco_iassert(defined() && content->mode.defined());
@@ -587,9 +659,13 @@ void Iterators::createAccessIterators(Access access, Format format, Expr tensorI
     taco_iassert(modeTypePack.getModeFormats().size() > 0);
 
     int modeNumber = format.getModeOrdering()[level-1];
+    vector<Datatype> arrayTypes;
+    if ((size_t)level <= format.getLevelArrayTypes().size()) {
+      arrayTypes = format.getLevelArrayTypes()[level-1];
+    }
     ModePack modePack(modeTypePack.getModeFormats().size(),
                       modeTypePack.getModeFormats()[0], tensorIR,
-                      modeNumber, level);
+                      modeNumber, level, arrayTypes);
 
     int pos = 0;
     for (auto& modeType : modeTypePack.getModeFormats()) {
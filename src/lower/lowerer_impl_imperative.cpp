@@ -10,6 +10,7 @@
 #include "taco/index_notation/provenance_graph.h"
 #include "taco/ir/ir.h"
 #include "taco/ir/ir_generators.h"
+#include "taco/ir/ir_rewriter.h"
 #include "taco/ir/ir_visitor.h"
 #include "taco/ir/simplify.h"
 #include "taco/lower/iterator.h"
@@ -18,6 +19,7 @@
 #include "taco/util/collections.h"
 #include "taco/util/env.h"
 #include "taco/ir/workspace_rewriter.h"
+#include "taco/storage/allocator.h"
 
 using namespace std;
 using namespace taco::ir;
@@ -109,6 +111,217 @@ static void getDependentTensors(IndexStmt stmt, std::set<TensorVar>& tensors) {
   } while (prev != tensors);
 }
 
+/// Replaces the workspace vectors that are stored in a hashed level (e.g.,
+/// the workspace `TensorVar w(type, Format({Hashed}))` of a precompute) by
+/// dense workspace vectors that accumulate into hash tables (see
+/// WorkspaceStrategy::Hash).  Unlike dense workspaces, hashed workspaces are
+/// thus sized to the number of values that are scattered into them instead
+/// of to their dimension.  Hashed workspaces of higher order are not supported
+/// yet, so high-order contractions must precompute into hashed workspace
+/// vectors inside the loops over the remaining workspace dimensions.
+static IndexStmt replaceHashedWorkspaces(IndexStmt stmt) {
+  map<TensorVar,TensorVar> replacements;
+  for (const TensorVar& temporary : getTemporaries(stmt)) {
+    const vector<ModeFormat> modeFormats = temporary.getFormat().getModeFormats();
+    if (std::none_of(modeFormats.begin(), modeFormats.end(),
+                     [](const ModeFormat& modeFormat) {
+                       return modeFormat.getName() == Hashed.getName();
+                     })) {
+      continue;
+    }
+    taco_uassert(temporary.getOrder() == 1) << "Only workspace vectors can "
+        << "be stored in hashed levels, but " << temporary.getName()
+        << " has order " << temporary.getOrder() << ". Precompute into a "
+        << "hashed workspace vector inside the loops over the other "
+        << "dimensions instead.";
+    TensorVar workspace(temporary.getName(), temporary.getType(),
+                        Format({Dense}), temporary.getFill());
+    workspace.setAccelIndexVars(temporary.getAccelIndexVars(),
+                                temporary.getShouldAccel());
+    workspace.setWorkspaceStrategy(WorkspaceStrategy::Hash);
+    replacements.insert({temporary, workspace});
+  }
+  return replacements.empty() ? stmt : replace(stmt, replacements);
+}
+
+/// Returns the coordinate array of an iterator for use as an argument to the
+/// search routines (e.g., `taco_gallop`) emitted in the generated code's
+/// preamble, which operate on arrays of 32-bit coordinates.
+static Expr getSearchableCoordArray(const Iterator& iterator) {
+  Expr crdArray = iterator.getMode().getModePack().getArray(1);
+  taco_uassert(crdArray.type() == Int32) << "Searching the coordinates of "
+      << iterator.getTensor() << " (e.g., to iterate over a window or to "
+      << "gallop) requires 32-bit coordinates";
+  return crdArray;
+}
+
+/// Loops over the dense levels of blocks are fully unrolled if the blocks are
+/// smaller than this along the iterated mode.  Small blocks (e.g., the 2x2 to
+/// 8x8 blocks of BCSR) then run without loop overhead, while the code of
+/// larger blocks does not grow with their size.
+static const int unrolledBlockSizeLimit = 16;
+
+/// Returns the size of a mode of `tensor` if the mode is stored in a dense 
+/// level of a block (i.e., below a level that is not dense, as in BCSR) whose
+/// width is a compile-time constant (see DenseModeFormat::getWidth) smaller
+/// than unrolledBlockSizeLimit, or zero otherwise.
+static int getFixedBlockSize(const TensorVar& tensor, int mode) {
+  const Format& format = tensor.getFormat();
+  const Dimension& dimension = tensor.getType().getShape().getDimension(mode);
+  if (!dimension.isFixed() || dimension.getSize() >= unrolledBlockSizeLimit) {
+    return 0;
+  }
+  bool inBlock = false;
+  for (int level = 0; level < format.getOrder(); ++level) {
+    const bool isDense = 
+        (format.getModeFormats()[level].getName() == Dense.getName());
+    if (format.getModeOrdering()[level] == mode) {
+      return (inBlock && isDense) ? (int)dimension.getSize() : 0;
+    }
+    inBlock = inBlock || !isDense;
+  }
+  return 0;
+}
+
+/// Returns true if `expr` is zero wherever the components of `tensor` are 
+/// zero, i.e., if an access of `tensor` is a factor of `expr`.
+static bool hasFactor(IndexExpr expr, TensorVar tensor) {
+  if (isa<Access>(expr)) {
+    return to<Access>(expr).getTensorVar() == tensor;
+  } else if (isa<Mul>(expr)) {
+    Mul mul = to<Mul>(expr);
+    return hasFactor(mul.getA(), tensor) || hasFactor(mul.getB(), tensor);
+  } else if (isa<Neg>(expr)) {
+    return hasFactor(to<Neg>(expr).getA(), tensor);
+  }
+  return false;
+}
+
+/// Returns the access of a tensor that stores one triangle of a symmetric
+/// tensor in `expr`, or an undefined access if there is none.
+static Access getSymmetricAccess(IndexExpr expr) {
+  const AccessNode* symmetricAccess = nullptr;
+  match(expr,
+    std::function<void(const AccessNode*)>([&](const AccessNode* op) {
+      if (op->tensorVar.getFormat().isSymmetric()) {
+        taco_uassert(symmetricAccess == nullptr) <<
+            "Expressions can only read one symmetric tensor: " << expr;
+        symmetricAccess = op;
+      }
+    })
+  );
+  return (symmetricAccess != nullptr) ? Access(symmetricAccess) : Access();
+}
+
+/// Returns true if `tensor` is a pattern tensor, which has no values array.
+static bool isPattern(TensorVar tensor) {
+  return tensor.getOrder() > 0 && tensor.getFormat().isPattern();
+}
+
+/// Returns true if the workspaces of temporaries are kept in pools that
+/// survive across kernel invocations.
+static bool poolWorkspaces() {
+  return !should_use_CUDA_codegen() && should_use_workspace_pool();
+}
+
+/// Returns true if the values of `tensor` are dictionary encoded.
+static bool isDictionaryEncoded(TensorVar tensor) {
+  return tensor.getOrder() > 0 && tensor.getFormat().isDictionaryEncoded();
+}
+
+static bool isHalf(Datatype type) {
+  return type.getKind() == Datatype::Float16 ||
+         type.getKind() == Datatype::BFloat16;
+}
+
+/// Rewrites `stmt` so that 16-bit floats are only used for storage. Values
+/// are converted to float when they are loaded from 16-bit arrays and back
+/// when they are stored, and scalars and temporaries are widened to float, so
+/// that reductions accumulate in float.
+static Stmt widenHalfPrecision(Stmt stmt) {
+  struct WidenHalfPrecision : public IRRewriter {
+    map<Expr,Expr> widenedVars;
+
+    using IRRewriter::visit;
+
+    static Expr toFloat(Expr half) {
+      const string func = (half.type().getKind() == Datatype::Float16)
+                          ? "taco_half_to_float" : "taco_bfloat16_to_float";
+      return ir::Call::make(func, {half}, Float32);
+    }
+
+    static Expr fromFloat(Expr value, Datatype type) {
+      const string func = (type.getKind() == Datatype::Float16)
+                          ? "taco_float_to_half" : "taco_float_to_bfloat16";
+      return ir::Call::make(func, {value}, type);
+    }
+
+    void visit(const Var* op) {
+      if (!isHalf(op->type) || op->is_tensor) {
+        expr = op;
+        return;
+      }
+      if (!util::contains(widenedVars, Expr(op))) {
+        widenedVars.insert({op, Var::make(op->name, Float32, op->is_ptr,
+                                          op->is_tensor, op->is_parameter)});
+      }
+      expr = widenedVars.at(Expr(op));
+    }
+
+    void visit(const ir::Literal* op) {
+      expr = isHalf(op->type) ? ir::Literal::make((float)op->getFloatValue())
+                              : Expr(op);
+    }
+
+    void visit(const ir::Cast* op) {
+      IRRewriter::visit(op);
+      if (isHalf(op->type)) {
+        expr = ir::Cast::make(to<ir::Cast>(expr)->a, Float32);
+      }
+    }
+
+    void visit(const Sizeof* op) {
+      expr = isHalf(op->sizeofType.getDataType()) ? Sizeof::make(UInt16)
+                                                   : Expr(op);
+    }
+
+    void visit(const GetProperty* op) {
+      expr = (op->property == TensorProperty::FillValue && isHalf(op->type))
+             ? toFloat(op) : Expr(op);
+    }
+
+    void visit(const Load* op) {
+      IRRewriter::visit(op);
+      if (isHalf(expr.type())) {
+        expr = toFloat(expr);
+      }
+    }
+
+    void visit(const Store* op) {
+      Expr arr = rewrite(op->arr);
+      Expr loc = rewrite(op->loc);
+      Expr data = rewrite(op->data);
+      if (isHalf(arr.type())) {
+        taco_uassert(!op->use_atomics) << "Atomic updates of "
+            << arr.type() << " values are not supported";
+        data = fromFloat(data, arr.type());
+      }
+      stmt = Store::make(arr, loc, data, op->use_atomics,
+                         op->atomic_parallel_unit);
+    }
+
+    void visit(const ir::Yield* op) {
+      IRRewriter::visit(op);
+      if (isHalf(op->val.type())) {
+        const ir::Yield* yield = to<ir::Yield>(stmt);
+        stmt = ir::Yield::make(yield->coords,
+                               fromFloat(yield->val, op->val.type()));
+      }
+    }
+  };
+  return WidenHalfPrecision().rewrite(stmt);
+}
+
 static bool returnsTrue(IndexExpr expr) {
   struct ReturnsTrue : public IndexExprRewriterStrict {
     void visit(const AccessNode* op) {
@@ -195,6 +408,65 @@ static bool needComputeValues(IndexStmt stmt, TensorVar tensor) {
   return needComputeValue;
 }
 
+/// Returns the locations of the workspaces of `stmt`, where the workspaces of
+/// serial loops that are nested in a loop parallelized over CPU threads are
+/// moved to the parallel loop.  The parallel loop allocates one workspace per
+/// thread once, instead of every iteration of the parallel loop allocating
+/// (and e.g. clearing the bit guards of) a workspace of its own.  Hash and
+/// heap workspaces grow as they are filled, so they cannot be carved out of
+/// one allocation for all threads and are never located at parallel loops.
+static std::map<Forall, Where> 
+hoistTemporariesToThreads(IndexStmt stmt, 
+                          const std::map<Forall, Where>& locations) {
+  if (should_use_CUDA_codegen()) {
+    return locations;
+  }
+
+  std::map<Forall, Forall> parallelAncestors;
+  Forall parallelForall;
+  match(stmt,
+    function<void(const ForallNode*,Matcher*)>([&](const ForallNode* op, 
+                                                   Matcher* ctx) {
+      if (op->parallel_unit == ParallelUnit::CPUThread) {
+        Forall enclosing = parallelForall;
+        parallelForall = op;
+        ctx->match(op->stmt);
+        parallelForall = enclosing;
+        return;
+      }
+      if (parallelForall.defined()) {
+        parallelAncestors.insert({op, parallelForall});
+      }
+      ctx->match(op->stmt);
+    })
+  );
+
+  std::map<Forall, Where> hoisted;
+  for (const auto& location : locations) {
+    const Forall& forall = location.first;
+    Where where = location.second;
+    if (where.getTemporary().getWorkspaceStrategy() != 
+        WorkspaceStrategy::Dense) {
+      if (forall.getParallelUnit() != ParallelUnit::CPUThread) {
+        hoisted.insert(location);
+      }
+      continue;
+    }
+    if (forall.getParallelUnit() == ParallelUnit::NotParallel &&
+        util::contains(parallelAncestors, forall) && 
+        !isScalar(where.getTemporary().getType())) {
+      const Forall& parallelAncestor = parallelAncestors.at(forall);
+      if (!util::contains(locations, parallelAncestor) &&
+          !util::contains(hoisted, parallelAncestor)) {
+        hoisted.insert({parallelAncestor, where});
+        continue;
+      }
+    }
+    hoisted.insert(location);
+  }
+  return hoisted;
+}
+
 /// Returns the set of result tensors that is assembled by inserting a sparse 
 /// set of coordinates (meaning they will not be fully initialized without an 
 /// explicit zero-initialization loop).
@@ -237,6 +509,7 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
   this->assemble = assemble;
   this->compute = compute;
   definedIndexVarsOrdered = {};
+  stmt = replaceHashedWorkspaces(stmt);
   definedIndexVars = {};
   loopOrderAllowsShortCircuit = allForFreeLoopsBeforeAllReductionLoops(stmt);
 
@@ -259,7 +532,8 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
       getAssembledByUngroupedInsertion(stmt));
 
   // Create datastructure needed for temporary workspace hoisting/reuse
-  temporaryInitialization = getTemporaryLocations(stmt);
+  temporaryInitialization = hoistTemporariesToThreads(stmt, 
+      getTemporaryLocations(stmt));
 
   // Convert tensor results and arguments IR variables
   map<TensorVar, Expr> resultVars;
@@ -342,6 +616,11 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
         // If the mode has an index set, then the dimension is the size of
         // the index set.
         return ir::Literal::make(a.getIndexSet(mode).size());
+      } else if (getFixedBlockSize(tv, mode) > 0) {
+        // Iterating over dense blocks of constant size (e.g. in BCSR) with
+        // constant bounds lets their loops be unrolled.
+        fixedBlockSizes[indexVar] = getFixedBlockSize(tv, mode);
+        return ir::Literal::make(getFixedBlockSize(tv, mode));
       } else {
         return GetProperty::make(tensorVars.at(tv), TensorProperty::Dimension, mode);
       }
@@ -366,7 +645,8 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
           int loc = (int)distance(indexVars.begin(),
                                   find(indexVars.begin(),indexVars.end(),
                                        indexVar));
-          if(!util::contains(temporariesSet, n->tensorVar)) {
+          if(!util::contains(temporariesSet, n->tensorVar) &&
+             !isa<ir::Literal>(dimension)) {
             dimension = getDimension(n->tensorVar, Access(n), loc);
           }
         }
@@ -376,6 +656,18 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
     underivedBounds.insert({indexVar, {ir::Literal::make(0), dimension}});
   }
 
+  // Scalar results that are reduced in an accumulator type are stored in a
+  // variable of that type
+  match(stmt,
+    function<void(const AssignmentNode*)>([&](const AssignmentNode* n) {
+      const TensorVar result = n->lhs.getTensorVar();
+      if (isScalar(result.getType()) && util::contains(results, result) &&
+          n->accumulatorType.getKind() != Datatype::Undefined) {
+        scalarAccumulatorTypes.insert({result, n->accumulatorType});
+      }
+    })
+  );
+
   // Define and initialize scalar results and arguments
   if (generateComputeCode()) {
     for (auto& result : results) {
@@ -423,6 +715,11 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
   if (generateComputeCode())
     body = rewriteTemporaryGP(body, temporaries, temporarySizeMap);
 
+  // Unroll loops in the IR, since C compilers do not reliably honor unroll
+  // pragmas (GPU loops keep their pragmas)
+  if (!should_use_CUDA_codegen())
+    body = unrollLoops(body);
+
   // Store scalar stack variables back to results
   if (generateComputeCode()) {
     for (auto& result : results) {
@@ -438,12 +735,13 @@ LowererImplImperative::lower(IndexStmt stmt, string name,
   }
 
   // Create function
+  Stmt functionBody = Block::blanks(Block::make(header),
+                                    initializeResults,
+                                    body,
+                                    finalizeResults,
+                                    Block::make(footer));
   return Function::make(name, resultsIR, argumentsIR,
-                        Block::blanks(Block::make(header),
-                                      initializeResults,
-                                      body,
-                                      finalizeResults,
-                                      Block::make(footer)));
+                        widenHalfPrecision(functionBody));
 }
 
 
@@ -459,12 +757,19 @@ Stmt LowererImplImperative::lowerAssignment(Assignment assignment)
 
   Expr rhs;
   if (needComputeAssign) {
+    Datatype enclosingAccumulatorType = accumulatorType;
+    accumulatorType = assignment.getAccumulatorType();
     rhs = lower(assignment.getRhs());
+    accumulatorType = enclosingAccumulatorType;
   }
 
   // Assignment to scalar variables.
   if (isScalar(result.getType())) {
-    if (needComputeAssign) {
+    if (needComputeAssign && util::contains(privatizedResultValues, result)) {
+      taco_iassert(isa<taco::Add>(assignment.getOperator()));
+      computeStmt = compoundStore(privatizedResultValues.at(result), 0, rhs);
+    }
+    else if (needComputeAssign) {
       if (!assignment.getOperator().defined()) {
         computeStmt = Assign::make(var, rhs);
       }
@@ -543,6 +848,9 @@ Stmt LowererImplImperative::lowerAssignment(Assignment assignment)
         }
       }
       taco_iassert(computeStmt.defined());
+    } else if (needComputeAssign && isPattern(result)) {
+      // Pattern results only store the coordinates of components
+      computeStmt = Block::make();
     }
 
     if (!accessStmts.empty()) {
@@ -551,6 +859,15 @@ Stmt LowererImplImperative::lowerAssignment(Assignment assignment)
     }
   }
 
+  // Tensors that store one triangle of a symmetric tensor also contribute
+  // every stored off-diagonal component as its mirrored component.
+  Access symmetricAccess = getSymmetricAccess(assignment.getRhs());
+  if (needComputeAssign && symmetricAccess.defined() && !isPattern(result)) {
+    computeStmt = Block::make(computeStmt,
+                              lowerMirroredAssignment(assignment,
+                                                      symmetricAccess, rhs));
+  }
+
   if (util::contains(guardedTemps, result) && result.getOrder() == 0) {
     Expr guard = tempToBitGuard[result];
     Stmt setGuard = Assign::make(guard, true, markAssignsAtomicDepth > 0,
@@ -577,6 +894,25 @@ Stmt LowererImplImperative::lowerAssignment(Assignment assignment)
     Expr values = getValuesArray(result);
     Expr loc = generateValueLocExpr(assignment.getLhs());
 
+    if (util::contains(tempToSparseAccumulator, result)) {
+      taco_uassert(result.getWorkspaceStrategy() != WorkspaceStrategy::Heap ||
+                   !assignment.getOperator().defined() ||
+                   isa<taco::Add>(assignment.getOperator()))
+          << "Heap workspaces can only be accumulated by additions: "
+          << assignment;
+      Stmt firstUpdate;
+      if (needComputeAssign && values.defined()) {
+        firstUpdate = Store::make(values, loc, rhs);
+      }
+      IndexVar indexVar = assignment.getLhs().getIndexVars()[0];
+      computeStmt = lowerSparseAccumulatorUpdate(
+          result, indexVarToExprMap.at(indexVar), firstUpdate,
+          (needComputeAssign && values.defined()) ? computeStmt : Stmt());
+      return assembleGuardTrivial ? computeStmt 
+                                  : IfThenElse::make(assembleGuard, 
+                                                     computeStmt);
+    }
+
     Expr bitGuardArr = tempToBitGuard.at(result);
     Expr indexList = tempToIndexList.at(result);
     Expr indexListSize = tempToIndexListSize.at(result);
@@ -607,6 +943,91 @@ Stmt LowererImplImperative::lowerAssignment(Assignment assignment)
 }
 
 
+Stmt LowererImplImperative::lowerMirroredAssignment(Assignment assignment,
+                                                    Access symmetricAccess,
+                                                    Expr rhs) {
+  TensorVar tensor = symmetricAccess.getTensorVar();
+  taco_uassert(isa<taco::Add>(assignment.getOperator()) &&
+               hasFactor(assignment.getRhs(), tensor)) <<
+      "Symmetric tensors can only be read by reductions of products: " <<
+      assignment;
+  taco_uassert(inParallelLoopDepth == 0 || markAssignsAtomicDepth > 0) <<
+      "Loops over symmetric tensors can only be parallelized with atomics " <<
+      "since every component updates two result components";
+
+  const std::vector<int>& modes = tensor.getFormat().getSymmetricModes();
+  IndexVar rowVar = symmetricAccess.getIndexVars()[modes[0]];
+  IndexVar colVar = symmetricAccess.getIndexVars()[modes[1]];
+  taco_uassert(rowVar != colVar) <<
+      "The diagonal of symmetric tensors cannot be accessed: " << assignment;
+  Expr row = getCoordinateVar(rowVar);
+  Expr col = getCoordinateVar(colVar);
+
+  // The mirrored update swaps the symmetric coordinates and locates the
+  // mirrored components of the other operands and the result.
+  std::map<Expr,Expr> substitutions = {{row, col}, {col, row}};
+  std::vector<Access> accesses = {assignment.getLhs()};
+  match(assignment.getRhs(),
+    std::function<void(const AccessNode*)>([&](const AccessNode* op) {
+      if (op->tensorVar != tensor) {
+        accesses.push_back(op);
+      }
+    })
+  );
+  for (const Access& access : accesses) {
+    if (access.getTensorVar().getOrder() == 0) {
+      continue;
+    }
+    Expr parentPos = 0;
+    for (const Iterator& iterator : getIterators(access)) {
+      taco_uassert(iterator.hasLocate() && !iterator.isWindowed() &&
+                   !iterator.hasIndexSet()) <<
+          "Operands of symmetric tensors must be dense: " << access;
+      std::vector<Expr> coords;
+      for (const Expr& coord : coordinates(iterator)) {
+        coords.push_back((coord == row) ? col : (coord == col) ? row : coord);
+      }
+      ModeFunction locate = iterator.locate(parentPos, coords);
+      taco_uassert(!locate.compute().defined() && isValue(locate[1], true)) <<
+          "Operands of symmetric tensors must be dense: " << access;
+      Expr pos = ir::simplify(locate[0]);
+      substitutions.insert({iterator.getPosVar(), pos});
+      parentPos = pos;
+    }
+  }
+
+  struct SubstituteVars : public IRRewriter {
+    const std::map<Expr,Expr>& substitutions;
+    SubstituteVars(const std::map<Expr,Expr>& substitutions)
+        : substitutions(substitutions) {}
+
+    using IRRewriter::visit;
+
+    void visit(const Var* op) {
+      auto it = substitutions.find(op);
+      expr = (it != substitutions.end()) ? it->second : op;
+    }
+  };
+  SubstituteVars substitute(substitutions);
+  Expr mirroredRhs = substitute.rewrite(rhs);
+
+  TensorVar result = assignment.getLhs().getTensorVar();
+  Stmt mirroredStmt;
+  if (isScalar(result.getType())) {
+    bool useAtomics = markAssignsAtomicDepth > 0 &&
+                      !util::contains(whereTemps, result);
+    mirroredStmt = compoundAssign(getTensorVar(result), mirroredRhs,
+                                  useAtomics, atomicParallelUnit);
+  } else {
+    Expr loc = substitute.rewrite(generateValueLocExpr(assignment.getLhs()));
+    mirroredStmt = compoundStore(getValuesArray(result), loc, mirroredRhs,
+                                 markAssignsAtomicDepth > 0,
+                                 atomicParallelUnit);
+  }
+  return IfThenElse::make(Neq::make(row, col), mirroredStmt);
+}
+
+
 Stmt LowererImplImperative::lowerYield(Yield yield) {
   std::vector<Expr> coords;
   for (auto& indexVar : yield.getIndexVars()) {
@@ -646,11 +1067,24 @@ LowererImplImperative::splitAppenderAndInserters(const vector<Iterator>& results
 
 Stmt LowererImplImperative::lowerForall(Forall forall)
 {
+  // Serial loops over the dense levels of small fixed-size blocks are fully
+  // unrolled (see unrolledBlockSizeLimit) unless scheduled otherwise
+  if (forall.getUnrollFactor() == 0 &&
+      forall.getParallelUnit() == ParallelUnit::NotParallel &&
+      util::contains(fixedBlockSizes, forall.getIndexVar())) {
+    forall = Forall(forall.getIndexVar(), forall.getStmt(),
+                    forall.getMergeStrategy(), forall.getParallelUnit(),
+                    forall.getOutputRaceStrategy(),
+                    fixedBlockSizes.at(forall.getIndexVar()));
+  }
+
   bool hasExactBound = provGraph.hasExactBound(forall.getIndexVar());
   bool forallNeedsUnderivedGuards = !hasExactBound && emitUnderivedGuards;
   if (!ignoreVectorize && forallNeedsUnderivedGuards &&
       (forall.getParallelUnit() == ParallelUnit::CPUVector ||
-       forall.getUnrollFactor() > 0)) {
+       (forall.getUnrollFactor() > 0 &&
+        !provGraph.isUnderived(forall.getIndexVar())) ||
+       provGraph.getTailStrategy(forall.getIndexVar()) == TailStrategy::Peel)) {
     return lowerForallCloned(forall);
   }
 
@@ -758,6 +1192,16 @@ Stmt LowererImplImperative::lowerForall(Forall forall)
   }
   Stmt recoveryStmt = Block::make(recoverySteps);
 
+  // Threads of loops that resolve output races with temporaries accumulate
+  // into private copies of the results that the iterations reduce into
+  vector<Stmt> privatizedResults = {Stmt(), Stmt(), Stmt()};
+  if (forall.getParallelUnit() == ParallelUnit::CPUThread &&
+      forall.getOutputRaceStrategy() == OutputRaceStrategy::Temporary &&
+      !should_use_CUDA_codegen() && generateComputeCode()) {
+    privatizedResults = codeToPrivatizeResults(forall);
+    recoveryStmt = Block::make(privatizedResults[1], recoveryStmt);
+  }
+
   taco_iassert(!definedIndexVars.count(forall.getIndexVar()));
   definedIndexVars.insert(forall.getIndexVar());
   definedIndexVarsOrdered.push_back(forall.getIndexVar());
@@ -867,6 +1311,15 @@ Stmt LowererImplImperative::lowerForall(Forall forall)
       loops = Stmt();
     }
   }
+  // Emit loops that merge multiple iterators in partitions of the merged
+  // coordinates, one per thread
+  else if (forall.getMergeStrategy() == MergeStrategy::MergePath &&
+           forall.getParallelUnit() == ParallelUnit::CPUThread &&
+           provGraph.isUnderived(forall.getIndexVar())) {
+    loops = lowerMergeLatticePartitioned(forall, caseLattice, 
+                                         forall.getIndexVar(), 
+                                         reducedAccesses);
+  }
   // Emit general loops to merge multiple iterators
   else {
     std::vector<IndexVar> underivedAncestors = provGraph.getUnderivedAncestors(forall.getIndexVar());
@@ -890,9 +1343,14 @@ Stmt LowererImplImperative::lowerForall(Forall forall)
     parallelUnitIndexVars.erase(forall.getParallelUnit());
     parallelUnitSizes.erase(forall.getParallelUnit());
   }
+  for (auto& result : getResults(forall)) {
+    privatizedResultValues.erase(result);
+  }
   return Block::blanks(preInitValues,
                        temporaryValuesInitFree[0],
+                       privatizedResults[0],
                        loops,
+                       privatizedResults[2],
                        temporaryValuesInitFree[1]);
 }
 
@@ -1164,6 +1622,11 @@ Stmt LowererImplImperative::searchForFusedPositionStart(Forall forall, Iterator
     else {
       underivedStartTarget = this->iterators.modeIterator(underivedAncestors[i+1]).getPosVar();
     }
+    // The segments of levels that store runs (e.g. run-length levels) are 
+    // ranges of runs rather than of positions.
+    if (posIteratorLevel.hasRunIter()) {
+      underivedStartTarget = posIteratorLevel.runLocate(underivedStartTarget)[0];
+    }
 
     vector<Expr> binarySearchArgs = {
             posIteratorLevel.getMode().getModePack().getArray(0), // array
@@ -1187,6 +1650,39 @@ Stmt LowererImplImperative::searchForFusedPositionStart(Forall forall, Iterator
   return ir::Block::make(searchForUnderivedStart);
 }
 
+Expr LowererImplImperative::getSegmentedReductionLoc(Access result, 
+    vector<IndexVar> underivedAncestors) {
+  TensorVar tensor = result.getTensorVar();
+  for (const auto& modeFormat : tensor.getFormat().getModeFormats()) {
+    if (modeFormat != Dense) {
+      return Expr();
+    }
+  }
+
+  // The segment of a result component ends when the coordinate of any fused 
+  // ancestor but the innermost one changes, which happens at the end of a 
+  // segment of the parent of the iterated level.
+  const vector<IndexVar> segmentVars(underivedAncestors.begin(), 
+                                     underivedAncestors.end() - 1);
+  const vector<IndexVar>& indexVars = result.getIndexVars();
+  for (const auto& indexVar : indexVars) {
+    if (util::contains(underivedAncestors, indexVar) ? 
+        !util::contains(segmentVars, indexVar) : 
+        !util::contains(definedIndexVars, indexVar)) {
+      return Expr();
+    }
+  }
+
+  Expr loc = 0;
+  Expr tensorExpr = getTensorVar(tensor);
+  for (int mode : tensor.getFormat().getModeOrdering()) {
+    Expr coord = getCoordinateVar(indexVars[mode]);
+    Expr size = GetProperty::make(tensorExpr, TensorProperty::Dimension, mode);
+    loc = ir::simplify(ir::Add::make(ir::Mul::make(loc, size), coord));
+  }
+  return loc;
+}
+
 Stmt LowererImplImperative::lowerForallDimension(Forall forall,
                                        vector<Iterator> locators,
                                        vector<Iterator> inserters,
@@ -1254,7 +1750,6 @@ Stmt LowererImplImperative::lowerForallDimension(Forall forall,
 
     Expr indexList = tempToIndexList.at(var);
     Expr indexListSize = tempToIndexListSize.at(var);
-    Expr bitGuard = tempToBitGuard.at(var);
     Expr loopVar = ir::Var::make(var.getName() + "_index_locator", taco::Int32, false, false);
     Expr coordinate = getCoordinateVar(forall.getIndexVar());
 
@@ -1265,12 +1760,39 @@ Stmt LowererImplImperative::lowerForallDimension(Forall forall,
 
     Stmt declareVar = VarDecl::make(coordinate, Load::make(indexList, loopVar));
     Stmt body = lowerForallBody(coordinate, forall.getStmt(), locators, inserters, appenders, caseLattice, reducedAccesses, forall.getMergeStrategy());
-    Stmt resetGuard = ir::Store::make(bitGuard, coordinate, ir::Literal::make(false), markAssignsAtomicDepth > 0, atomicParallelUnit);
+    Stmt resetGuard;
+    if (!util::contains(tempToSparseAccumulator, var)) {
+      Expr bitGuard = tempToBitGuard.at(var);
+      resetGuard = ir::Store::make(bitGuard, coordinate, ir::Literal::make(false), markAssignsAtomicDepth > 0, atomicParallelUnit);
+    }
 
     if (forall.getParallelUnit() != ParallelUnit::NotParallel && forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
       markAssignsAtomicDepth--;
     }
 
+    if (util::contains(tempToSparseAccumulator, var)) {
+      const SparseAccumulatorArrays& arrays = tempToSparseAccumulator.at(var);
+      if (var.getWorkspaceStrategy() == WorkspaceStrategy::Heap) {
+        return Block::blanks(lowerForallHeapAccumulator(forall, var, 
+                                 Block::make(recoveryStmt, body)),
+                             generateAppendPositions(appenders));
+      }
+
+      // Sorting the index list separates coordinates from the locations of 
+      // their values, which are then looked up in the hash table.
+      Expr loc = loopVar;
+      if (arrays.sorted) {
+        Expr slot = ir::Call::make("taco_hash_locate", 
+                                   {arrays.hashKeys, 0, arrays.hashSize,
+                                    coordinate}, Int32);
+        loc = Load::make(arrays.hashLocs, slot);
+      }
+      body = Block::make(declareVar, VarDecl::make(arrays.loc, loc), 
+                         recoveryStmt, body);
+      return Block::blanks(For::make(loopVar, 0, indexListSize, 1, body),
+                           generateAppendPositions(appenders));
+    }
+
     body = Block::make(declareVar, recoveryStmt, body, resetGuard);
 
     Stmt posAppend = generateAppendPositions(appenders);
@@ -1313,9 +1835,56 @@ Stmt LowererImplImperative::lowerForallPosition(Forall forall, Iterator iterator
   Stmt declareCoordinate = Stmt();
   Stmt strideGuard = Stmt();
   Stmt boundsGuard = Stmt();
-  if (provGraph.isCoordVariable(forall.getIndexVar())) {
-    Expr coordinateArray = iterator.posAccess(iterator.getPosVar(),
-                                              coordinates(iterator)).getResults()[0];
+  Expr found = true;
+
+  // Levels that mark their positions with the bits of 64-bit words (e.g. 
+  // bitmaps) are iterated by scanning the set bits of each word.
+  const bool iterateWords = iterator.hasWordIter() &&
+      provGraph.isUnderived(iterator.getIndexVar()) &&
+      !iterator.isWindowed() && !iterator.hasIndexSet() &&
+      (iterator.getParent().isRoot() || iterator.getParent().isUnique()) &&
+      (forall.getParallelUnit() == ParallelUnit::NotParallel ||
+       forall.getParallelUnit() == ParallelUnit::CPUThread);
+  // Levels that store runs of consecutive coordinates (e.g. run-length 
+  // levels) are iterated one run at a time, which decodes coordinates by 
+  // adding an offset to positions.
+  const bool iterateRuns = !iterateWords && iterator.hasRunIter() &&
+      provGraph.isUnderived(iterator.getIndexVar()) &&
+      !iterator.isWindowed() && !iterator.hasIndexSet() &&
+      (iterator.getParent().isRoot() || iterator.getParent().isUnique()) &&
+      (forall.getParallelUnit() == ParallelUnit::NotParallel ||
+       forall.getParallelUnit() == ParallelUnit::CPUThread);
+  Expr wordPos, bit, runPos, crdOffset;
+  if (iterateRuns) {
+    runPos = Var::make(util::toString(iterator.getPosVar()) + "_run", Int());
+    crdOffset = Var::make(util::toString(iterator.getPosVar()) + 
+                          "_crd_offset", Int());
+    declareCoordinate = VarDecl::make(coordinate, 
+        ir::Add::make(iterator.getPosVar(), crdOffset));
+  }
+  else if (iterateWords) {
+    wordPos = Var::make(util::toString(iterator.getPosVar()) + "_word_pos",
+                        Int());
+    bit = Var::make(util::toString(iterator.getPosVar()) + "_bit", Int());
+    ModeFunction bitLocate = iterator.wordLocate(
+        iterator.getParent().getPosVar(), wordPos, bit);
+    declareCoordinate = VarDecl::make(coordinate, bitLocate[1]);
+  }
+  else if (provGraph.isCoordVariable(forall.getIndexVar())) {
+    ModeFunction posAccess = iterator.posAccess(iterator.getPosVar(),
+                                                coordinates(iterator));
+    Expr coordinateArray = posAccess[0];
+    // Levels that store empty positions (e.g. hashed levels) report whether a
+    // position holds a coordinate.
+    found = posAccess[1];
+    // Padded levels may also report a coordinate that can be accessed at 
+    // padding positions, which lets us drop the check for padding when 
+    // padding cannot change the result.
+    if (posAccess.numResults() > 2 &&
+        isPaddingInert(forall, iterator, caseLattice, inserters, appenders)) {
+      coordinateArray = posAccess[2];
+      found = true;
+    }
     // If the iterator is windowed, we must recover the coordinate index
     // variable from the windowed space.
     if (iterator.isWindowed()) {
@@ -1347,6 +1916,9 @@ Stmt LowererImplImperative::lowerForallPosition(Forall forall, Iterator iterator
   }
 
   body = Block::make(recoveryStmt, body);
+  if (!isValue(found, true)) {
+    body = IfThenElse::make(found, body);
+  }
 
   // Code to append positions
   Stmt posAppend = generateAppendPositions(appenders);
@@ -1392,7 +1964,12 @@ Stmt LowererImplImperative::lowerForallPosition(Forall forall, Iterator iterator
   }
 
   Stmt loop = Block::make(strideGuard, declareCoordinate, boundsGuard, body);
-  if (iterator.isBranchless() && iterator.isCompact() && 
+  if (iterateWords) {
+    loop = lowerWordIteration(forall, iterator, locators, caseLattice, 
+                              wordPos, bit, loop);
+  } else if (iterateRuns) {
+    loop = lowerRunIteration(forall, iterator, runPos, crdOffset, loop);
+  } else if (iterator.isBranchless() && iterator.isCompact() && 
       (iterator.getParent().isRoot() || iterator.getParent().isUnique())) {
     loop = Block::make(VarDecl::make(iterator.getPosVar(), startBound), loop);
   } else {
@@ -1415,6 +1992,128 @@ Stmt LowererImplImperative::lowerForallPosition(Forall forall, Iterator iterator
   return Block::blanks(boundsCompute, loop, posAppend);
 }
 
+Stmt LowererImplImperative::lowerWordIteration(Forall forall, 
+                                               Iterator iterator,
+                                               vector<Iterator> locators,
+                                               MergeLattice caseLattice,
+                                               Expr wordPos, Expr bit, 
+                                               Stmt body) {
+  Expr parentPos = iterator.getParent().getPosVar();
+  ModeFunction wordBounds = iterator.wordBounds(parentPos);
+  Expr word = Var::make(util::toString(iterator.getPosVar()) + "_word", UInt64);
+
+  // Intersect the words of the iterated level with the words of levels that 
+  // are located into, if the located levels must store a coordinate for the
+  // loop body to compute a nonzero.
+  Expr loadWord = iterator.wordAccess(wordPos)[0];
+  for (auto& locator : locators) {
+    Iterator locatorParent = locator.getParent();
+    if (!locator.hasWordIter() || 
+        locator.getIndexVar() != iterator.getIndexVar() ||
+        locator.isWindowed() || locator.hasIndexSet() ||
+        !(locatorParent.isRoot() || !locatorParent.hasLocate() || 
+          accessibleIterators.contains(locatorParent))) {
+      continue;
+    }
+    bool isRequired = true;
+    for (auto& point : caseLattice.points()) {
+      isRequired &= util::contains(point.locators(), locator) || 
+                    util::contains(point.iterators(), locator);
+    }
+    if (!isRequired) {
+      continue;
+    }
+    Expr locatorWordPos = ir::Add::make(
+        locator.wordBounds(locatorParent.getPosVar())[0],
+        ir::Sub::make(wordPos, wordBounds[0]));
+    loadWord = BitAnd::make(loadWord, locator.wordAccess(locatorWordPos)[0]);
+  }
+
+  ModeFunction bitLocate = iterator.wordLocate(parentPos, wordPos, bit);
+  Stmt scanBit = Block::make(
+      VarDecl::make(bit, ir::Call::make("taco_ctz", {word}, Int())),
+      VarDecl::make(iterator.getPosVar(), bitLocate[0]),
+      Assign::make(word, BitAnd::make(word, ir::Sub::make(word, 1))),
+      body);
+  Stmt scanWord = Block::make(
+      VarDecl::make(word, loadWord),
+      While::make(Neq::make(word, ir::Literal::zero(UInt64)), scanBit));
+
+  LoopKind kind = (forall.getParallelUnit() == ParallelUnit::CPUThread &&
+                   forall.getOutputRaceStrategy() != 
+                   OutputRaceStrategy::ParallelReduction)
+                  ? LoopKind::Runtime : LoopKind::Serial;
+  return Block::make(wordBounds.compute(),
+                     For::make(wordPos, wordBounds[0], wordBounds[1], 1, 
+                               scanWord, kind, forall.getParallelUnit()));
+}
+
+Stmt LowererImplImperative::lowerRunIteration(Forall forall, 
+                                              Iterator iterator, Expr runPos,
+                                              Expr crdOffset, Stmt body) {
+  Expr parentPos = iterator.getParent().getPosVar();
+  ModeFunction runBounds = iterator.runBounds(parentPos);
+  ModeFunction runAccess = iterator.runAccess(runPos);
+
+  // The positions of a run store consecutive coordinates, so the loop over
+  // them is free of loads of coordinates.
+  Stmt scanRun = Block::make(
+      runAccess.compute(),
+      VarDecl::make(crdOffset, ir::Sub::make(runAccess[2], runAccess[0])),
+      For::make(iterator.getPosVar(), runAccess[0], runAccess[1], 1, body));
+
+  LoopKind kind = (forall.getParallelUnit() == ParallelUnit::CPUThread &&
+                   forall.getOutputRaceStrategy() != 
+                   OutputRaceStrategy::ParallelReduction)
+                  ? LoopKind::Runtime : LoopKind::Serial;
+  return Block::make(runBounds.compute(),
+                     For::make(runPos, runBounds[0], runBounds[1], 1, 
+                               scanRun, kind, forall.getParallelUnit()));
+}
+
+bool LowererImplImperative::isPaddingInert(Forall forall, Iterator iterator,
+                                           MergeLattice caseLattice,
+                                           vector<Iterator> inserters,
+                                           vector<Iterator> appenders) {
+  if (!iterator.isPadded() || iterator.isWindowed() || !inserters.empty() ||
+      !appenders.empty() || caseLattice.points().size() != 1 ||
+      caseLattice.iterators().size() != 1) {
+    return false;
+  }
+
+  TensorVar tensor;
+  for (const auto& tensorVar : tensorVars) {
+    if (tensorVar.second == iterator.getTensor()) {
+      tensor = tensorVar.first;
+    }
+  }
+  if (!tensor.defined() || !equals(tensor.getFill(), 
+      taco::Literal::zero(tensor.getType().getDataType()))) {
+    return false;
+  }
+
+  // Padding stores the fill value, so it cannot change the result if every 
+  // statement adds a product of the padded tensor into a result that is not
+  // indexed by the loop variable.
+  bool inert = true;
+  bool hasAssignments = false;
+  match(forall.getStmt(),
+    function<void(const AssignmentNode*)>([&](const AssignmentNode* op) {
+      Assignment assignment(op);
+      hasAssignments = true;
+      inert = inert && assignment.getOperator().defined() &&
+              isa<taco::Add>(assignment.getOperator()) &&
+              !util::contains(assignment.getLhs().getIndexVars(),
+                              forall.getIndexVar()) &&
+              hasFactor(assignment.getRhs(), tensor);
+    }),
+    function<void(const YieldNode*)>([&](const YieldNode* op) {
+      inert = false;
+    })
+  );
+  return inert && hasAssignments;
+}
+
 Stmt LowererImplImperative::lowerForallFusedPosition(Forall forall, Iterator iterator,
                                       vector<Iterator> locators,
                                       vector<Iterator> inserters,
@@ -1509,18 +2208,70 @@ Stmt LowererImplImperative::lowerForallFusedPosition(Forall forall, Iterator ite
     loopsToTrackUnderived.push_back(loopToTrackUnderiveds);
   }
 
+  // Chunks of the nonzeros of fused loops that are computed by different 
+  // threads (e.g., by nonzero-balanced schedules) may split segments of 
+  // nonzeros that reduce into the same result component. Instead of 
+  // atomically updating the result for every nonzero, reductions into dense 
+  // results that are indexed by the fused ancestors (but not by the innermost 
+  // one) are accumulated in a scalar that is atomically added to the result 
+  // when the segment ends and, for the last segment of the chunk, after the 
+  // loop.
+  IndexStmt bodyStmt = forall.getStmt();
+  Expr rowAccumulator;
+  Stmt flushRow;
+  if (forall.getParallelUnit() == ParallelUnit::NotParallel &&
+      markAssignsAtomicDepth > 0 && !searchForUnderivedStart.empty() &&
+      isa<Assignment>(bodyStmt)) {
+    Assignment assignment = to<Assignment>(bodyStmt);
+    TensorVar result = assignment.getLhs().getTensorVar();
+    Expr resultLoc = getSegmentedReductionLoc(assignment.getLhs(), 
+                                              underivedAncestors);
+    if (resultLoc.defined() && assignment.getOperator().defined() &&
+        isa<taco::Add>(assignment.getOperator()) &&
+        util::contains(needCompute, result) && !isPattern(result) &&
+        !getSymmetricAccess(assignment.getRhs()).defined()) {
+      Datatype resultType = result.getType().getDataType();
+      Datatype type = (assignment.getAccumulatorType().getKind() != 
+                       Datatype::Undefined) ? assignment.getAccumulatorType()
+                                            : resultType;
+      TensorVar rowResult(result.getName() + "_row", Type(type));
+      rowAccumulator = Var::make(result.getName() + "_row", type);
+      tensorVars.insert({rowResult, rowAccumulator});
+      needCompute.insert(rowResult);
+      bodyStmt = Assignment(rowResult(), assignment.getRhs(), 
+                            assignment.getOperator(), 
+                            assignment.getAccumulatorType());
+
+      Expr flushValue = (type != resultType) 
+                        ? ir::Cast::make(rowAccumulator, resultType) 
+                        : rowAccumulator;
+      Stmt addRow = compoundStore(getValuesArray(result), resultLoc, 
+                                  flushValue, true, atomicParallelUnit);
+      flushRow = Block::make(addRow, 
+          Assign::make(rowAccumulator, ir::Literal::zero(type)));
+    }
+  }
+
   if (forall.getParallelUnit() != ParallelUnit::NotParallel && forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
     markAssignsAtomicDepth++;
   }
 
-  Stmt body = lowerForallBody(coordinate, forall.getStmt(),
+  const int enclosingAtomicDepth = markAssignsAtomicDepth;
+  if (rowAccumulator.defined()) {
+    markAssignsAtomicDepth = 0;
+  }
+  Stmt body = lowerForallBody(coordinate, bodyStmt,
                               locators, inserters, appenders, caseLattice, reducedAccesses, forall.getMergeStrategy());
+  markAssignsAtomicDepth = enclosingAtomicDepth;
 
   if (forall.getParallelUnit() != ParallelUnit::NotParallel && forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
     markAssignsAtomicDepth--;
   }
 
   body = Block::make(recoveryStmt, Block::make(loopsToTrackUnderived), body);
+  if (rowAccumulator.defined()) {
+    body = Block::make(body, IfThenElse::make(writeResultCond, flushRow));
+  }
 
   // Code to write results if using temporary and reset temporary
   if (!whereConsumers.empty() && whereConsumers.back().defined()) {
@@ -1569,13 +2320,24 @@ Stmt LowererImplImperative::lowerForallFusedPosition(Forall forall, Iterator ite
            && forall.getOutputRaceStrategy() != OutputRaceStrategy::ParallelReduction && !ignoreVectorize) {
     kind = LoopKind::Runtime;
   }
+  Stmt declareRowAccumulator, flushLastRow;
+  if (rowAccumulator.defined()) {
+    declareRowAccumulator = VarDecl::make(rowAccumulator, 
+        ir::Literal::zero(rowAccumulator.type()));
+    flushLastRow = IfThenElse::make(
+        Neq::make(rowAccumulator, ir::Literal::zero(rowAccumulator.type())), 
+        flushRow);
+  }
+
   // Loop with preamble and postamble
   return Block::blanks(boundsCompute,
                        Block::make(Block::make(searchForUnderivedStart),
+                       declareRowAccumulator,
                        For::make(indexVarToExprMap[iterator.getIndexVar()], startBound, endBound, 1,
                                  Block::make(declareCoordinate, body),
                                  kind,
-                                 ignoreVectorize ? ParallelUnit::NotParallel : forall.getParallelUnit(), ignoreVectorize ? 0 : forall.getUnrollFactor())),
+                                 ignoreVectorize ? ParallelUnit::NotParallel : forall.getParallelUnit(), ignoreVectorize ? 0 : forall.getUnrollFactor()),
+                       flushLastRow),
                        posAppend);
 
 }
@@ -1595,6 +2357,27 @@ Stmt LowererImplImperative::lowerMergeLattice(MergeLattice caseLattice, IndexVar
   vector<Iterator> mergers = loopLattice.points()[0].mergers();
   Stmt iteratorVarInits = codeToInitializeIteratorVars(loopLattice.iterators(), loopLattice.points()[0].rangers(), mergers, coordinate, coordinateVar);
 
+  Stmt mergeLoops = lowerMergeLoops(caseLattice, coordinate, coordinateVar,
+                                    statement, reducedAccesses, mergestrategy);
+
+  // Append position to the pos array
+  Stmt appendPositions = generateAppendPositions(appenders);
+
+  return Block::blanks(iteratorVarInits,
+                       mergeLoops,
+                       appendPositions);
+}
+
+Stmt LowererImplImperative::lowerMergeLoops(MergeLattice caseLattice,
+                                            Expr coordinate,
+                                            IndexVar coordinateVar,
+                                            IndexStmt statement,
+                                            const std::set<Access>& reducedAccesses,
+                                            MergeStrategy mergestrategy)
+{
+  MergeLattice loopLattice = caseLattice.getLoopLattice();
+  vector<Iterator> mergers = loopLattice.points()[0].mergers();
+
   // if modeiteratornonmerger then will be declared in codeToInitializeIteratorVars
   auto modeIteratorsNonMergers =
           filter(loopLattice.points()[0].iterators(), [mergers](Iterator it){
@@ -1612,14 +2395,109 @@ Stmt LowererImplImperative::lowerMergeLattice(MergeLattice caseLattice, IndexVar
     Stmt mergeLoop = lowerMergePoint(sublattice, coordinate, coordinateVar, zeroedStmt, reducedAccesses, resolvedCoordDeclared, mergestrategy);
     mergeLoopsVec.push_back(mergeLoop);
   }
-  Stmt mergeLoops = Block::make(mergeLoopsVec);
+  return Block::make(mergeLoopsVec);
+}
 
-  // Append position to the pos array
-  Stmt appendPositions = generateAppendPositions(appenders);
+Stmt LowererImplImperative::lowerMergeLatticePartitioned(Forall forall,
+                                                         MergeLattice caseLattice,
+                                                         IndexVar coordinateVar,
+                                                         const std::set<Access>& reducedAccesses)
+{
+  MergeLattice loopLattice = caseLattice.getLoopLattice();
+  Expr coordinate = getCoordinateVar(coordinateVar);
+  const string name = util::toString(coordinate);
+
+  // Every merged iterator is a position iterator over an ordered level 
+  // without duplicates (see SetMergeStrategy), so its position range is 
+  // narrowed to a range of coordinates by binary searching its coordinates.
+  vector<Iterator> mergers = loopLattice.iterators();
+  vector<Stmt> boundsStmts;
+  vector<Expr> begins, ends;
+  Expr mergeSize = 0;
+  for (auto& iterator : mergers) {
+    taco_iassert(iterator.hasPosIter() && iterator.isUnique());
+    ModeFunction bounds = iterator.posBounds(iterator.getParent().getPosVar());
+    Expr begin = Var::make(util::toString(iterator.getIteratorVar()) + "_begin", 
+                           Int());
+    Expr end = Var::make(util::toString(iterator.getIteratorVar()) + "_end", 
+                         Int());
+    boundsStmts.push_back(bounds.compute());
+    boundsStmts.push_back(VarDecl::make(begin, bounds[0]));
+    boundsStmts.push_back(VarDecl::make(end, bounds[1]));
+    begins.push_back(begin);
+    ends.push_back(end);
+    mergeSize = ir::Add::make(mergeSize, ir::Sub::make(end, begin));
+  }
+  Expr mergeSizeVar = Var::make(name + "_merge_size", Int());
+  Expr numParts = Var::make(name + "_merge_parts", Int());
+  boundsStmts.push_back(VarDecl::make(mergeSizeVar, ir::simplify(mergeSize)));
+  boundsStmts.push_back(VarDecl::make(numParts, 
+      ir::Call::make("omp_get_max_threads", {}, Int())));
+
+  // Returns the number of merged coordinates that are less than `crd`.
+  auto countBefore = [&](Expr crd) {
+    Expr count = 0;
+    for (size_t k = 0; k < mergers.size(); k++) {
+      Expr pos = ir::Call::make("taco_lowerBound", 
+          {getSearchableCoordArray(mergers[k]), begins[k], ends[k], crd}, 
+          Int());
+      count = ir::Add::make(count, ir::Sub::make(pos, begins[k]));
+    }
+    return ir::simplify(count);
+  };
 
-  return Block::blanks(iteratorVarInits,
-                       mergeLoops,
-                       appendPositions);
+  // Finds the splitter that starts partition `part`, which is the smallest 
+  // coordinate that is preceded by at least part/numParts of the merged 
+  // coordinates. Equal coordinates of different iterators are thus never 
+  // assigned to different partitions.
+  const vector<Expr> crdBounds = underivedBounds[coordinateVar];
+  auto searchSplitter = [&](Expr part, Expr splitter) {
+    Expr target = ir::Cast::make(ir::Div::make(
+        ir::Mul::make(ir::Cast::make(part, Int64), mergeSizeVar), numParts), 
+        Int());
+    Expr hi = Var::make(util::toString(splitter) + "_hi", Int());
+    Expr mid = Var::make(util::toString(splitter) + "_mid", Int());
+    Stmt search = While::make(Lt::make(splitter, hi), Block::make(
+        VarDecl::make(mid, ir::Add::make(splitter, 
+            ir::Div::make(ir::Sub::make(hi, splitter), 2))),
+        IfThenElse::make(Lt::make(countBefore(mid), target),
+                         Assign::make(splitter, ir::Add::make(mid, 1)),
+                         Assign::make(hi, mid))));
+    return Block::make(VarDecl::make(splitter, crdBounds[0]),
+                       VarDecl::make(hi, crdBounds[1]),
+                       search);
+  };
+
+  Expr part = Var::make(name + "_part", Int());
+  Expr partBegin = Var::make(name + "_part_begin", Int());
+  Expr partEnd = Var::make(name + "_part_end", Int());
+  vector<Stmt> partStmts;
+  partStmts.push_back(searchSplitter(part, partBegin));
+  partStmts.push_back(searchSplitter(ir::Add::make(part, 1), partEnd));
+  for (size_t k = 0; k < mergers.size(); k++) {
+    Expr crdArray = getSearchableCoordArray(mergers[k]);
+    partStmts.push_back(VarDecl::make(mergers[k].getIteratorVar(), 
+        ir::Call::make("taco_lowerBound", 
+                       {crdArray, begins[k], ends[k], partBegin}, Int())));
+    partStmts.push_back(VarDecl::make(mergers[k].getEndVar(), 
+        ir::Call::make("taco_lowerBound", 
+                       {crdArray, begins[k], ends[k], partEnd}, Int())));
+  }
+
+  if (forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
+    markAssignsAtomicDepth++;
+  }
+  Stmt mergeLoops = lowerMergeLoops(caseLattice, coordinate, coordinateVar, 
+                                    forall.getStmt(), reducedAccesses, 
+                                    forall.getMergeStrategy());
+  if (forall.getOutputRaceStrategy() == OutputRaceStrategy::Atomics) {
+    markAssignsAtomicDepth--;
+  }
+
+  Stmt partLoop = For::make(part, 0, numParts, 1, 
+                            Block::blanks(Block::make(partStmts), mergeLoops), 
+                            LoopKind::Static, ParallelUnit::CPUThread);
+  return Block::blanks(Block::make(boundsStmts), partLoop);
 }
 
 Stmt LowererImplImperative::lowerMergePoint(MergeLattice pointLattice,
@@ -1680,7 +2558,7 @@ Stmt LowererImplImperative::lowerMergePoint(MergeLattice pointLattice,
     Expr iteratorParentPos = iter.getParent().getPosVar();
     ModeFunction iterBounds = iter.posBounds(iteratorParentPos);
     vector<Expr> iterGallopArgs = {
-      iter.getMode().getModePack().getArray(1),
+      getSearchableCoordArray(iter),
       ivar, iterBounds[1],
       setMatch
     };
@@ -1688,7 +2566,7 @@ Stmt LowererImplImperative::lowerMergePoint(MergeLattice pointLattice,
     Expr indexIterParentPos = indexSetIter.getParent().getPosVar();
     ModeFunction indexIterBounds = indexSetIter.posBounds(indexIterParentPos);
     vector<Expr> indexGallopArgs = {
-      indexSetIter.getMode().getModePack().getArray(1),
+      getSearchableCoordArray(indexSetIter),
       indexVar, indexIterBounds[1],
       setMatch
     };
@@ -2076,7 +2954,8 @@ Stmt LowererImplImperative::lowerForallBody(Expr coordinate, IndexStmt stmt,
                                   MergeStrategy mergeStrategy) {
 
   // Inserter positions
-  Stmt declInserterPosVars = declLocatePosVars(inserters);
+  Stmt declInserterPosVars = Block::make(declLocatePosVars(inserters),
+                                         insertCoordinates(inserters));
 
   // Locate positions
   Stmt declLocatorPosVars = declLocatePosVars(locators);
@@ -2134,8 +3013,6 @@ Stmt LowererImplImperative::lowerForallBody(Expr coordinate, IndexStmt stmt,
 
   Stmt incr = Block::make(stmts);
 
-  // TODO: Emit code to insert coordinates
-
   return Block::make(initVals,
                      declInserterPosVars,
                      declLocatorPosVars,
@@ -2235,7 +3112,9 @@ vector<Stmt> LowererImplImperative::codeToInitializeDenseAcceleratorArrays(Where
   // no decl for shared memory
   Stmt alreadySetDecl = Stmt();
   Stmt indexListDecl = Stmt();
-  Stmt freeTemps = Block::make(Free::make(indexListArr), Free::make(alreadySetArr));
+  const bool pooled = poolWorkspaces();
+  Stmt freeTemps = pooled ? Stmt()
+                 : Block::make(Free::make(indexListArr), Free::make(alreadySetArr));
   if ((isa<Forall>(where.getProducer()) && inParallelLoopDepth == 0) || !should_use_CUDA_codegen()) {
     alreadySetDecl = VarDecl::make(alreadySetArr, ir::Literal::make(0));
     indexListDecl = VarDecl::make(indexListArr, ir::Literal::make(0));
@@ -2251,7 +3130,8 @@ vector<Stmt> LowererImplImperative::codeToInitializeDenseAcceleratorArrays(Where
     tempToBitGuard[temporary] = alreadySetArr;
   }
 
-  Stmt allocateIndexList = Allocate::make(indexListArr, bitGuardSize);
+  Stmt allocateIndexList = Allocate::make(indexListArr, bitGuardSize, false,
+                                          Expr(), false, pooled);
   if(should_use_CUDA_codegen()) {
     Stmt allocateAlreadySet = Allocate::make(alreadySetArr, bitGuardSize);
     Expr p = Var::make("p" + temporary.getName(), Int());
@@ -2260,9 +3140,17 @@ vector<Stmt> LowererImplImperative::codeToInitializeDenseAcceleratorArrays(Where
     Stmt zeroInitLoop = For::make(p, 0, bitGuardSize, 1, guardZeroInit, LoopKind::Serial);
     Stmt inits = Block::make(alreadySetDecl, indexListDecl, allocateAlreadySet, allocateIndexList, zeroInitLoop);
     return {inits, freeTemps};
+  } else if (pooled) {
+    // Kernels reset the guard of every coordinate in the index list, so pooled
+    // guards are only cleared when they are first allocated.
+    Stmt allocateAlreadySet = Allocate::make(alreadySetArr, bitGuardSize,
+                                             false, Expr(), true, true);
+    Stmt inits = Block::make(indexListDecl, allocateIndexList, alreadySetDecl,
+                             allocateAlreadySet);
+    return {inits, freeTemps};
   } else {
     Expr sizeOfElt = Sizeof::make(bitGuardType);
-    Expr callocAlreadySet = ir::Call::make("calloc", {bitGuardSize, sizeOfElt}, Int());
+    Expr callocAlreadySet = ir::Call::make("taco_calloc", {bitGuardSize, sizeOfElt}, Int());
     Stmt allocateAlreadySet = VarDecl::make(alreadySetArr, callocAlreadySet);
     Stmt inits = Block::make(indexListDecl, allocateIndexList, allocateAlreadySet);
     return {inits, freeTemps};
@@ -2270,6 +3158,191 @@ vector<Stmt> LowererImplImperative::codeToInitializeDenseAcceleratorArrays(Where
 
 }
 
+vector<Stmt> LowererImplImperative::codeToInitializeSparseAccumulator(Where where) {
+  TensorVar temporary = where.getTemporary();
+  const WorkspaceStrategy strategy = temporary.getWorkspaceStrategy();
+  const std::string name = temporary.getName();
+
+  // Hash and heap workspaces start small and grow with the number of values
+  // that are accumulated into them.
+  SparseAccumulatorArrays arrays;
+  arrays.loc = Var::make(name + "_loc", Int32);
+  arrays.capacity = Var::make(name + "_capacity", Int32);
+  vector<Stmt> inits = {VarDecl::make(arrays.capacity, 
+                                      ir::Literal::make(32, Int32))};
+  vector<Stmt> frees;
+
+  Expr indexList;
+  if (strategy == WorkspaceStrategy::Hash) {
+    indexList = Var::make(name + "_index_list", Int32, true, false);
+    arrays.hashKeys = Var::make(name + "_hash_keys", Int32, true, false);
+    arrays.hashLocs = Var::make(name + "_hash_locs", Int32, true, false);
+    arrays.hashSlots = Var::make(name + "_hash_slots", Int32, true, false);
+    arrays.hashSize = Var::make(name + "_hash_size", Int32);
+
+    // Hash tables have (at least) twice as many slots as values, so probes
+    // stay short. Empty slots store negative keys.
+    Expr hashSize = ir::Mul::make(arrays.capacity, 2);
+    inits.push_back(VarDecl::make(arrays.hashSize, hashSize));
+    for (const Expr& array : {indexList, arrays.hashSlots}) {
+      inits.push_back(VarDecl::make(array, ir::Literal::make(0)));
+      inits.push_back(Allocate::make(array, arrays.capacity));
+      frees.push_back(Free::make(array));
+    }
+    for (const Expr& array : {arrays.hashKeys, arrays.hashLocs}) {
+      inits.push_back(VarDecl::make(array, ir::Literal::make(0)));
+      inits.push_back(Allocate::make(array, arrays.hashSize));
+      frees.push_back(Free::make(array));
+    }
+    Expr slot = Var::make("p" + name + "_hash", Int32);
+    inits.push_back(For::make(slot, 0, arrays.hashSize, 1,
+                              Store::make(arrays.hashKeys, slot, -1)));
+  } else {
+    taco_iassert(strategy == WorkspaceStrategy::Heap);
+    indexList = Var::make(name + "_heap", Int32, true, false);
+    arrays.heap = indexList;
+    inits.push_back(VarDecl::make(indexList, ir::Literal::make(0)));
+    inits.push_back(Allocate::make(indexList,
+                                   ir::Mul::make(arrays.capacity, 2)));
+    frees.push_back(Free::make(indexList));
+  }
+  tempToIndexList[temporary] = indexList;
+  tempToIndexListSize[temporary] = Var::make(util::toString(indexList) +
+                                             "_size", Int32);
+
+  Expr values;
+  if (util::contains(needCompute, temporary) &&
+      needComputeValues(where, temporary)) {
+    values = Var::make(name, temporary.getType().getDataType(), true, false);
+    inits.push_back(VarDecl::make(values, ir::Literal::make(0)));
+    inits.push_back(Allocate::make(values, arrays.capacity));
+    frees.push_back(Free::make(values));
+  }
+  TemporaryArrays temporaryArrays;
+  temporaryArrays.values = values;
+  this->temporaryArrays.insert({temporary, temporaryArrays});
+
+  tempToSparseAccumulator[temporary] = arrays;
+  return {Block::make(inits), Block::make(frees)};
+}
+
+Stmt LowererImplImperative::lowerSparseAccumulatorUpdate(TensorVar temporary,
+                                                         Expr coordinate,
+                                                         Stmt firstUpdate,
+                                                         Stmt update) {
+  const SparseAccumulatorArrays& arrays =
+      tempToSparseAccumulator.at(temporary);
+  Expr values = getValuesArray(temporary);
+  Expr size = tempToIndexListSize.at(temporary);
+  Expr loc = arrays.loc;
+  Expr capacity = arrays.capacity;
+  Expr newCapacity = ir::Mul::make(capacity, 2);
+
+  // Doubles the capacity of the values and of the arrays that are indexed by
+  // value locations when they are full.
+  auto growIfFull = [&](vector<std::pair<Expr,int>> arrays) {
+    vector<Stmt> reallocs;
+    for (const auto& array : arrays) {
+      reallocs.push_back(Allocate::make(array.first,
+                                        ir::Mul::make(newCapacity,
+                                                      array.second),
+                                        true, capacity));
+    }
+    if (values.defined()) {
+      reallocs.push_back(Allocate::make(values, newCapacity, true, capacity));
+    }
+    reallocs.push_back(Assign::make(capacity, newCapacity));
+    return IfThenElse::make(Lte::make(capacity, size), Block::make(reallocs));
+  };
+
+  if (temporary.getWorkspaceStrategy() == WorkspaceStrategy::Heap) {
+    // Every update is pushed onto the heap as a new value, and values with
+    // the same coordinate are combined when they are popped.
+    Expr heap = arrays.heap;
+    Expr push = ir::Call::make("taco_heap_push", 
+                               {heap, size, coordinate, loc}, Int32);
+    return Block::make(VarDecl::make(loc, size),
+                       growIfFull({{heap, 2}}),
+                       firstUpdate,
+                       Assign::make(size, push));
+  }
+
+  taco_iassert(temporary.getWorkspaceStrategy() == WorkspaceStrategy::Hash);
+  const std::string name = temporary.getName();
+  Expr indexList = tempToIndexList.at(temporary);
+  Expr keys = arrays.hashKeys;
+  Expr locs = arrays.hashLocs;
+  Expr slots = arrays.hashSlots;
+  Expr hashSize = arrays.hashSize;
+
+  Expr slot = Var::make(name + "_slot", Int32);
+  Expr locate = ir::Call::make("taco_hash_locate", 
+                               {keys, 0, hashSize, coordinate}, Int32);
+
+  // Tables that get more than half full are doubled, and the coordinates in
+  // the index list are inserted again.
+  Expr p = Var::make("p" + name + "_hash", Int32);
+  Expr pcoord = Var::make(name + "_rehash_crd", Int32);
+  Expr pslot = Var::make(name + "_rehash_slot", Int32);
+  Expr pLocate = ir::Call::make("taco_hash_locate", 
+                                {keys, 0, hashSize, pcoord}, Int32);
+  Stmt rehash = Block::make(
+      Allocate::make(keys, ir::Mul::make(hashSize, 2), true, hashSize),
+      Allocate::make(locs, ir::Mul::make(hashSize, 2), true, hashSize),
+      Assign::make(hashSize, ir::Mul::make(hashSize, 2)),
+      For::make(p, 0, hashSize, 1, Store::make(keys, p, -1)),
+      For::make(p, 0, size, 1, Block::make(
+          VarDecl::make(pcoord, Load::make(indexList, p)),
+          VarDecl::make(pslot, pLocate),
+          Store::make(keys, pslot, pcoord),
+          Store::make(locs, pslot, p),
+          Store::make(slots, p, pslot))));
+
+  Stmt insert = Block::make({
+      growIfFull({{indexList, 1}, {slots, 1}}),
+      Assign::make(loc, size),
+      Store::make(keys, slot, coordinate),
+      Store::make(locs, slot, loc),
+      Store::make(indexList, loc, coordinate),
+      Store::make(slots, loc, slot),
+      firstUpdate,
+      Assign::make(size, ir::Add::make(size, 1)),
+      IfThenElse::make(Lt::make(hashSize, ir::Mul::make(size, 2)), rehash)});
+  Expr isNew = Lt::make(Load::make(keys, slot), 0);
+  return Block::make(VarDecl::make(slot, locate),
+                     VarDecl::make(loc, Load::make(locs, slot)),
+                     IfThenElse::make(isNew, insert, update));
+}
+
+Stmt LowererImplImperative::lowerForallHeapAccumulator(Forall forall,
+                                                       TensorVar temporary,
+                                                       Stmt body) {
+  const SparseAccumulatorArrays& arrays =
+      tempToSparseAccumulator.at(temporary);
+  Expr values = getValuesArray(temporary);
+  Expr heap = arrays.heap;
+  Expr size = tempToIndexListSize.at(temporary);
+  Expr loc = arrays.loc;
+  Expr coordinate = getCoordinateVar(forall.getIndexVar());
+
+  // Pops the smallest coordinate and adds the values of the coordinate that
+  // are next on the heap to its first value.
+  Expr pop = ir::Call::make("taco_heap_pop", {heap, size}, Int32);
+  Stmt combine = Block::make(
+      values.defined() 
+          ? compoundStore(values, loc, Load::make(values, Load::make(heap, 1)))
+          : Stmt(),
+      Assign::make(size, pop));
+  Expr sameCoordinate = And::make(Gt::make(size, 0),
+                                  Eq::make(Load::make(heap, 0), coordinate));
+  return While::make(Gt::make(size, 0), Block::make({
+      VarDecl::make(coordinate, Load::make(heap, 0)),
+      VarDecl::make(loc, Load::make(heap, 1)),
+      Assign::make(size, pop),
+      While::make(sameCoordinate, combine),
+      body}));
+}
+
 // Returns true if the following conditions are met:
 // 1) The temporary is a dense vector
 // 2) There is only one value on the right hand side of the consumer
@@ -2409,6 +3482,94 @@ vector<Stmt> LowererImplImperative::codeToInitializeLocalTemporaryParallel(Where
   return decls;
 }
 
+vector<Stmt> LowererImplImperative::codeToPrivatizeResults(Forall forall) {
+  // Find the results that the iterations of the loop reduce into, which
+  // excludes the workspaces of where statements nested in the loop
+  set<TensorVar> localTemporaries;
+  match(forall.getStmt(),
+    function<void(const WhereNode*)>([&](const WhereNode* op) {
+      localTemporaries.insert(Where(op).getTemporary());
+    })
+  );
+  const vector<IndexVar> underivedAncestors = 
+      provGraph.getUnderivedAncestors(forall.getIndexVar());
+  vector<TensorVar> results;
+  match(forall.getStmt(),
+    function<void(const AssignmentNode*)>([&](const AssignmentNode* op) {
+      const TensorVar result = op->lhs.getTensorVar();
+      if (util::contains(localTemporaries, result) ||
+          util::contains(whereTemps, result) ||
+          util::contains(results, result) ||
+          !util::contains(needCompute, result)) {
+        return;
+      }
+      for (const IndexVar& var : Assignment(op).getReductionVars()) {
+        if (util::contains(underivedAncestors, var)) {
+          results.push_back(result);
+          return;
+        }
+      }
+    })
+  );
+
+  vector<Stmt> allocate, declare, reduce;
+  for (const TensorVar& result : results) {
+    taco_iassert(isDense(result.getFormat()));
+    const Datatype type = result.getType().getDataType();
+    Expr tensor = getTensorVar(result);
+    const string name = result.getName();
+
+    // The private copies of scalars are padded to cache lines to keep threads
+    // from sharing them
+    Expr size = std::max(64 / (int)type.getNumBytes(), 1);
+    if (!isScalar(result.getType())) {
+      size = 1;
+      for (int mode = 0; mode < result.getOrder(); mode++) {
+        size = ir::Mul::make(size, 
+                             GetProperty::make(tensor, 
+                                               TensorProperty::Dimension, 
+                                               mode));
+      }
+      size = ir::simplify(size);
+    }
+
+    Expr numThreads = Var::make(name + "_num_threads", Int32);
+    Expr privateValues = Var::make(name + "_private_vals", type, true, false);
+    Expr threadValues = Var::make(name + "_thread_vals", type, true, false);
+    allocate.push_back(VarDecl::make(numThreads, 
+        ir::Call::make("omp_get_max_threads", {}, Int32)));
+    allocate.push_back(VarDecl::make(privateValues, ir::Literal::make(0)));
+    allocate.push_back(Allocate::make(privateValues, 
+                                      ir::Mul::make(numThreads, size),
+                                      false, Expr(), true));
+
+    Expr threadNum = ir::Call::make("omp_get_thread_num", {}, Int32);
+    declare.push_back(VarDecl::make(threadValues, 
+        ir::Add::make(privateValues, ir::Mul::make(threadNum, size))));
+
+    // Threads reduce the private copies of blocks of components
+    Expr thread = Var::make(name + "_thread", Int32);
+    if (isScalar(result.getType())) {
+      Expr privateLoc = ir::Mul::make(thread, size);
+      reduce.push_back(For::make(thread, 0, numThreads, 1, 
+          compoundAssign(tensor, Load::make(privateValues, privateLoc))));
+    } else {
+      Expr values = getValuesArray(result);
+      Expr p = Var::make("p" + name + "_private", Int32);
+      Expr privateLoc = ir::Add::make(ir::Mul::make(thread, size), p);
+      Stmt reduceThreads = For::make(thread, 0, numThreads, 1, 
+          compoundStore(values, p, Load::make(privateValues, privateLoc)));
+      reduce.push_back(For::make(p, 0, size, 1, reduceThreads, 
+                                 LoopKind::Static_Chunked, 
+                                 ParallelUnit::CPUThread));
+    }
+    reduce.push_back(Free::make(privateValues));
+
+    privatizedResultValues[result] = threadValues;
+  }
+  return {Block::make(allocate), Block::make(declare), Block::make(reduce)};
+}
+
 // Code to initialize a temporary workspace that is SHARED across ALL parallel units.
 // New temporaries are denoted by temporary.getName() + '_all'
 // Currently only supports CPUThreads
@@ -2445,9 +3606,13 @@ vector<Stmt> LowererImplImperative::codeToInitializeTemporaryParallel(Where wher
     if ((isa<Forall>(where.getProducer()) && inParallelLoopDepth == 0) || !should_use_CUDA_codegen()) {
       decl = VarDecl::make(values, ir::Literal::make(0));
     }
-    Stmt allocate = Allocate::make(values, sizeAll);
+    const bool pooled = poolWorkspaces();
+    Stmt allocate = Allocate::make(values, sizeAll, false, Expr(), false,
+                                   pooled);
 
-    freeTemporary = Block::make(freeTemporary, Free::make(values));
+    if (!pooled) {
+      freeTemporary = Block::make(freeTemporary, Free::make(values));
+    }
     initializeTemporary = Block::make(decl, initializeTemporary, allocate);
   }
   /// Make a struct object that lowerAssignment and lowerAccess can read
@@ -2477,6 +3642,11 @@ vector<Stmt> LowererImplImperative::codeToInitializeTemporary(Where where) {
     //       temporaries that don't have sparse accelerator
     taco_iassert(!util::contains(guardedTemps, temporary) || accelerateDense);
 
+    if (accelerateDense && 
+        temporary.getWorkspaceStrategy() != WorkspaceStrategy::Dense) {
+      return codeToInitializeSparseAccumulator(where);
+    }
+
     // When emitting code to accelerate dense workspaces with sparse iteration, we need the following arrays
     // to construct the result indices
     if(accelerateDense) {
@@ -2498,9 +3668,13 @@ vector<Stmt> LowererImplImperative::codeToInitializeTemporary(Where where) {
       if ((isa<Forall>(where.getProducer()) && inParallelLoopDepth == 0) || !should_use_CUDA_codegen()) {
         decl = VarDecl::make(values, ir::Literal::make(0));
       }
-      Stmt allocate = Allocate::make(values, size);
+      const bool pooled = poolWorkspaces();
+      Stmt allocate = Allocate::make(values, size, false, Expr(), false,
+                                     pooled);
 
-      freeTemporary = Block::make(freeTemporary, Free::make(values));
+      if (!pooled) {
+        freeTemporary = Block::make(freeTemporary, Free::make(values));
+      }
       initializeTemporary = Block::make(decl, initializeTemporary, allocate);
     }
 
@@ -2518,6 +3692,13 @@ Stmt LowererImplImperative::lowerWhere(Where where) {
   bool accelerateDenseWorkSpace, sortAccelerator;
   std::tie(accelerateDenseWorkSpace, sortAccelerator) =
       canAccelerateDenseTemp(where);
+  taco_uassert(accelerateDenseWorkSpace ||
+               temporary.getWorkspaceStrategy() == WorkspaceStrategy::Dense)
+      << "The workspace " << temporary.getName() << " is stored in a hash "
+      << "table or heap (e.g., because it has a hashed level), which is "
+      << "only supported for workspace vectors whose values are copied to "
+      << "a sparse result, but it is consumed by "
+      << where.getConsumer();
 
   // Declare and initialize the where statement's temporary
   vector<Stmt> temporaryValuesInitFree = {Stmt(), Stmt()};
@@ -2550,8 +3731,27 @@ Stmt LowererImplImperative::lowerWhere(Where where) {
         })
   );
 
+  const bool sparseAccumulator = 
+      util::contains(tempToSparseAccumulator, temporary);
+  if (sparseAccumulator) {
+    tempToSparseAccumulator.at(temporary).sorted = sortAccelerator;
+  }
+
   Stmt consumer = lower(where.getConsumer());
-  if (accelerateDenseWorkSpace && sortAccelerator) {
+  if (sparseAccumulator && 
+      temporary.getWorkspaceStrategy() == WorkspaceStrategy::Hash) {
+    // Clear the slots of the hash table that were filled
+    const SparseAccumulatorArrays& arrays = 
+        tempToSparseAccumulator.at(temporary);
+    Expr p = Var::make("p" + temporary.getName() + "_hash", Int32);
+    Stmt clearSlot = Store::make(arrays.hashKeys, 
+                                 Load::make(arrays.hashSlots, p), -1);
+    consumer = Block::make(consumer, 
+                           For::make(p, 0, tempToIndexListSize.at(temporary), 
+                                     1, clearSlot));
+  }
+  if (accelerateDenseWorkSpace && sortAccelerator &&
+      temporary.getWorkspaceStrategy() != WorkspaceStrategy::Heap) {
     // We need to sort the indices array
     Expr listOfIndices = tempToIndexList.at(temporary);
     Expr listOfIndicesSize = tempToIndexListSize.at(temporary);
@@ -2615,26 +3815,36 @@ Stmt LowererImplImperative::lowerSequence(Sequence sequence) {
 
 Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
   Stmt queries, freeQueryResults;
+  std::map<TensorVar, std::vector<Expr>> queryResultDims;
   if (generateAssembleCode() && assemble.getQueries().defined()) {
     std::vector<Stmt> allocStmts, freeStmts;
     const auto queryAccesses = getResultAccesses(assemble.getQueries()).first;
     for (const auto& queryAccess : queryAccesses) {
       const auto queryResult = queryAccess.getTensorVar();
+      const auto indexVars = queryAccess.getIndexVars();
       Expr values = ir::Var::make(queryResult.getName(),
                                   queryResult.getType().getDataType(),
-                                  true, false);
+                                  !indexVars.empty(), false);
 
       TemporaryArrays arrays;
       arrays.values = values;
       this->temporaryArrays.insert({queryResult, arrays});
 
+      // Scalar query results (e.g. of levels without a parent) are computed 
+      // into scalar variables
+      if (indexVars.empty()) {
+        const auto type = queryResult.getType().getDataType();
+        allocStmts.push_back(VarDecl::make(values, ir::Literal::zero(type)));
+        continue;
+      }
+
       // Compute size of query result
-      const auto indexVars = queryAccess.getIndexVars();
       taco_iassert(util::all(indexVars,
           [&](const auto& var) { return provGraph.isUnderived(var); }));
       Expr size = 1;
       for (const auto& indexVar : indexVars) {
         size = ir::Mul::make(size, getDimension(indexVar));
+        queryResultDims[queryResult].push_back(getDimension(indexVar));
       }
 
       const bool zeroInit = isNonFullyInitialized(getTensorVar(queryResult)) ||
@@ -2642,7 +3852,7 @@ Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
                          queryAccess);
       if (zeroInit) {
         Expr sizeOfElt = Sizeof::make(queryResult.getType().getDataType());
-        Expr callocValues = ir::Call::make("calloc", {size, sizeOfElt},
+        Expr callocValues = ir::Call::make("taco_calloc", {size, sizeOfElt},
                                            queryResult.getType().getDataType());
         Stmt allocResult = VarDecl::make(values, callocValues);
         allocStmts.push_back(allocResult);
@@ -2664,6 +3874,23 @@ Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
     queries = Block::blanks(allocResults, queries);
   }
 
+  // Attribute queries are computed in parallel if their outermost loop is 
+  // parallelized over CPU threads.  The matcher does not descend into the 
+  // loop it matches, so nested loops are never inspected.
+  bool parallelQueries = false;
+  if (assemble.getQueries().defined() && !should_use_CUDA_codegen()) {
+    bool foundOutermostLoop = false;
+    match(assemble.getQueries(),
+      function<void(const ForallNode*,Matcher*)>([&](const ForallNode* op, 
+                                                     Matcher* ctx) {
+        if (!foundOutermostLoop) {
+          parallelQueries = (op->parallel_unit == ParallelUnit::CPUThread);
+          foundOutermostLoop = true;
+        }
+      })
+    );
+  }
+
   vector<Access> resultAccesses;
   set<Access> reducedAccesses;
   std::tie(resultAccesses, reducedAccesses) = 
@@ -2685,7 +3912,8 @@ Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
         std::vector<AttrQueryResult> queryResults;
         for (const auto& queryResultVar : queryResultVars) {
           queryResults.emplace_back(getTensorVar(queryResultVar),
-                                    getValuesArray(queryResultVar));
+                                    getValuesArray(queryResultVar),
+                                    queryResultDims[queryResultVar]);
         }
 
         if (resultIterator.hasSeqInsertEdge()) {
@@ -2693,8 +3921,19 @@ Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
                                                           queryResults);
           initAssembleStmts.push_back(initEdges);
 
-          Stmt insertEdgeLoop = resultIterator.getSeqInsertEdge(
-              resultIterator.getParent().getPosVar(), coords, queryResults);
+          // If the attribute queries are computed in parallel, then so are 
+          // the edges of levels that can insert them in parallel.
+          Stmt insertEdge = parallelQueries 
+              ? resultIterator.getParInsertEdge(
+                    resultIterator.getParent().getPosVar(), coords, 
+                    queryResults) 
+              : Stmt();
+          const bool parallelInsertEdge = insertEdge.defined();
+          if (!parallelInsertEdge) {
+            insertEdge = resultIterator.getSeqInsertEdge(
+                resultIterator.getParent().getPosVar(), coords, queryResults);
+          }
+          Stmt insertEdgeLoop = insertEdge;
           auto locateCoords = coords;
           for (auto iter = resultIterator.getParent(); !iter.isRoot();
                iter = iter.getParent()) {
@@ -2704,14 +3943,25 @@ Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
                   resultModeOrdering[iter.getMode().getLevel() - 1]);
               Expr pos = iter.getPosVar();
               Stmt initPos = VarDecl::make(pos, iter.locate(locateCoords)[0]);
-              insertEdgeLoop = For::make(coords.back(), 0, dim, 1,
-                                         Block::make(initPos, insertEdgeLoop));
+              const bool outermost = iter.getParent().isRoot();
+              insertEdgeLoop = For::make(locateCoords.back(), 0, dim, 1,
+                                         Block::make(initPos, insertEdgeLoop),
+                                         (parallelInsertEdge && outermost)
+                                         ? LoopKind::Static_Chunked 
+                                         : LoopKind::Serial,
+                                         (parallelInsertEdge && outermost)
+                                         ? ParallelUnit::CPUThread 
+                                         : ParallelUnit::NotParallel);
             } else {
               taco_not_supported_yet;
             }
             locateCoords.pop_back();
           }
           initAssembleStmts.push_back(insertEdgeLoop);
+          if (parallelInsertEdge) {
+            initAssembleStmts.push_back(
+                resultIterator.getParFinalizeEdges(prevSize, queryResults));
+          }
         }
 
         Stmt initCoords = resultIterator.getInitCoords(prevSize, queryResults);
@@ -2725,14 +3975,18 @@ Stmt LowererImplImperative::lowerAssemble(Assemble assemble) {
       coords.push_back(getCoordinateVar(resultIterator));
     }
 
+    // Padded levels (e.g. ELL) allocate positions that are never inserted 
+    // into, which must hold the fill value.
     Expr valuesArr = getValuesArray(resultTensor);
     const bool zeroInit = isNonFullyInitialized(resultTensorVar) ||
-                          util::contains(reducedAccesses, resultAccess);
+                          util::contains(reducedAccesses, resultAccess) ||
+                          util::any(resultIterators, 
+                                    [](Iterator it) { return it.isPadded(); });
     if (generateAssembleCode()) {
       if (zeroInit && generateComputeCode()) {
         const auto type = resultTensor.getType().getDataType();
         Expr sizeOfElt = Sizeof::make(type);
-        Expr callocValues = ir::Call::make("calloc", {prevSize, sizeOfElt}, 
+        Expr callocValues = ir::Call::make("taco_calloc", {prevSize, sizeOfElt}, 
                                            type);
         Stmt allocResult = Assign::make(valuesArr, callocValues);
         initAssembleStmts.push_back(allocResult);
@@ -2798,12 +4052,26 @@ Expr LowererImplImperative::lowerAccess(Access access) {
 
   TensorVar var = access.getTensorVar();
 
+  // Values are converted to the accumulator type of the assignment when they
+  // are loaded, so that the whole right-hand side is computed in that type.
+  auto convert = [&](Expr value) {
+    return (accumulatorType.getKind() != Datatype::Undefined &&
+            accumulatorType != value.type())
+           ? ir::Cast::make(value, accumulatorType) : value;
+  };
+
   if (isScalar(var.getType())) {
-    return getTensorVar(var);
+    return convert(getTensorVar(var));
+  }
+
+  // Every stored component of a pattern tensor is one
+  if (isPattern(var) && !util::contains(temporaryArrays, var)) {
+    Datatype type = var.getType().getDataType();
+    return ir::Literal::make(TypedComponentVal(type, 1), type);
   }
 
   if (!getIterators(access).back().isUnique()) {
-    return getReducedValueVar(access);
+    return convert(getReducedValueVar(access));
   }
 
   if (var.getType().getDataType() == Bool &&
@@ -2816,7 +4084,7 @@ Expr LowererImplImperative::lowerAccess(Access access) {
     return true;
   }
 
-  return Load::make(vals, generateValueLocExpr(access));
+  return convert(loadValue(var, generateValueLocExpr(access)));
 }
 
 Expr LowererImplImperative::lowerIndexVar(IndexVar var) {
@@ -2851,6 +4119,10 @@ Expr LowererImplImperative::lowerLiteral(Literal literal) {
     case Datatype::Int128:
       taco_not_supported_yet;
       break;
+    case Datatype::Float16:
+      return ir::Literal::make(literal.getVal<float16>());
+    case Datatype::BFloat16:
+      return ir::Literal::make(literal.getVal<bfloat16>());
     case Datatype::Float32:
       return ir::Literal::make(literal.getVal<float>());
     case Datatype::Float64:
@@ -2977,9 +4249,30 @@ Expr LowererImplImperative::getCapacityVar(Expr tensor) const {
 
 ir::Expr LowererImplImperative::getValuesArray(TensorVar var) const
 {
-  return (util::contains(temporaryArrays, var))
-         ? temporaryArrays.at(var).values
-         : GetProperty::make(getTensorVar(var), TensorProperty::Values);
+  if (util::contains(privatizedResultValues, var)) {
+    return privatizedResultValues.at(var);
+  }
+  if (util::contains(temporaryArrays, var)) {
+    return temporaryArrays.at(var).values;
+  }
+  return isPattern(var) ? Expr()
+                        : GetProperty::make(getTensorVar(var),
+                                            TensorProperty::Values);
+}
+
+
+Expr LowererImplImperative::loadValue(TensorVar var, Expr loc) const {
+  if (!isDictionaryEncoded(var) || util::contains(temporaryArrays, var)) {
+    return Load::make(getValuesArray(var), loc);
+  }
+  // The values array of an encoded tensor stores the dictionary index of
+  // every value.
+  Expr tensor = getTensorVar(var);
+  Expr codes = GetProperty::make(tensor, TensorProperty::Values, 0, 0,
+                                 util::toString(tensor) + "_vals",
+                                 var.getFormat().getValueCodeType());
+  Expr dictionary = GetProperty::make(tensor, TensorProperty::ValuesDictionary);
+  return Load::make(dictionary, Load::make(codes, loc));
 }
 
 
@@ -3102,7 +4395,7 @@ Stmt LowererImplImperative::initResultArrays(vector<Access> writes,
       }
 
       // Pre-allocate memory for the value array if computing while assembling
-      if (generateComputeCode()) {
+      if (generateComputeCode() && !isPattern(write.getTensorVar())) {
         taco_iassert(!iterators.empty());
 
         Expr capacityVar = getCapacityVar(tensor);
@@ -3138,6 +4431,7 @@ Stmt LowererImplImperative::initResultArrays(vector<Access> writes,
     }
 
     if (generateComputeCode() && iterators.back().hasInsert() &&
+        !isPattern(write.getTensorVar()) &&
         !isValue(parentSize, 0) && (isNonFullyInitialized(tensor) || 
         util::contains(reducedAccesses, write))) {
       // Zero-initialize values array if size statically known and might not
@@ -3190,7 +4484,7 @@ ir::Stmt LowererImplImperative::finalizeResultArrays(std::vector<Access> writes)
       clearValuesAllocation |= (iterator.isWindowed() || iterator.hasIndexSet());
     }
 
-    if (!generateComputeCode()) {
+    if (!generateComputeCode() && !isPattern(write.getTensorVar())) {
       // Allocate memory for values array after assembly if not also computing
       Expr tensor = getTensorVar(write.getTensorVar());
       Expr valuesArr = GetProperty::make(tensor, TensorProperty::Values);
@@ -3202,7 +4496,8 @@ ir::Stmt LowererImplImperative::finalizeResultArrays(std::vector<Access> writes)
 }
 
 Stmt LowererImplImperative::defineScalarVariable(TensorVar var, bool zero) {
-  Datatype type = var.getType().getDataType();
+  Datatype type = util::contains(scalarAccumulatorTypes, var)
+                  ? scalarAccumulatorTypes.at(var) : var.getType().getDataType();
   Expr varValueIR = Var::make(var.getName() + "_val", type, false, false);
   Expr init = (zero) ? ir::Literal::zero(type)
                      : Load::make(GetProperty::make(tensorVars.at(var),
@@ -3234,6 +4529,10 @@ Stmt LowererImplImperative::initResultArrays(IndexVar var, vector<Access> writes
 
   vector<Stmt> result;
   for (auto& write : writes) {
+    if (isAssembledByUngroupedInsertion(write.getTensorVar())) {
+      continue;
+    }
+
     Expr tensor = getTensorVar(write.getTensorVar());
     Expr fill = lower(write.getTensorVar().getFill());
     Expr values = GetProperty::make(tensor, TensorProperty::Values);
@@ -3322,7 +4621,8 @@ Stmt LowererImplImperative::resizeAndInitValues(const std::vector<Iterator>& app
   std::vector<Stmt> result;
 
   for (auto& appender : appenders) {
-    if (!appender.isLeaf()) {
+    if (!appender.isLeaf() || 
+        isPattern(iterators.modeAccess(appender).getAccess().getTensorVar())) {
       continue;
     }
 
@@ -3379,8 +4679,8 @@ Stmt LowererImplImperative::declLocatePosVars(vector<Iterator> locators) {
 
     if (doLocate) {
       Iterator locateIterator = locator;
-      if (locateIterator.hasPosIter()) {
-        taco_iassert(!provGraph.isUnderived(locateIterator.getIndexVar()));
+      if (locateIterator.hasPosIter() &&
+          !provGraph.isUnderived(locateIterator.getIndexVar())) {
         continue; // these will be recovered with separate procedure
       }
       do {
@@ -3427,14 +4727,13 @@ Stmt LowererImplImperative::reduceDuplicateCoordinates(Expr coordinate,
     Access access = this->iterators.modeAccess(iterator).getAccess();
     Expr iterVar = iterator.getIteratorVar();
     Expr segendVar = iterator.getSegendVar();
-    Expr reducedVal = iterator.isLeaf() ? getReducedValueVar(access) : Expr();
-    Expr tensorVar = getTensorVar(access.getTensorVar());
-    Expr tensorVals = GetProperty::make(tensorVar, TensorProperty::Values);
+    Expr reducedVal = (iterator.isLeaf() && !isPattern(access.getTensorVar()))
+                      ? getReducedValueVar(access) : Expr();
 
     // Initialize variable storing reduced component value.
     if (reducedVal.defined()) {
       Expr reducedValInit = alwaysReduce
-                          ? Load::make(tensorVals, iterVar)
+                          ? loadValue(access.getTensorVar(), iterVar)
                           : ir::Literal::zero(reducedVal.type());
       result.push_back(VarDecl::make(reducedVal, reducedValInit));
     }
@@ -3454,7 +4753,7 @@ Stmt LowererImplImperative::reduceDuplicateCoordinates(Expr coordinate,
 
     vector<Stmt> dedupStmts;
     if (reducedVal.defined()) {
-      Expr partialVal = Load::make(tensorVals, segendVar);
+      Expr partialVal = loadValue(access.getTensorVar(), segendVar);
       dedupStmts.push_back(compoundAssign(reducedVal, partialVal));
     }
     dedupStmts.push_back(compoundAssign(segendVar, 1));
@@ -3502,7 +4801,7 @@ Stmt LowererImplImperative::codeToInitializeIteratorVar(Iterator iterator, vecto
           result.push_back(VarDecl::make(iterator.getBeginVar(), binarySearchTarget));
 
           vector<Expr> binarySearchArgs = {
-                  iterator.getMode().getModePack().getArray(1), // array
+                  getSearchableCoordArray(iterator), // array
                   bounds[0], // arrayStart
                   bounds[1], // arrayEnd
                   iterator.getBeginVar() // target
@@ -3649,7 +4948,7 @@ Stmt LowererImplImperative::codeToIncIteratorVars(Expr coordinate, IndexVar coor
         ModeFunction iterBounds = iterator.posBounds(iteratorParentPos);
         result.push_back(iterBounds.compute());
         vector<Expr> gallopArgs = {
-          iterator.getMode().getModePack().getArray(1),
+          getSearchableCoordArray(iterator),
           ivar, iterBounds[1],
           coordinate,
         };
@@ -3796,6 +5095,23 @@ Stmt LowererImplImperative::appendCoordinate(vector<Iterator> appenders, Expr co
 }
 
 
+Stmt LowererImplImperative::insertCoordinates(vector<Iterator> inserters) {
+  if (!generateAssembleCode()) {
+    return Stmt();
+  }
+
+  vector<Stmt> result;
+  for (auto& inserter : inserters) {
+    Stmt insertCoord = inserter.getInsertCoord(inserter.getPosVar(),
+                                               coordinates(inserter));
+    if (insertCoord.defined()) {
+      result.push_back(insertCoord);
+    }
+  }
+  return result.empty() ? Stmt() : Block::make(result);
+}
+
+
 Stmt LowererImplImperative::generateAppendPositions(vector<Iterator> appenders) {
   vector<Stmt> result;
   if (generateAssembleCode()) {
@@ -3827,6 +5143,9 @@ Expr LowererImplImperative::generateValueLocExpr(Access access) const {
   if (isScalar(access.getTensorVar().getType())) {
     return ir::Literal::make(0);
   }
+  if (util::contains(tempToSparseAccumulator, access.getTensorVar())) {
+    return tempToSparseAccumulator.at(access.getTensorVar()).loc;
+  }
   Iterator it = getIterators(access).back();
 
   // to make indexing temporary arrays with index var work correctly
@@ -3984,12 +5303,15 @@ bool LowererImplImperative::hasStores(Stmt stmt) {
     bool hasStore;
     const std::map<TensorVar, Expr>& tensorVars;
     const std::map<TensorVar, Expr>& tempToBitGuard;
+    const std::map<TensorVar, Expr>& tempToIndexListSize;
 
     using IRVisitor::visit;
 
     FindStores(const std::map<TensorVar, Expr>& tensorVars,
-               const std::map<TensorVar, Expr>& tempToBitGuard)
-        : tensorVars(tensorVars), tempToBitGuard(tempToBitGuard) {}
+               const std::map<TensorVar, Expr>& tempToBitGuard,
+               const std::map<TensorVar, Expr>& tempToIndexListSize)
+        : tensorVars(tensorVars), tempToBitGuard(tempToBitGuard),
+          tempToIndexListSize(tempToIndexListSize) {}
 
     void visit(const Store* stmt) {
       hasStore = true;
@@ -4011,6 +5333,16 @@ bool LowererImplImperative::hasStores(Stmt stmt) {
           break;
         }
       }
+      if (hasStore) {
+        return;
+      }
+      // Heaps are pushed onto by assigning their sizes
+      for (const auto& indexListSize : tempToIndexListSize) {
+        if (stmt->lhs == indexListSize.second) {
+          hasStore = true;
+          break;
+        }
+      }
     }
 
     bool hasStores(Stmt stmt) {
@@ -4019,7 +5351,8 @@ bool LowererImplImperative::hasStores(Stmt stmt) {
       return hasStore;
     }
   };
-  return FindStores(tensorVars, tempToBitGuard).hasStores(stmt);
+  return FindStores(tensorVars, tempToBitGuard,
+                    tempToIndexListSize).hasStores(stmt);
 }
 
 
@@ -4027,7 +5360,7 @@ Expr LowererImplImperative::searchForStartOfWindowPosition(Iterator iterator, ir
     taco_iassert(iterator.isWindowed());
     vector<Expr> args = {
             // Search over the `crd` array of the level,
-            iterator.getMode().getModePack().getArray(1),
+            getSearchableCoordArray(iterator),
             // between the start and end position,
             start, end,
             // for the beginning of the window.
@@ -4041,7 +5374,7 @@ Expr LowererImplImperative::searchForEndOfWindowPosition(Iterator iterator, ir::
     taco_iassert(iterator.isWindowed());
     vector<Expr> args = {
             // Search over the `crd` array of the level,
-            iterator.getMode().getModePack().getArray(1),
+            getSearchableCoordArray(iterator),
             // between the start and end position,
             start, end,
             // for the end of the window.
@@ -0,0 +1,169 @@
+#include "taco/lower/mode_format_bitmap.h"
+
+#include "taco/ir/ir_generators.h"
+#include "taco/ir/simplify.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+BitmapModeFormat::BitmapModeFormat() : BitmapModeFormat(false) {
+}
+
+BitmapModeFormat::BitmapModeFormat(bool isZeroless) :
+    ModeFormatImpl("bitmap", false, true, true, false, false, isZeroless,
+                   true, false, true, true, true, false, false, false, false) {
+}
+
+ModeFormat BitmapModeFormat::copy(
+    vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(std::make_shared<BitmapModeFormat>(isZeroless));
+}
+
+ModeFunction BitmapModeFormat::posIterBounds(Expr parentPos, Mode mode) const {
+  Expr pbegin = ir::Mul::make(parentPos, getWidth(mode));
+  Expr pend = ir::Add::make(pbegin, getWidth(mode));
+  return ModeFunction(Stmt(), {pbegin, pend});
+}
+
+ModeFunction BitmapModeFormat::posIterAccess(Expr pos,
+                                             std::vector<Expr> coords,
+                                             Mode mode) const {
+  Expr idx = ir::Rem::make(pos, getWidth(mode));
+  Expr wordBegin = ir::Mul::make(ir::Div::make(pos, getWidth(mode)),
+                                 getNumWords(mode));
+  Expr isSet = ir::Call::make("taco_bit_test",
+                              {getBitsArray(mode.getModePack()), wordBegin,
+                               idx}, Bool);
+  return ModeFunction(Stmt(), {idx, isSet});
+}
+
+bool BitmapModeFormat::hasWordIter() const {
+  return true;
+}
+
+ModeFunction BitmapModeFormat::wordIterBounds(Expr parentPos, 
+                                              Mode mode) const {
+  Expr wbegin = ir::Mul::make(parentPos, getNumWords(mode));
+  Expr wend = ir::Add::make(wbegin, getNumWords(mode));
+  return ModeFunction(Stmt(), {wbegin, wend});
+}
+
+ModeFunction BitmapModeFormat::wordIterAccess(Expr wordPos, Mode mode) const {
+  return ModeFunction(Stmt(), {Load::make(getBitsArray(mode.getModePack()),
+                                          wordPos)});
+}
+
+ModeFunction BitmapModeFormat::wordIterLocate(Expr parentPos, Expr wordPos,
+                                              Expr bit, Mode mode) const {
+  Expr wordBegin = ir::Mul::make(parentPos, getNumWords(mode));
+  Expr idx = ir::Add::make(ir::Mul::make(ir::Sub::make(wordPos, wordBegin), 64),
+                           bit);
+  Expr pos = ir::Add::make(ir::Mul::make(parentPos, getWidth(mode)), idx);
+  return ModeFunction(Stmt(), {simplify(pos), simplify(idx)});
+}
+
+ModeFunction BitmapModeFormat::locate(Expr parentPos,
+                                      std::vector<Expr> coords,
+                                      Mode mode) const {
+  Expr pos = ir::Add::make(ir::Mul::make(parentPos, getWidth(mode)), 
+                           coords.back());
+  return ModeFunction(Stmt(), {pos, true});
+}
+
+Stmt BitmapModeFormat::getInsertCoord(Expr p, const std::vector<Expr>& i,
+                                      Mode mode) const {
+  Expr bitsArray = getBitsArray(mode.getModePack());
+  Expr wordPos = ir::Add::make(
+      ir::Mul::make(ir::Div::make(p, getWidth(mode)), getNumWords(mode)),
+      ir::Div::make(i.back(), 64));
+  Expr bit = ir::Call::make("taco_bit", {i.back()}, UInt64);
+  return Store::make(bitsArray, wordPos, 
+                     ir::BitOr::make(Load::make(bitsArray, wordPos), bit));
+}
+
+Expr BitmapModeFormat::getWidth(Mode mode) const {
+  return getSizeArray(mode.getModePack());
+}
+
+Stmt BitmapModeFormat::getInsertInitCoords(Expr pBegin, Expr pEnd,
+                                           Mode mode) const {
+  Expr bitsArray = getBitsArray(mode.getModePack());
+  Expr wBegin = simplify(ir::Mul::make(ir::Div::make(pBegin, getWidth(mode)),
+                                       getNumWords(mode)));
+  Expr wEnd = simplify(ir::Mul::make(ir::Div::make(pEnd, getWidth(mode)),
+                                     getNumWords(mode)));
+  Stmt maybeResizeBits = atLeastDoubleSizeIfFull(bitsArray, 
+                                                 getBitsCapacity(mode),
+                                                 ir::Sub::make(wEnd, 1));
+
+  Expr wVar = Var::make("w" + mode.getName(), Int());
+  Stmt clearWords = For::make(wVar, wBegin, wEnd, 1,
+                              Store::make(bitsArray, wVar, 
+                                          ir::Literal::zero(UInt64)));
+  return Block::make(maybeResizeBits, clearWords);
+}
+
+Stmt BitmapModeFormat::getInsertInitLevel(Expr szPrev, Expr sz,
+                                          Mode mode) const {
+  Expr bitsCapacity = getBitsCapacity(mode);
+  Expr initCapacity = isValue(szPrev, 0) ? getNumWords(mode) 
+                    : simplify(ir::Mul::make(szPrev, getNumWords(mode)));
+  return Block::make(VarDecl::make(bitsCapacity, initCapacity),
+                     Allocate::make(getBitsArray(mode.getModePack()), 
+                                    bitsCapacity));
+}
+
+Stmt BitmapModeFormat::getInsertFinalizeLevel(Expr szPrev, Expr sz,
+                                              Mode mode) const {
+  return Stmt();
+}
+
+vector<Expr> BitmapModeFormat::getArrays(Expr tensor, int mode,
+                                         int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Dimension, mode),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 1, arraysName + "_bits", UInt64)};
+}
+
+Expr BitmapModeFormat::getSizeArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr BitmapModeFormat::getBitsArray(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Expr BitmapModeFormat::getBitsCapacity(Mode mode) const {
+  const std::string varName = mode.getName() + "_bits_size";
+
+  if (!mode.hasVar(varName)) {
+    Expr bitsCapacity = Var::make(varName, Int());
+    mode.addVar(varName, bitsCapacity);
+    return bitsCapacity;
+  }
+
+  return mode.getVar(varName);
+}
+
+Expr BitmapModeFormat::getNumWords(Mode mode) const {
+  return ir::Div::make(ir::Add::make(getWidth(mode), 63), 64);
+}
+
+}
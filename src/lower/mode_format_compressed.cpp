@@ -231,6 +231,20 @@ Stmt CompressedModeFormat::getSeqInsertEdge(Expr parentPos,
   return Store::make(posArray, ir::Add::make(parentPos, 1), pos);
 }
 
+Stmt CompressedModeFormat::getParInsertEdge(Expr parentPos, 
+    std::vector<Expr> coords, std::vector<AttrQueryResult> queries, 
+    Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr nnz = queries[0].getResult(coords, "nnz");
+  return Store::make(posArray, ir::Add::make(parentPos, 1), nnz);
+}
+
+Stmt CompressedModeFormat::getParFinalizeEdges(Expr prevSize, 
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  return parallelPrefixSum(posArray, ir::Add::make(prevSize, 1));
+}
+
 Stmt CompressedModeFormat::getInitCoords(Expr prevSize, 
     std::vector<AttrQueryResult> queries, Mode mode) const {
   Expr posArray = getPosArray(mode.getModePack());
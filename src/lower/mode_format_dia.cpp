@@ -0,0 +1,125 @@
+#include "taco/lower/mode_format_dia.h"
+
+#include <algorithm>
+
+#include "taco/ir/ir_generators.h"
+#include "taco/ir/simplify.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+static vector<int> sortOffsets(vector<int> offsets) {
+  std::sort(offsets.begin(), offsets.end());
+  offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+  return offsets;
+}
+
+DiaModeFormat::DiaModeFormat() : DiaModeFormat(false, {0}) {
+}
+
+DiaModeFormat::DiaModeFormat(bool isZeroless, std::vector<int> offsets) :
+    ModeFormatImpl("dia", false, false, true, false, false, isZeroless,
+                   true, false, true, true, true, false, false, false, false),
+    offsets(sortOffsets(offsets)) {
+  taco_uassert(!this->offsets.empty())
+      << "A DIA level must store at least one diagonal";
+}
+
+ModeFormat DiaModeFormat::copy(vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(std::make_shared<DiaModeFormat>(isZeroless, offsets));
+}
+
+ModeFunction DiaModeFormat::posIterBounds(Expr parentPos, Mode mode) const {
+  Expr pbegin = ir::Mul::make(parentPos, getWidth(mode));
+  Expr pend = ir::Add::make(pbegin, getNumDiagonals());
+  return ModeFunction(Stmt(), {pbegin, pend});
+}
+
+ModeFunction DiaModeFormat::posIterAccess(Expr pos, std::vector<Expr> coords,
+                                          Mode mode) const {
+  // The width is a constant, so the slot of a position is computed without
+  // a division instruction.
+  Expr slot = ir::Rem::make(pos, getWidth(mode));
+  Expr offset = Load::make(getOffsetArray(mode.getModePack()),
+                           ir::Add::make(slot, 1));
+  Expr idx = ir::Add::make(getParentCoord(coords), offset);
+  Expr dim = getDimension(mode.getModePack());
+  Expr found = ir::And::make(Gte::make(idx, 0), Lt::make(idx, dim));
+  Expr clamped = ir::Min::make(ir::Max::make(idx, 0), ir::Sub::make(dim, 1));
+  return ModeFunction(Stmt(), {idx, found, clamped});
+}
+
+ModeFunction DiaModeFormat::locate(Expr parentPos, std::vector<Expr> coords,
+                                   Mode mode) const {
+  Expr offset = ir::Sub::make(coords.back(), getParentCoord(coords));
+  Expr slot = ir::Call::make("taco_dia_locate",
+                             {getOffsetArray(mode.getModePack()), offset},
+                             Int());
+  Expr pos = ir::Add::make(ir::Mul::make(parentPos, getWidth(mode)), slot);
+  return ModeFunction(Stmt(), {pos, true});
+}
+
+Expr DiaModeFormat::getWidth(Mode mode) const {
+  return ir::Literal::make((int)offsets.size() + 1, Datatype::Int32);
+}
+
+Stmt DiaModeFormat::getInsertInitLevel(Expr szPrev, Expr sz, Mode mode) const {
+  Expr offsetArray = getOffsetArray(mode.getModePack());
+  std::vector<Stmt> stmts;
+  stmts.push_back(Allocate::make(offsetArray, (int)offsets.size() + 1));
+  stmts.push_back(Store::make(offsetArray, 0, getNumDiagonals()));
+  for (size_t d = 0; d < offsets.size(); ++d) {
+    stmts.push_back(Store::make(offsetArray, (int)d + 1, offsets[d]));
+  }
+  return Block::make(stmts);
+}
+
+vector<Expr> DiaModeFormat::getArrays(Expr tensor, int mode, int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 0, arraysName + "_offset"),
+          GetProperty::make(tensor, TensorProperty::Dimension, mode)};
+}
+
+const std::vector<int>& DiaModeFormat::getOffsets() const {
+  return offsets;
+}
+
+Expr DiaModeFormat::getOffsetArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr DiaModeFormat::getDimension(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Expr DiaModeFormat::getNumDiagonals() const {
+  return ir::Literal::make((int)offsets.size(), Datatype::Int32);
+}
+
+Expr DiaModeFormat::getParentCoord(const vector<Expr>& coords) const {
+  return (coords.size() < 2) ? Expr(0) : coords[coords.size() - 2];
+}
+
+bool DiaModeFormat::equals(const ModeFormatImpl& other) const {
+  return ModeFormatImpl::equals(other) &&
+         (dynamic_cast<const DiaModeFormat&>(other).offsets == offsets);
+}
+
+}
@@ -0,0 +1,208 @@
+#include "taco/lower/mode_format_ell.h"
+
+#include "taco/ir/ir_generators.h"
+#include "taco/ir/simplify.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+EllModeFormat::EllModeFormat() : EllModeFormat(false) {
+}
+
+EllModeFormat::EllModeFormat(bool isZeroless, long long sliceHeight) :
+    ModeFormatImpl("ell", false, false, true, false, false, isZeroless, true,
+                   false, true, false, false, false, true, true, false),
+    sliceHeight(sliceHeight) {
+  taco_uassert(sliceHeight >= 0)
+      << "The slice height of an ELL level must not be negative";
+}
+
+ModeFormat EllModeFormat::copy(vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(std::make_shared<EllModeFormat>(isZeroless, sliceHeight));
+}
+
+std::vector<AttrQuery> EllModeFormat::attrQueries(
+    vector<IndexVar> parentCoords, vector<IndexVar> childCoords) const {
+  std::vector<IndexVar> groupBy(parentCoords.begin(), parentCoords.end() - 1);
+  return {AttrQuery(groupBy, {std::make_tuple("nnz", AttrQuery::COUNT,
+                                              std::vector<IndexVar>{
+                                                  parentCoords.back()})})};
+}
+
+ModeFunction EllModeFormat::posIterBounds(Expr parentPos, Mode mode) const {
+  Expr pbegin = getBegin(parentPos, mode);
+  Expr pend = ir::Add::make(pbegin, getSliceWidth(parentPos, mode));
+  return ModeFunction(Stmt(), {pbegin, pend});
+}
+
+ModeFunction EllModeFormat::posIterAccess(Expr pos, std::vector<Expr> coords,
+                                          Mode mode) const {
+  Expr idx = Load::make(getCoordArray(mode.getModePack()), pos);
+  return ModeFunction(Stmt(), {idx, Gte::make(idx, 0), ir::Max::make(idx, 0)});
+}
+
+Expr EllModeFormat::getAssembledSize(Expr prevSize, Mode mode) const {
+  Expr sliceArray = getSliceArray(mode.getModePack());
+  if (sliceHeight == 0) {
+    return ir::Mul::make(prevSize, Load::make(sliceArray, 1));
+  }
+  return Load::make(sliceArray, ir::Add::make(getNumSlices(prevSize), 1));
+}
+
+Stmt EllModeFormat::getSeqInitEdges(Expr prevSize,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr sliceArray = getSliceArray(mode.getModePack());
+  Expr sliceArraySize = (sliceHeight == 0) ? Expr(2) :
+                        ir::Add::make(getNumSlices(prevSize), 2);
+  return Block::make({Allocate::make(sliceArray, sliceArraySize, false,
+                                     Expr(), true),
+                      Store::make(sliceArray, 0, (int)sliceHeight)});
+}
+
+Stmt EllModeFormat::getSeqInsertEdge(Expr parentPos, std::vector<Expr> coords,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  // Widths are first computed as the maximum number of coordinates of the
+  // parent positions in each slice and then turned into slice offsets.
+  Expr sliceArray = getSliceArray(mode.getModePack());
+  Expr loc = (sliceHeight == 0) ? Expr(1) :
+             ir::Add::make(ir::Div::make(parentPos, (int)sliceHeight), 2);
+  Expr nnz = queries[0].getResult(coords, "nnz");
+  Expr width = ir::Max::make(Load::make(sliceArray, loc), nnz);
+  return Store::make(sliceArray, loc, width);
+}
+
+Stmt EllModeFormat::getInitCoords(Expr prevSize,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr sliceArray = getSliceArray(mode.getModePack());
+  Expr crdArray = getCoordArray(mode.getModePack());
+
+  Stmt computeOffsets;
+  if (sliceHeight > 0) {
+    Expr sVar = Var::make("s" + mode.getName(), Int());
+    Expr offset = ir::Add::make(Load::make(sliceArray, ir::Add::make(sVar, 1)),
+        ir::Mul::make(Load::make(sliceArray, ir::Add::make(sVar, 2)),
+                      (int)sliceHeight));
+    computeOffsets = For::make(sVar, 0, getNumSlices(prevSize), 1,
+        Store::make(sliceArray, ir::Add::make(sVar, 2), offset));
+  }
+
+  Expr size = getAssembledSize(prevSize, mode);
+  Expr pVar = Var::make("p" + mode.getName(), Int());
+  Stmt fillPadding = For::make(pVar, 0, size, 1,
+                               Store::make(crdArray, pVar, -1));
+  return Block::make({computeOffsets, Allocate::make(crdArray, size),
+                      fillPadding});
+}
+
+Stmt EllModeFormat::getInitYieldPos(Expr prevSize, Mode mode) const {
+  Expr countArray = getCountArray(mode);
+  Expr callocCounts = ir::Call::make("taco_calloc",
+                                     {prevSize, Sizeof::make(Int())}, Int());
+  return VarDecl::make(countArray, callocCounts);
+}
+
+ModeFunction EllModeFormat::getYieldPos(Expr parentPos,
+    std::vector<Expr> coords, Mode mode) const {
+  Expr countArray = getCountArray(mode);
+  Expr loadCount = Load::make(countArray, parentPos);
+  Expr pVar = Var::make("p" + mode.getName(), Int());
+  Stmt getPos = VarDecl::make(pVar,
+                              ir::Add::make(getBegin(parentPos, mode),
+                                            loadCount));
+  Stmt incCount = Store::make(countArray, parentPos,
+                              ir::Add::make(loadCount, 1));
+  return ModeFunction(Block::make(getPos, incCount), {pVar});
+}
+
+Stmt EllModeFormat::getInsertCoord(Expr parentPos, Expr pos,
+    std::vector<Expr> coords, Mode mode) const {
+  return Store::make(getCoordArray(mode.getModePack()), pos, coords.back());
+}
+
+Stmt EllModeFormat::getFinalizeYieldPos(Expr prevSize, Mode mode) const {
+  return Free::make(getCountArray(mode));
+}
+
+vector<Expr> EllModeFormat::getArrays(Expr tensor, int mode, int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 0, arraysName + "_slice"),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 1, arraysName + "_crd")};
+}
+
+Expr EllModeFormat::getSliceArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr EllModeFormat::getCoordArray(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Expr EllModeFormat::getCountArray(Mode mode) const {
+  const std::string varName = mode.getName() + "_count";
+
+  if (!mode.hasVar(varName)) {
+    Expr countArray = Var::make(varName, Int(), true);
+    mode.addVar(varName, countArray);
+    return countArray;
+  }
+
+  return mode.getVar(varName);
+}
+
+Expr EllModeFormat::getNumSlices(Expr prevSize) const {
+  taco_iassert(sliceHeight > 0);
+  return ir::Div::make(ir::Add::make(prevSize, (int)sliceHeight - 1),
+                       (int)sliceHeight);
+}
+
+Expr EllModeFormat::getSliceBegin(Expr parentPos, Mode mode) const {
+  taco_iassert(sliceHeight > 0);
+  Expr slice = ir::Div::make(parentPos, (int)sliceHeight);
+  return Load::make(getSliceArray(mode.getModePack()),
+                    ir::Add::make(slice, 1));
+}
+
+Expr EllModeFormat::getSliceWidth(Expr parentPos, Mode mode) const {
+  Expr sliceArray = getSliceArray(mode.getModePack());
+  if (sliceHeight == 0) {
+    return Load::make(sliceArray, 1);
+  }
+  Expr slice = ir::Div::make(parentPos, (int)sliceHeight);
+  Expr sliceEnd = Load::make(sliceArray, ir::Add::make(slice, 2));
+  return ir::Div::make(ir::Sub::make(sliceEnd, getSliceBegin(parentPos, mode)),
+                       (int)sliceHeight);
+}
+
+Expr EllModeFormat::getBegin(Expr parentPos, Mode mode) const {
+  if (sliceHeight == 0) {
+    return ir::Mul::make(parentPos, getSliceWidth(parentPos, mode));
+  }
+  Expr row = ir::Rem::make(parentPos, (int)sliceHeight);
+  return ir::Add::make(getSliceBegin(parentPos, mode),
+                       ir::Mul::make(row, getSliceWidth(parentPos, mode)));
+}
+
+bool EllModeFormat::equals(const ModeFormatImpl& other) const {
+  return ModeFormatImpl::equals(other) &&
+         (dynamic_cast<const EllModeFormat&>(other).sliceHeight == sliceHeight);
+}
+
+}
@@ -0,0 +1,169 @@
+#include "taco/lower/mode_format_hashed.h"
+
+#include "taco/ir/ir_generators.h"
+#include "taco/ir/simplify.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+HashedModeFormat::HashedModeFormat() : HashedModeFormat(false) {
+}
+
+HashedModeFormat::HashedModeFormat(bool isZeroless, long long width) :
+    ModeFormatImpl("hashed", false, false, true, false, false, isZeroless,
+                   true, false, true, true, false, false, true, true, true),
+    width(width) {
+  taco_uassert(width >= 0) << "The width of a hashed level must not be negative";
+}
+
+ModeFormat HashedModeFormat::copy(
+    vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(std::make_shared<HashedModeFormat>(isZeroless, width));
+}
+
+std::vector<AttrQuery> HashedModeFormat::attrQueries(
+    vector<IndexVar> parentCoords, vector<IndexVar> childCoords) const {
+  std::vector<IndexVar> groupBy(parentCoords.begin(), parentCoords.end() - 1);
+  return {AttrQuery(groupBy, {std::make_tuple("nnz", AttrQuery::COUNT,
+                                              std::vector<IndexVar>{
+                                                  parentCoords.back()})})};
+}
+
+ModeFunction HashedModeFormat::posIterBounds(Expr parentPos, Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr pbegin = Load::make(posArray, parentPos);
+  Expr pend = Load::make(posArray, ir::Add::make(parentPos, 1));
+  return ModeFunction(Stmt(), {pbegin, pend});
+}
+
+ModeFunction HashedModeFormat::posIterAccess(Expr pos,
+                                             std::vector<Expr> coords,
+                                             Mode mode) const {
+  Expr idx = Load::make(getCoordArray(mode.getModePack()), pos);
+  return ModeFunction(Stmt(), {idx, Gte::make(idx, 0),
+                                 ir::Max::make(idx, 0)});
+}
+
+ModeFunction HashedModeFormat::locate(Expr parentPos,
+                                      std::vector<Expr> coords,
+                                      Mode mode) const {
+  return ModeFunction(Stmt(), {getSlot(parentPos, coords, mode), true});
+}
+
+Expr HashedModeFormat::getAssembledSize(Expr prevSize, Mode mode) const {
+  return Load::make(getPosArray(mode.getModePack()), prevSize);
+}
+
+Stmt HashedModeFormat::getSeqInitEdges(Expr prevSize,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  return Block::make({Allocate::make(posArray, ir::Add::make(prevSize, 1)),
+                      Store::make(posArray, 0, 0)});
+}
+
+Stmt HashedModeFormat::getSeqInsertEdge(Expr parentPos,
+    std::vector<Expr> coords, std::vector<AttrQueryResult> queries,
+    Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr pos = ir::Add::make(Load::make(posArray, parentPos),
+                           getTableWidth(coords, queries, mode));
+  return Store::make(posArray, ir::Add::make(parentPos, 1), pos);
+}
+
+Stmt HashedModeFormat::getParInsertEdge(Expr parentPos,
+    std::vector<Expr> coords, std::vector<AttrQueryResult> queries,
+    Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  return Store::make(posArray, ir::Add::make(parentPos, 1),
+                     getTableWidth(coords, queries, mode));
+}
+
+Stmt HashedModeFormat::getParFinalizeEdges(Expr prevSize,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  return parallelPrefixSum(posArray, ir::Add::make(prevSize, 1));
+}
+
+Stmt HashedModeFormat::getInitCoords(Expr prevSize,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr crdArray = getCoordArray(mode.getModePack());
+  Expr size = getAssembledSize(prevSize, mode);
+  Expr pVar = Var::make("p" + mode.getName(), Int());
+  Stmt clearSlots = For::make(pVar, 0, size, 1,
+                              Store::make(crdArray, pVar, -1));
+  return Block::make(Allocate::make(crdArray, size), clearSlots);
+}
+
+ModeFunction HashedModeFormat::getYieldPos(Expr parentPos,
+    std::vector<Expr> coords, Mode mode) const {
+  return ModeFunction(Stmt(), {getSlot(parentPos, coords, mode)});
+}
+
+Stmt HashedModeFormat::getInsertCoord(Expr parentPos, Expr pos,
+    std::vector<Expr> coords, Mode mode) const {
+  return Store::make(getCoordArray(mode.getModePack()), pos, coords.back());
+}
+
+vector<Expr> HashedModeFormat::getArrays(Expr tensor, int mode,
+                                         int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 0, arraysName + "_pos"),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 1, arraysName + "_crd"),
+          GetProperty::make(tensor, TensorProperty::Dimension, mode)};
+}
+
+Expr HashedModeFormat::getPosArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr HashedModeFormat::getCoordArray(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Expr HashedModeFormat::getDimension(ModePack pack) const {
+  return pack.getArray(2);
+}
+
+Expr HashedModeFormat::getTableWidth(std::vector<Expr> coords,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  Expr nnz = queries[0].getResult(coords, "nnz");
+  Expr slots = ir::Min::make(ir::Mul::make(nnz, 2),
+                             getDimension(mode.getModePack()));
+  return ir::Max::make(slots, (int)std::max(width, 1ll));
+}
+
+Expr HashedModeFormat::getSlot(Expr parentPos, std::vector<Expr> coords,
+                               Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr tableBegin = Load::make(posArray, parentPos);
+  Expr tableEnd = Load::make(posArray, ir::Add::make(parentPos, 1));
+  return ir::Call::make("taco_hash_locate",
+                        {getCoordArray(mode.getModePack()), tableBegin,
+                         ir::Sub::make(tableEnd, tableBegin), coords.back()},
+                        Int());
+}
+
+bool HashedModeFormat::equals(const ModeFormatImpl& other) const {
+  return ModeFormatImpl::equals(other) &&
+         (dynamic_cast<const HashedModeFormat&>(other).width == width);
+}
+
+}
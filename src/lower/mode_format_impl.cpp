@@ -81,8 +81,10 @@ std::ostream& operator<<(std::ostream&os, const AttrQuery& query) {
 
 
 // class AttrQueryResult
-AttrQueryResult::AttrQueryResult(Expr resultVar, Expr resultValues) 
-    : resultVar(resultVar), resultValues(resultValues) {}
+AttrQueryResult::AttrQueryResult(Expr resultVar, Expr resultValues,
+                                 std::vector<Expr> resultDims) 
+    : resultVar(resultVar), resultValues(resultValues), 
+      resultDims(resultDims) {}
 
 Expr AttrQueryResult::getResult(const std::vector<Expr>& indices,
                                 const std::string& attr) const {
@@ -92,7 +94,8 @@ Expr AttrQueryResult::getResult(const std::vector<Expr>& indices,
 
   Expr pos = 0;
   for (int i = 0; i < (int)indices.size(); ++i) {
-    Expr dim = GetProperty::make(resultVar, TensorProperty::Dimension, i);
+    Expr dim = (i < (int)resultDims.size()) ? resultDims[i] :
+               GetProperty::make(resultVar, TensorProperty::Dimension, i);
     pos = ir::Add::make(ir::Mul::make(pos, dim), indices[i]);
   }
   return Load::make(resultValues, pos);
@@ -197,6 +200,43 @@ ModeFunction ModeFormatImpl::posIterAccess(ir::Expr pos,
   return ModeFunction();
 }
 
+bool ModeFormatImpl::hasWordIter() const {
+  return false;
+}
+
+ModeFunction ModeFormatImpl::wordIterBounds(ir::Expr parentPos, 
+                                            Mode mode) const {
+  return ModeFunction();
+}
+
+ModeFunction ModeFormatImpl::wordIterAccess(ir::Expr wordPos, 
+                                            Mode mode) const {
+  return ModeFunction();
+}
+
+ModeFunction ModeFormatImpl::wordIterLocate(ir::Expr parentPos, 
+                                            ir::Expr wordPos, ir::Expr bit,
+                                            Mode mode) const {
+  return ModeFunction();
+}
+
+bool ModeFormatImpl::hasRunIter() const {
+  return false;
+}
+
+ModeFunction ModeFormatImpl::runIterBounds(ir::Expr parentPos, 
+                                           Mode mode) const {
+  return ModeFunction();
+}
+
+ModeFunction ModeFormatImpl::runIterAccess(ir::Expr runPos, Mode mode) const {
+  return ModeFunction();
+}
+
+ModeFunction ModeFormatImpl::runIterLocate(ir::Expr pos, Mode mode) const {
+  return ModeFunction();
+}
+
 ModeFunction ModeFormatImpl::locate(ir::Expr parentPos,
                                   std::vector<ir::Expr> coords,
                                   Mode mode) const {
@@ -270,6 +310,16 @@ Stmt ModeFormatImpl::getSeqInsertEdge(Expr parentPos, std::vector<Expr> coords,
   return Stmt();
 }
 
+Stmt ModeFormatImpl::getParInsertEdge(Expr parentPos, std::vector<Expr> coords,
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  return Stmt();
+}
+
+Stmt ModeFormatImpl::getParFinalizeEdges(Expr prevSize, 
+    std::vector<AttrQueryResult> queries, Mode mode) const {
+  return Stmt();
+}
+
 Stmt ModeFormatImpl::getInitCoords(Expr prevSize, 
     std::vector<AttrQueryResult> queries, Mode mode) const {
   return Stmt();
@@ -0,0 +1,250 @@
+#include "taco/lower/mode_format_rle.h"
+
+#include "taco/ir/ir_generators.h"
+#include "taco/ir/simplify.h"
+#include "taco/util/strings.h"
+
+using namespace std;
+using namespace taco::ir;
+
+namespace taco {
+
+RleModeFormat::RleModeFormat() : RleModeFormat(false) {
+}
+
+RleModeFormat::RleModeFormat(bool isZeroless, long long allocSize) :
+    ModeFormatImpl("rle", false, true, true, false, true, isZeroless, false,
+                   false, true, false, false, true, false, false, false),
+    allocSize(allocSize) {
+}
+
+ModeFormat RleModeFormat::copy(vector<ModeFormat::Property> properties) const {
+  bool isZeroless = this->isZeroless;
+  for (const auto property : properties) {
+    switch (property) {
+      case ModeFormat::ZEROLESS:
+        isZeroless = true;
+        break;
+      case ModeFormat::NOT_ZEROLESS:
+        isZeroless = false;
+        break;
+      default:
+        break;
+    }
+  }
+  return ModeFormat(std::make_shared<RleModeFormat>(isZeroless, allocSize));
+}
+
+ModeFunction RleModeFormat::posIterBounds(Expr parentPos, Mode mode) const {
+  ModeFunction runBounds = runIterBounds(parentPos, mode);
+  Expr runArray = getRunArray(mode.getModePack());
+  Expr pbegin = Load::make(runArray, ir::Add::make(getRunLoc(runBounds[0]), 1));
+  Expr pend = Load::make(runArray, ir::Add::make(getRunLoc(runBounds[1]), 1));
+  return ModeFunction(Stmt(), {pbegin, pend});
+}
+
+ModeFunction RleModeFormat::posIterAccess(Expr pos, std::vector<Expr> coords,
+                                          Mode mode) const {
+  taco_iassert(mode.getPackLocation() == 0);
+  Expr idx = ir::Call::make("taco_rle_coord",
+                            {getRunArray(mode.getModePack()), pos}, Int());
+  return ModeFunction(Stmt(), {idx, true});
+}
+
+bool RleModeFormat::hasRunIter() const {
+  return true;
+}
+
+ModeFunction RleModeFormat::runIterBounds(Expr parentPos, Mode mode) const {
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr rbegin = Load::make(posArray, parentPos);
+  Expr rend = Load::make(posArray, ir::Add::make(parentPos, 1));
+  return ModeFunction(Stmt(), {rbegin, rend});
+}
+
+ModeFunction RleModeFormat::runIterAccess(Expr runPos, Mode mode) const {
+  Expr runArray = getRunArray(mode.getModePack());
+  Expr loc = getRunLoc(runPos);
+  Expr pbegin = Load::make(runArray, ir::Add::make(loc, 1));
+  Expr pend = Load::make(runArray, ir::Add::make(loc, 3));
+  Expr idx = Load::make(runArray, loc);
+  return ModeFunction(Stmt(), {pbegin, pend, idx});
+}
+
+ModeFunction RleModeFormat::runIterLocate(Expr pos, Mode mode) const {
+  Expr run = ir::Call::make("taco_rle_run",
+                            {getRunArray(mode.getModePack()), pos}, Int());
+  return ModeFunction(Stmt(), {run});
+}
+
+Stmt RleModeFormat::getAppendCoord(Expr p, Expr i, Mode mode) const {
+  taco_iassert(mode.getModePack().getNumModes() == 1);
+
+  // Coordinates that do not extend the last run start a new run.
+  Expr runArray = getRunArray(mode.getModePack());
+  Expr numRuns = getNumRunsVar(mode);
+  Expr nextCoord = getNextCoordVar(mode);
+  Expr loc = getRunLoc(numRuns);
+  Stmt startRun = Block::make(
+      doubleSizeIfFull(runArray, getRunCapacity(mode), ir::Add::make(loc, 1)),
+      Store::make(runArray, loc, i),
+      Store::make(runArray, ir::Add::make(loc, 1), p),
+      compoundAssign(numRuns, 1));
+  return Block::make(IfThenElse::make(Neq::make(i, nextCoord), startRun),
+                     Assign::make(nextCoord, ir::Add::make(i, 1)));
+}
+
+Stmt RleModeFormat::getAppendEdges(Expr pPrev, Expr pBegin, Expr pEnd,
+                                   Mode mode) const {
+  // Runs never span two segments, so the next appended coordinate starts a
+  // new run.
+  Expr posArray = getPosArray(mode.getModePack());
+  return Block::make(
+      Store::make(posArray, ir::Add::make(pPrev, 1), getNumRunsVar(mode)),
+      Assign::make(getNextCoordVar(mode), -1));
+}
+
+Expr RleModeFormat::getSize(Expr szPrev, Mode mode) const {
+  Expr numRuns = Load::make(getPosArray(mode.getModePack()), szPrev);
+  return Load::make(getRunArray(mode.getModePack()),
+                    ir::Add::make(getRunLoc(numRuns), 1));
+}
+
+Stmt RleModeFormat::getAppendInitEdges(Expr pPrevBegin, Expr pPrevEnd,
+                                       Mode mode) const {
+  if (isa<ir::Literal>(pPrevBegin)) {
+    taco_iassert(to<ir::Literal>(pPrevBegin)->equalsScalar(0));
+    return Stmt();
+  }
+
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr posCapacity = getPosCapacity(mode);
+  ModeFormat parentModeType = mode.getParentModeType();
+  if (!parentModeType.defined() || parentModeType.hasAppend()) {
+    return doubleSizeIfFull(posArray, posCapacity, pPrevEnd);
+  }
+
+  Expr pVar = Var::make("p" + mode.getName(), Int());
+  Expr lb = ir::Add::make(pPrevBegin, 1);
+  Expr ub = ir::Add::make(pPrevEnd, 1);
+  Stmt initPos = For::make(pVar, lb, ub, 1, Store::make(posArray, pVar, 0));
+  Stmt maybeResizePos = atLeastDoubleSizeIfFull(posArray, posCapacity, pPrevEnd);
+  return Block::make({maybeResizePos, initPos});
+}
+
+Stmt RleModeFormat::getAppendInitLevel(Expr szPrev, Expr sz,
+                                       Mode mode) const {
+  const bool szPrevIsZero = isa<ir::Literal>(szPrev) &&
+                            to<ir::Literal>(szPrev)->equalsScalar(0);
+
+  Expr defaultCapacity = ir::Literal::make(allocSize, Datatype::Int32);
+  Expr posArray = getPosArray(mode.getModePack());
+  Expr initCapacity = szPrevIsZero ? defaultCapacity : ir::Add::make(szPrev, 1);
+  Expr posCapacity = initCapacity;
+
+  std::vector<Stmt> initStmts;
+  if (szPrevIsZero) {
+    posCapacity = getPosCapacity(mode);
+    initStmts.push_back(VarDecl::make(posCapacity, initCapacity));
+  }
+  initStmts.push_back(Allocate::make(posArray, posCapacity));
+  initStmts.push_back(Store::make(posArray, 0, 0));
+
+  if (mode.getParentModeType().defined() &&
+      !mode.getParentModeType().hasAppend() && !szPrevIsZero) {
+    Expr pVar = Var::make("p" + mode.getName(), Int());
+    Stmt storePos = Store::make(posArray, pVar, 0);
+    initStmts.push_back(For::make(pVar, 1, initCapacity, 1, storePos));
+  }
+
+  Expr runCapacity = getRunCapacity(mode);
+  initStmts.push_back(VarDecl::make(runCapacity, defaultCapacity));
+  initStmts.push_back(Allocate::make(getRunArray(mode.getModePack()),
+                                     runCapacity));
+  initStmts.push_back(VarDecl::make(getNumRunsVar(mode), 0));
+  initStmts.push_back(VarDecl::make(getNextCoordVar(mode), -1));
+  return Block::make(initStmts);
+}
+
+Stmt RleModeFormat::getAppendFinalizeLevel(Expr szPrev, Expr sz,
+                                           Mode mode) const {
+  std::vector<Stmt> finalizeStmts;
+
+  // Segments of parent positions that were not visited store zero, so the
+  // run offsets are completed by carrying forward the last run offset.
+  ModeFormat parentModeType = mode.getParentModeType();
+  if (!(isa<ir::Literal>(szPrev) && to<ir::Literal>(szPrev)->equalsScalar(1))
+      && parentModeType.defined() && !parentModeType.hasAppend()) {
+    Expr posArray = getPosArray(mode.getModePack());
+    Expr pVar = Var::make("p" + mode.getName(), Int());
+    Expr carry = ir::Max::make(Load::make(posArray, pVar),
+                               Load::make(posArray, ir::Sub::make(pVar, 1)));
+    finalizeStmts.push_back(For::make(pVar, 1, ir::Add::make(szPrev, 1), 1,
+                                      Store::make(posArray, pVar, carry)));
+  }
+
+  Expr runArray = getRunArray(mode.getModePack());
+  Expr numRuns = getNumRunsVar(mode);
+  Expr endLoc = ir::Add::make(getRunLoc(numRuns), 1);
+  finalizeStmts.push_back(atLeastDoubleSizeIfFull(runArray,
+                                                  getRunCapacity(mode),
+                                                  endLoc));
+  finalizeStmts.push_back(Store::make(runArray, 0, numRuns));
+  finalizeStmts.push_back(Store::make(runArray, endLoc, sz));
+  return Block::make(finalizeStmts);
+}
+
+vector<Expr> RleModeFormat::getArrays(Expr tensor, int mode, int level) const {
+  std::string arraysName = util::toString(tensor) + std::to_string(level);
+  return {GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 0, arraysName + "_pos"),
+          GetProperty::make(tensor, TensorProperty::Indices,
+                            level - 1, 1, arraysName + "_run")};
+}
+
+Expr RleModeFormat::getPosArray(ModePack pack) const {
+  return pack.getArray(0);
+}
+
+Expr RleModeFormat::getRunArray(ModePack pack) const {
+  return pack.getArray(1);
+}
+
+Expr RleModeFormat::getRunLoc(Expr runPos) const {
+  return ir::Add::make(ir::Mul::make(runPos, 2), 1);
+}
+
+Expr RleModeFormat::getPosCapacity(Mode mode) const {
+  return getModeVar(mode, "_pos_size");
+}
+
+Expr RleModeFormat::getRunCapacity(Mode mode) const {
+  return getModeVar(mode, "_run_size");
+}
+
+Expr RleModeFormat::getNumRunsVar(Mode mode) const {
+  return getModeVar(mode, "_num_runs");
+}
+
+Expr RleModeFormat::getNextCoordVar(Mode mode) const {
+  return getModeVar(mode, "_next_crd");
+}
+
+Expr RleModeFormat::getModeVar(Mode mode, const std::string& suffix) const {
+  const std::string varName = mode.getName() + suffix;
+
+  if (!mode.hasVar(varName)) {
+    Expr var = Var::make(varName, Int());
+    mode.addVar(varName, var);
+    return var;
+  }
+
+  return mode.getVar(varName);
+}
+
+bool RleModeFormat::equals(const ModeFormatImpl& other) const {
+  return ModeFormatImpl::equals(other) &&
+         (dynamic_cast<const RleModeFormat&>(other).allocSize == allocSize);
+}
+
+}
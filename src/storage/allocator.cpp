@@ -0,0 +1,201 @@
+#include "taco/storage/allocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "taco/error.h"
+
+using namespace std;
+
+namespace taco {
+
+// class Allocator
+size_t Allocator::getAlignment() const {
+  return 0;
+}
+
+
+// class MallocAllocator
+void* MallocAllocator::allocate(size_t size) {
+  return malloc(size);
+}
+
+void* MallocAllocator::reallocate(void* ptr, size_t size) {
+  return realloc(ptr, size);
+}
+
+void MallocAllocator::deallocate(void* ptr) {
+  free(ptr);
+}
+
+
+// class AlignedAllocator
+AlignedAllocator::AlignedAllocator(size_t alignment) : alignment(alignment) {
+  taco_uassert(alignment >= sizeof(size_t) &&
+               (alignment & (alignment - 1)) == 0) <<
+      "The alignment of an allocator must be a power of two of at least " <<
+      sizeof(size_t) << " bytes";
+}
+
+void* AlignedAllocator::allocate(size_t size) {
+  // The size is stored at the end of the padding that aligns the allocation
+  char* block = (char*)allocateBlock(size + alignment);
+  taco_uassert(block != nullptr) << "Failed to allocate " << size << " bytes";
+  *(size_t*)(block + alignment - sizeof(size_t)) = size;
+  return block + alignment;
+}
+
+void* AlignedAllocator::reallocate(void* ptr, size_t size) {
+  if (ptr == nullptr) {
+    return allocate(size);
+  }
+  const size_t oldSize = *(size_t*)((char*)ptr - sizeof(size_t));
+  if (size <= oldSize) {
+    *(size_t*)((char*)ptr - sizeof(size_t)) = size;
+    return ptr;
+  }
+  void* resized = allocate(size);
+  memcpy(resized, ptr, oldSize);
+  deallocate(ptr);
+  return resized;
+}
+
+void AlignedAllocator::deallocate(void* ptr) {
+  if (ptr != nullptr) {
+    deallocateBlock((char*)ptr - alignment);
+  }
+}
+
+size_t AlignedAllocator::getAlignment() const {
+  return alignment;
+}
+
+void* AlignedAllocator::allocateBlock(size_t size) {
+  void* block = nullptr;
+  return (posix_memalign(&block, alignment, size) == 0) ? block : nullptr;
+}
+
+void AlignedAllocator::deallocateBlock(void* block) {
+  free(block);
+}
+
+
+// class HugePageAllocator
+HugePageAllocator::HugePageAllocator(size_t alignment, size_t hugePageSize)
+    : AlignedAllocator(alignment), hugePageSize(hugePageSize) {
+  taco_uassert(hugePageSize >= alignment &&
+               (hugePageSize & (hugePageSize - 1)) == 0) <<
+      "The huge page size must be a power of two of at least the alignment";
+}
+
+void* HugePageAllocator::allocateBlock(size_t size) {
+  if (size < hugePageSize) {
+    return AlignedAllocator::allocateBlock(size);
+  }
+  void* block = nullptr;
+  if (posix_memalign(&block, hugePageSize, size) != 0) {
+    return nullptr;
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // The advice is a hint, so failures (e.g., because transparent huge pages
+  // are disabled) are ignored.
+  madvise(block, size, MADV_HUGEPAGE);
+#endif
+  return block;
+}
+
+
+// class ArenaAllocator
+ArenaAllocator::ArenaAllocator(size_t alignment, size_t chunkSize)
+    : AlignedAllocator(alignment), chunkSize(chunkSize) {
+}
+
+ArenaAllocator::~ArenaAllocator() {
+  reset();
+}
+
+void ArenaAllocator::reset() {
+  lock_guard<std::mutex> lock(mutex);
+  for (auto& chunk : chunks) {
+    free(chunk.first);
+  }
+  chunks.clear();
+  chunkOffset = 0;
+}
+
+size_t ArenaAllocator::getCapacity() const {
+  lock_guard<std::mutex> lock(mutex);
+  size_t capacity = 0;
+  for (auto& chunk : chunks) {
+    capacity += chunk.second;
+  }
+  return capacity;
+}
+
+void* ArenaAllocator::allocateBlock(size_t size) {
+  lock_guard<std::mutex> lock(mutex);
+  size = (size + alignment - 1) & ~(alignment - 1);
+  if (chunks.empty() || chunkOffset + size > chunks.back().second) {
+    const size_t newChunkSize = max(chunkSize, size);
+    void* chunk = nullptr;
+    if (posix_memalign(&chunk, alignment, newChunkSize) != 0) {
+      return nullptr;
+    }
+    chunks.push_back({(char*)chunk, newChunkSize});
+    chunkOffset = 0;
+  }
+  char* block = chunks.back().first + chunkOffset;
+  chunkOffset += size;
+  return block;
+}
+
+void ArenaAllocator::deallocateBlock(void* block) {
+  // Memory is reclaimed when the arena is reset
+}
+
+
+static std::shared_ptr<Allocator> allocator = make_shared<MallocAllocator>();
+static std::mutex allocatorMutex;
+
+std::shared_ptr<Allocator> getAllocator() {
+  lock_guard<std::mutex> lock(allocatorMutex);
+  return allocator;
+}
+
+void setAllocator(std::shared_ptr<Allocator> newAllocator) {
+  taco_uassert(newAllocator != nullptr) << "The allocator must be defined";
+  lock_guard<std::mutex> lock(allocatorMutex);
+  allocator = newAllocator;
+}
+
+static void* kernelAllocate(void* allocator, size_t size) {
+  return ((Allocator*)allocator)->allocate(size);
+}
+
+static void* kernelReallocate(void* allocator, void* ptr, size_t size) {
+  return ((Allocator*)allocator)->reallocate(ptr, size);
+}
+
+static void kernelDeallocate(void* allocator, void* ptr) {
+  ((Allocator*)allocator)->deallocate(ptr);
+}
+
+taco_allocator_t getKernelAllocator(Allocator* allocator) {
+  return {allocator, kernelAllocate, kernelReallocate, kernelDeallocate};
+}
+
+static bool workspacePoolEnabled = false;
+
+bool should_use_workspace_pool() {
+  return workspacePoolEnabled;
+}
+
+void set_workspace_pool_enabled(bool enabled) {
+  workspacePoolEnabled = enabled;
+}
+
+}
@@ -8,6 +8,7 @@
 #include "taco/util/uncopyable.h"
 #include "taco/util/strings.h"
 #include "taco/cuda.h"
+#include "taco/storage/allocator.h"
 
 using namespace std;
 
@@ -18,6 +19,7 @@ struct Array::Content : util::Uncopyable {
   void*  data;
   size_t size;
   Policy policy = Array::UserOwns;
+  std::shared_ptr<Allocator> allocator;
 
   ~Content() {
     switch (policy) {
@@ -32,6 +34,14 @@ struct Array::Content : util::Uncopyable {
           free(data);
         }
         break;
+      case Deallocate:
+        if (should_use_CUDA_unified_memory()) {
+          cuda_unified_free(data);
+        }
+        else {
+          allocator->deallocate(data);
+        }
+        break;
       case Delete:
         switch (type.getKind()) {
           case Datatype::Bool:
@@ -67,6 +77,12 @@ struct Array::Content : util::Uncopyable {
           case Datatype::Int128:
             delete[] ((long long*)data);
             break;
+          case Datatype::Float16:
+            delete[] ((float16*)data);
+            break;
+          case Datatype::BFloat16:
+            delete[] ((bfloat16*)data);
+            break;
           case Datatype::Float32:
             delete[] ((float*)data);
             break;
@@ -96,6 +112,15 @@ Array::Array(Datatype type, void* data, size_t size, Policy policy) : Array() {
   content->data = data;
   content->size = size;
   content->policy = policy;
+  if (policy == Deallocate) {
+    content->allocator = getAllocator();
+  }
+}
+
+Array::Array(Datatype type, void* data, size_t size,
+             std::shared_ptr<Allocator> allocator)
+    : Array(type, data, size, Deallocate) {
+  content->allocator = allocator;
 }
 
 const Datatype& Array::getType() const {
@@ -175,6 +200,12 @@ std::ostream& operator<<(std::ostream& os, const Array& array) {
     case Datatype::Int128:
       printData<long long>(os, array);
       break;
+    case Datatype::Float16:
+      printData<float16>(os, array);
+      break;
+    case Datatype::BFloat16:
+      printData<bfloat16>(os, array);
+      break;
     case Datatype::Float32:
       printData<float>(os, array);
       break;
@@ -205,6 +236,9 @@ std::ostream& operator<<(std::ostream& os, Array::Policy policy) {
     case Array::Delete:
       os << "delete";
       break;
+    case Array::Deallocate:
+      os << "deallocate";
+      break;
   }
   return os;
 }
@@ -214,7 +248,8 @@ Array makeArray(Datatype type, size_t size) {
     return Array(type, cuda_unified_alloc(size * type.getNumBytes()), size, Array::Free);
   }
   else {
-    return Array(type, malloc(size * type.getNumBytes()), size, Array::Free);
+    return Array(type, getAllocator()->allocate(size * type.getNumBytes()),
+                 size, Array::Deallocate);
   }
 }
 
@@ -51,17 +51,19 @@ TensorBase dispatchReadMTX(std::istream& stream, const T& format, bool pack) {
                                        << "Unknown type of MatrixMarket";
   // formats = [coordinate array]
   // field = [real integer complex pattern]
-  taco_uassert(field=="real")          << "MatrixMarket field not available";
+  taco_uassert((field=="real") || (field=="pattern"))
+                                       << "MatrixMarket field not available";
   // symmetry = [general symmetric skew-symmetric Hermitian]
   taco_uassert((symmetry=="general") || (symmetry=="symmetric"))
                                        << "MatrixMarket symmetry not available";
 
   bool symm = (symmetry=="symmetric");
+  bool pattern = (field=="pattern");
 
   TensorBase tensor;
   if (formats=="coordinate")
-    tensor = readSparse(stream,format,symm);
-  else if (formats=="array")
+    tensor = readSparse(stream,format,symm,pattern);
+  else if (formats=="array" && !pattern)
     tensor = readDense(stream,format,symm);
   else
     taco_uerror << "MatrixMarket format not available";
@@ -83,7 +85,7 @@ TensorBase readMTX(std::istream& stream, const Format& format, bool pack) {
 
 template <typename T>
 TensorBase dispatchReadSparse(std::istream& stream, const T& format, 
-                              bool symm) {
+                              bool symm, bool pattern) {
   string line;
   std::getline(stream,line);
 
@@ -121,13 +123,16 @@ TensorBase dispatchReadSparse(std::istream& stream, const T& format,
       taco_uassert(index <= INT_MAX) << "Index exceeds INT_MAX";
       coordinates.push_back(static_cast<int>(index));
     }
-    double val = strtod(linePtr, &linePtr);
+    double val = pattern ? 1.0 : strtod(linePtr, &linePtr);
     values.push_back(val);
   }
 
-  // Create matrix
+  // Create matrix. Matrices whose format is symmetric store only the lower
+  // triangle, so the entries of symmetric files are inserted once instead of
+  // being expanded to both triangles.
   TensorBase tensor(type<double>(), dimensions, format);
-  if (symm)
+  const bool expand = symm && !tensor.getFormat().isSymmetric();
+  if (expand)
     tensor.reserve(2*nnz);
   else
     tensor.reserve(nnz);
@@ -139,8 +144,14 @@ TensorBase dispatchReadSparse(std::istream& stream, const T& format,
     for (size_t mode = 0; mode < dimensions.size(); mode++) {
       coord.push_back(coordinates[i*dimensions.size() + mode] -1);
     }
+    if (symm && !expand) {
+      const std::vector<int>& modes = tensor.getFormat().getSymmetricModes();
+      if (coord[modes[0]] < coord[modes[1]]) {
+        std::reverse(coord.begin(), coord.end());
+      }
+    }
     tensor.insert(coord, values[i]);
-    if (symm && coord.front() != coord.back()) {
+    if (expand && coord.front() != coord.back()) {
       std::reverse(coord.begin(), coord.end());
       tensor.insert(coord, values[i]);
     }
@@ -150,12 +161,13 @@ TensorBase dispatchReadSparse(std::istream& stream, const T& format,
 }
 
 TensorBase readSparse(std::istream& stream, const ModeFormat& modetype, 
-                      bool symm) {
-  return dispatchReadSparse(stream, modetype, symm);
+                      bool symm, bool pattern) {
+  return dispatchReadSparse(stream, modetype, symm, pattern);
 }
 
-TensorBase readSparse(std::istream& stream, const Format& format, bool symm) {
-  return dispatchReadSparse(stream, format, symm);
+TensorBase readSparse(std::istream& stream, const Format& format, bool symm,
+                      bool pattern) {
+  return dispatchReadSparse(stream, format, symm, pattern);
 }
 
 template <typename T>
@@ -292,6 +304,8 @@ void writeSparse(std::ostream& stream, const TensorBase& tensor) {
     case Datatype::Int32: writeSparseTyped<int32_t>(stream, tensor); break;
     case Datatype::Int64: writeSparseTyped<int64_t>(stream, tensor); break;
     case Datatype::Int128: writeSparseTyped<long long>(stream, tensor); break;
+    case Datatype::Float16: writeSparseTyped<float16>(stream, tensor); break;
+    case Datatype::BFloat16: writeSparseTyped<bfloat16>(stream, tensor); break;
     case Datatype::Float32: writeSparseTyped<float>(stream, tensor); break;
     case Datatype::Float64: writeSparseTyped<double>(stream, tensor); break;
     case Datatype::Complex64: writeSparseTyped<std::complex<float>>(stream, tensor); break;
@@ -342,6 +356,8 @@ void writeDense(std::ostream& stream, const TensorBase& tensor) {
     case Datatype::Int32: writeDenseTyped<int32_t>(stream, tensor); break;
     case Datatype::Int64: writeDenseTyped<int64_t>(stream, tensor); break;
     case Datatype::Int128: writeDenseTyped<long long>(stream, tensor); break;
+    case Datatype::Float16: writeDenseTyped<float16>(stream, tensor); break;
+    case Datatype::BFloat16: writeDenseTyped<bfloat16>(stream, tensor); break;
     case Datatype::Float32: writeDenseTyped<float>(stream, tensor); break;
     case Datatype::Float64: writeDenseTyped<double>(stream, tensor); break;
     case Datatype::Complex64: writeDenseTyped<std::complex<float>>(stream, tensor); break;
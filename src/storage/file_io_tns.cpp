@@ -135,6 +135,8 @@ void writeTNS(std::ostream& stream, const TensorBase& tensor) {
     case Datatype::Int32: writeTypedTNS<int32_t>(stream, tensor); break;
     case Datatype::Int64: writeTypedTNS<int64_t>(stream, tensor); break;
     case Datatype::Int128: writeTypedTNS<long long>(stream, tensor); break;
+    case Datatype::Float16: writeTypedTNS<float16>(stream, tensor); break;
+    case Datatype::BFloat16: writeTypedTNS<bfloat16>(stream, tensor); break;
     case Datatype::Float32: writeTypedTNS<float>(stream, tensor); break;
     case Datatype::Float64: writeTypedTNS<double>(stream, tensor); break;
     case Datatype::Complex64: writeTypedTNS<std::complex<float>>(stream, tensor); break;
@@ -59,6 +59,21 @@ size_t Index::getSize() const {
       size *= modeIndex.getIndexArray(0).get(0).getAsIndex();
     } else if (modeType.getName() == Sparse.getName()) {
       size = modeIndex.getIndexArray(0).get(size).getAsIndex();
+    } else if (modeType.getName() == Hashed.getName()) {
+      size = modeIndex.getIndexArray(0).get(size).getAsIndex();
+    } else if (modeType.getName() == Bitmap.getName()) {
+      size *= modeIndex.getIndexArray(0).get(0).getAsIndex();
+    } else if (modeType.getName() == Dia.getName()) {
+      size *= modeIndex.getIndexArray(0).get(0).getAsIndex() + 1;
+    } else if (modeType.getName() == Rle.getName()) {
+      const size_t numRuns = modeIndex.getIndexArray(0).get(size).getAsIndex();
+      size = modeIndex.getIndexArray(1).get(2 * numRuns + 2).getAsIndex();
+    } else if (modeType.getName() == Ell.getName()) {
+      const Array& slices = modeIndex.getIndexArray(0);
+      const size_t sliceHeight = slices.get(0).getAsIndex();
+      size = (sliceHeight == 0) 
+             ? size * slices.get(1).getAsIndex()
+             : slices.get((size + sliceHeight - 1) / sliceHeight + 1).getAsIndex();
     } else {
       taco_not_supported_yet;
     }
@@ -26,6 +26,7 @@ struct TensorStorage::Content {
 
   Index         index;
   Array         values;
+  Array         valuesDictionary;
 
   Literal       fillValue;
 
@@ -52,6 +53,16 @@ struct TensorStorage::Content {
         modeTypes[i] = taco_mode_sparse;
       } else if (modeType.getName() == Singleton.getName()) {
         modeTypes[i] = taco_mode_sparse;
+      } else if (modeType.getName() == Hashed.getName()) {
+        modeTypes[i] = taco_mode_sparse;
+      } else if (modeType.getName() == Bitmap.getName()) {
+        modeTypes[i] = taco_mode_sparse;
+      } else if (modeType.getName() == Ell.getName()) {
+        modeTypes[i] = taco_mode_sparse;
+      } else if (modeType.getName() == Dia.getName()) {
+        modeTypes[i] = taco_mode_sparse;
+      } else if (modeType.getName() == Rle.getName()) {
+        modeTypes[i] = taco_mode_sparse;
       } else {
         taco_not_supported_yet;
       }
@@ -105,6 +116,10 @@ Array TensorStorage::getValues() {
   return content->values;
 }
 
+const Array& TensorStorage::getValuesDictionary() const {
+  return content->valuesDictionary;
+}
+
 Literal TensorStorage::getFillValue() {
   return content->fillValue;
 }
@@ -121,7 +136,13 @@ size_t TensorStorage::getSizeInBytes() {
     }
   }
   const auto& values = getValues();
-  return indexSizeInBytes + values.getSize() * values.getType().getNumBytes();
+  size_t valuesSizeInBytes = values.getSize() * values.getType().getNumBytes();
+  if (getFormat().isDictionaryEncoded()) {
+    const auto& dictionary = getValuesDictionary();
+    valuesSizeInBytes += dictionary.getSize() *
+                         dictionary.getType().getNumBytes();
+  }
+  return indexSizeInBytes + valuesSizeInBytes;
 }
 
 TensorStorage::operator struct taco_tensor_t*() const {
@@ -165,6 +186,49 @@ TensorStorage::operator struct taco_tensor_t*() const {
         tensorData->indices[i][1] = (uint8_t*)idx.getData();
       }
     }
+    // Hashed levels have two indices (pos and idx)
+    else if (modeType.getName() == Hashed.getName()) {
+      if (modeIndex.numIndexArrays() > 0) {
+        const Array& pos = modeIndex.getIndexArray(0);
+        const Array& idx = modeIndex.getIndexArray(1);
+        tensorData->indices[i][0] = (uint8_t*)pos.getData();
+        tensorData->indices[i][1] = (uint8_t*)idx.getData();
+      }
+    }
+    // Bitmap levels have two indices (size and bits)
+    else if (modeType.getName() == Bitmap.getName()) {
+      if (modeIndex.numIndexArrays() > 0) {
+        const Array& size = modeIndex.getIndexArray(0);
+        const Array& bits = modeIndex.getIndexArray(1);
+        tensorData->indices[i][0] = (uint8_t*)size.getData();
+        tensorData->indices[i][1] = (uint8_t*)bits.getData();
+      }
+    }
+    // ELL levels have two indices (slices and idx)
+    else if (modeType.getName() == Ell.getName()) {
+      if (modeIndex.numIndexArrays() > 0) {
+        const Array& slices = modeIndex.getIndexArray(0);
+        const Array& idx = modeIndex.getIndexArray(1);
+        tensorData->indices[i][0] = (uint8_t*)slices.getData();
+        tensorData->indices[i][1] = (uint8_t*)idx.getData();
+      }
+    }
+    // Run-length levels have two indices (pos and run)
+    else if (modeType.getName() == Rle.getName()) {
+      if (modeIndex.numIndexArrays() > 0) {
+        const Array& pos = modeIndex.getIndexArray(0);
+        const Array& run = modeIndex.getIndexArray(1);
+        tensorData->indices[i][0] = (uint8_t*)pos.getData();
+        tensorData->indices[i][1] = (uint8_t*)run.getData();
+      }
+    }
+    // DIA levels have one index (offsets)
+    else if (modeType.getName() == Dia.getName()) {
+      if (modeIndex.numIndexArrays() > 0) {
+        const Array& offsets = modeIndex.getIndexArray(0);
+        tensorData->indices[i][0] = (uint8_t*)offsets.getData();
+      }
+    }
     else {
       taco_not_supported_yet;
     }
@@ -172,6 +236,7 @@ TensorStorage::operator struct taco_tensor_t*() const {
 
   tensorData->vals  = (uint8_t*)getValues().getData();
   tensorData->fill_value = (uint8_t*) content->fillValue.getValPtr();
+  tensorData->vals_dict = (uint8_t*)getValuesDictionary().getData();
 
   return content->tensorData;
 }
@@ -184,6 +249,10 @@ void TensorStorage::setValues(const Array& values) {
   content->values = values;
 }
 
+void TensorStorage::setValuesDictionary(const Array& dictionary) {
+  content->valuesDictionary = dictionary;
+}
+
 bool equals(TensorStorage a, TensorStorage b) {
   return false;
 }
@@ -192,7 +261,24 @@ std::ostream& operator<<(std::ostream& os, const TensorStorage& storage) {
   if (storage.getOrder() > 0) {
     os << storage.getIndex() << std::endl;
   }
-  return os << storage.getValues();
+  os << storage.getValues();
+  if (storage.getFormat().isDictionaryEncoded()) {
+    os << std::endl << storage.getValuesDictionary();
+  }
+  return os;
+}
+
+void checkValuesAlignment(const std::vector<void*>& tensors, size_t alignment) {
+  if (alignment == 0) {
+    return;
+  }
+  for (void* tensor : tensors) {
+    const uint8_t* vals = ((taco_tensor_t*)tensor)->vals;
+    taco_uassert((uintptr_t)vals % alignment == 0)
+        << "The kernel assumes that values arrays have the " << alignment
+        << "-byte alignment of the allocator it was compiled with, but the "
+        << "values array of a tensor is not aligned";
+  }
 }
 
 }
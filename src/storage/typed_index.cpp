@@ -23,6 +23,8 @@ size_t TypedIndex::getAsIndex(const IndexTypeUnion& mem) const {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -46,6 +48,8 @@ void TypedIndex::set(IndexTypeUnion& mem, const IndexTypeUnion& value) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -67,6 +71,8 @@ void TypedIndex::setInt(IndexTypeUnion& mem, const int value) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -88,6 +94,8 @@ void TypedIndex::add(IndexTypeUnion& result, const IndexTypeUnion& a, const Inde
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -109,6 +117,8 @@ void TypedIndex::addInt(IndexTypeUnion& result, const IndexTypeUnion& a, const i
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -130,6 +140,8 @@ void TypedIndex::multiply(IndexTypeUnion& result, const IndexTypeUnion& a, const
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -151,6 +163,8 @@ void TypedIndex::multiplyInt(IndexTypeUnion& result, const IndexTypeUnion& a, co
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -214,6 +228,8 @@ void TypedIndexVal::set(TypedComponentVal value) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -235,6 +251,8 @@ void TypedIndexVal::set(TypedComponentRef value) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -426,6 +444,8 @@ bool operator>(const TypedIndexVal& a, const TypedIndexVal &other) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -450,6 +470,8 @@ bool operator==(const TypedIndexVal& a, const TypedIndexVal &other) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -489,6 +511,8 @@ bool operator>(const TypedIndexVal& a, const int other) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
@@ -512,6 +536,8 @@ bool operator==(const TypedIndexVal& a, const int other) {
     case Datatype::Bool:
     case Datatype::UInt128:
     case Datatype::Int128:
+    case Datatype::Float16:
+    case Datatype::BFloat16:
     case Datatype::Float32:
     case Datatype::Float64:
     case Datatype::Complex64:
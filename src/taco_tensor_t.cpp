@@ -39,6 +39,7 @@ taco_tensor_t* init_taco_tensor_t(int32_t order, int32_t csize,
   t->mode_types = (taco_mode_t *) alloc_mem(order * sizeof(taco_mode_t));
   t->indices = (uint8_t ***) alloc_mem(order * sizeof(uint8_t***));
   t->csize         = csize;
+  t->vals_dict     = NULL;
 
   int fill_bytes = csize / 8;
   t->fill_value = (uint8_t*) alloc_mem(fill_bytes);
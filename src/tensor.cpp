@@ -1,6 +1,8 @@
 #include "taco/tensor.h"
 
 #include <set>
+#include <map>
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <sstream>
@@ -9,6 +11,7 @@
 #include <vector>
 #include <utility>
 #include <mutex>
+#include <unordered_map>
 
 #include "taco/cuda.h"
 #include "taco/format.h"
@@ -28,6 +31,7 @@
 #include "taco/storage/storage.h"
 #include "taco/storage/index.h"
 #include "taco/storage/array.h"
+#include "taco/storage/allocator.h"
 #include "taco/storage/pack.h"
 #include "taco/storage/file_io_tns.h"
 #include "taco/storage/file_io_mtx.h"
@@ -99,6 +103,20 @@ static Format initFormat(Format format) {
       } else if (modeType.getName() == Singleton.getName()) {
         arrayTypes.push_back(Int32);
         arrayTypes.push_back(Int32);
+      } else if (modeType.getName() == Hashed.getName()) {
+        arrayTypes.push_back(Int32);
+        arrayTypes.push_back(Int32);
+      } else if (modeType.getName() == Bitmap.getName()) {
+        arrayTypes.push_back(Int32);
+        arrayTypes.push_back(UInt64);
+      } else if (modeType.getName() == Ell.getName()) {
+        arrayTypes.push_back(Int32);
+        arrayTypes.push_back(Int32);
+      } else if (modeType.getName() == Dia.getName()) {
+        arrayTypes.push_back(Int32);
+      } else if (modeType.getName() == Rle.getName()) {
+        arrayTypes.push_back(Int32);
+        arrayTypes.push_back(Int32);
       } else {
         taco_not_supported_yet;
       }
@@ -261,7 +279,8 @@ static int lexicographicalCmp(const void* a, const void* b) {
 }
 
 static size_t unpackTensorData(const taco_tensor_t& tensorData,
-                               const TensorBase& tensor) {
+                               const TensorBase& tensor,
+                               std::shared_ptr<Allocator> allocator) {
   auto storage = tensor.getStorage();
   auto format = storage.getFormat();
 
@@ -274,23 +293,144 @@ static size_t unpackTensorData(const taco_tensor_t& tensorData,
       modeIndices.push_back(ModeIndex({size}));
       numVals *= ((int*)tensorData.indices[i][0])[0];
     } else if (modeType.getName() == Sparse.getName()) {
-      auto size = ((int*)tensorData.indices[i][0])[numVals];
-      Array pos = Array(type<int>(), tensorData.indices[i][0], numVals+1, Array::UserOwns);
-      Array idx = Array(type<int>(), tensorData.indices[i][1], size, Array::UserOwns);
+      Array pos = Array(format.getCoordinateTypePos(i), 
+                        tensorData.indices[i][0], numVals+1, Array::UserOwns);
+      auto size = pos.get(numVals).getAsIndex();
+      Array idx = Array(format.getCoordinateTypeIdx(i), 
+                        tensorData.indices[i][1], size, Array::UserOwns);
       modeIndices.push_back(ModeIndex({pos, idx}));
       numVals = size;
     } else if (modeType.getName() == Singleton.getName()) {
-      Array idx = Array(type<int>(), tensorData.indices[i][1], numVals, Array::UserOwns);
+      Array idx = Array(format.getCoordinateTypeIdx(i), 
+                        tensorData.indices[i][1], numVals, Array::UserOwns);
       modeIndices.push_back(ModeIndex({makeArray(type<int>(), 0), idx}));
+    } else if (modeType.getName() == Hashed.getName()) {
+      // The tables of the parent positions lie between consecutive positions
+      Array pos = Array(type<int>(), tensorData.indices[i][0], numVals+1, 
+                        Array::UserOwns);
+      auto size = pos.get(numVals).getAsIndex();
+      Array idx = Array(format.getCoordinateTypeIdx(i), 
+                        tensorData.indices[i][1], size, Array::UserOwns);
+      modeIndices.push_back(ModeIndex({pos, idx}));
+      numVals = size;
+    } else if (modeType.getName() == Bitmap.getName()) {
+      const int size = tensorData.dimensions[tensorData.mode_ordering[i]];
+      const size_t numWords = numVals * ((size + 63) / 64);
+      Array bits = Array(format.getCoordinateTypeIdx(i), 
+                         tensorData.indices[i][1], numWords, Array::UserOwns);
+      modeIndices.push_back(ModeIndex({makeArray({size}), bits}));
+      numVals *= size;
+    } else if (modeType.getName() == Ell.getName()) {
+      // The slice array stores the slice height followed by the slice offsets,
+      // or a slice height of zero followed by the width
+      const int* sliceData = (int*)tensorData.indices[i][0];
+      const size_t sliceHeight = sliceData[0];
+      const size_t numSlices = (sliceHeight == 0) ? 0 :
+                               (numVals + sliceHeight - 1) / sliceHeight;
+      const size_t size = (sliceHeight == 0) ? numVals * sliceData[1] :
+                          sliceData[numSlices + 1];
+      Array slices = Array(type<int>(), tensorData.indices[i][0], 
+                           numSlices + 2, Array::UserOwns);
+      Array idx = Array(format.getCoordinateTypeIdx(i), 
+                        tensorData.indices[i][1], size, Array::UserOwns);
+      modeIndices.push_back(ModeIndex({slices, idx}));
+      numVals = size;
+    } else if (modeType.getName() == Dia.getName()) {
+      // Every parent position stores its diagonals followed by an overflow
+      // slot
+      const int numDiagonals = ((int*)tensorData.indices[i][0])[0];
+      Array offsets = Array(type<int>(), tensorData.indices[i][0], 
+                            numDiagonals + 1, Array::UserOwns);
+      modeIndices.push_back(ModeIndex({offsets}));
+      numVals *= numDiagonals + 1;
+    } else if (modeType.getName() == Rle.getName()) {
+      // The run array stores the number of runs, the first coordinate and 
+      // position of every run, and the number of positions
+      Array pos = Array(format.getCoordinateTypePos(i), 
+                        tensorData.indices[i][0], numVals+1, Array::UserOwns);
+      const size_t numRuns = pos.get(numVals).getAsIndex();
+      Array run = Array(format.getCoordinateTypeIdx(i), 
+                        tensorData.indices[i][1], 2*numRuns+3, Array::UserOwns);
+      modeIndices.push_back(ModeIndex({pos, run}));
+      numVals = run.get(2*numRuns+2).getAsIndex();
     } else {
       taco_not_supported_yet;
     }
   }
   storage.setIndex(Index(format, modeIndices));
-  storage.setValues(Array(tensor.getComponentType(), tensorData.vals, numVals));
+  // Pattern tensors have no values array
+  storage.setValues(format.isPattern()
+                    ? Array(tensor.getComponentType(), nullptr, 0)
+                    : Array(tensor.getComponentType(), tensorData.vals, numVals,
+                            allocator));
   return numVals;
 }
 
+/// Asserts that the overflow slots of a DIA level hold only the fill value,
+/// since packed components that do not lie on any of the diagonals are
+/// written to them and would otherwise be lost. Only packing checks the
+/// overflow slots, which spares compute a scan over the values.
+static void checkDiaOverflow(const TensorBase& tensor) {
+  auto storage = tensor.getStorage();
+  auto format = storage.getFormat();
+  const int last = tensor.getOrder() - 1;
+  if (last < 0 || format.isPattern() ||
+      format.getModeFormats()[last].getName() != Dia.getName()) {
+    return;
+  }
+
+  const Array& offsets = storage.getIndex().getModeIndex(last).getIndexArray(0);
+  const size_t width = offsets.get(0).getAsIndex() + 1;
+  const size_t csize = tensor.getComponentType().getNumBytes();
+  const Array& values = storage.getValues();
+  Literal fillValue = storage.getFillValue();
+  const std::vector<char> zero(csize, 0);
+  const char* fill = fillValue.defined() ? (const char*)fillValue.getValPtr()
+                                         : zero.data();
+  for (size_t overflow = width - 1; overflow < values.getSize(); 
+       overflow += width) {
+    taco_uassert(memcmp((const char*)values.getData() + overflow * csize,
+                        fill, csize) == 0)
+        << tensor.getName() << " has nonzero components that do not lie on "
+        << "any of the diagonals of its DIA level";
+  }
+}
+
+/// Replaces the values of a dictionary-encoded storage with the codes of the
+/// values in a dictionary of its distinct values.
+static void encodeValues(TensorStorage storage, size_t numVals) {
+  const Datatype codeType = storage.getFormat().getValueCodeType();
+  const size_t maxCodes = (size_t)1 << codeType.getNumBits();
+  const size_t csize = storage.getComponentType().getNumBytes();
+  const char* values = (const char*)storage.getValues().getData();
+
+  // Distinct values are identified by their bytes
+  std::unordered_map<std::string, size_t> codes;
+  std::string dictionaryBytes;
+  Array codeArray = makeArray(codeType, numVals);
+  for (size_t i = 0; i < numVals; ++i) {
+    std::string value(values + i * csize, csize);
+    auto code = codes.find(value);
+    if (code == codes.end()) {
+      taco_uassert(codes.size() < maxCodes)
+          << "The tensor has more than " << maxCodes << " distinct values, "
+          << "which cannot be encoded with " << codeType << " codes";
+      code = codes.insert({value, codes.size()}).first;
+      dictionaryBytes += value;
+    }
+    if (codeType == UInt8) {
+      ((uint8_t*)codeArray.getData())[i] = (uint8_t)code->second;
+    } else {
+      ((uint16_t*)codeArray.getData())[i] = (uint16_t)code->second;
+    }
+  }
+
+  Array dictionary = makeArray(storage.getComponentType(), codes.size());
+  memcpy(dictionary.getData(), dictionaryBytes.data(), dictionaryBytes.size());
+  storage.setValues(codeArray);
+  storage.setValuesDictionary(dictionary);
+}
+
 /// Pack coordinates into a data structure given by the tensor format.
 void TensorBase::pack() {
   if (!needsPack()) {
@@ -336,6 +476,12 @@ void TensorBase::pack() {
       case Datatype::Int64:
         reinsertPackedComponents<int64_t>();
         break;
+      case Datatype::Float16:
+        reinsertPackedComponents<float16>();
+        break;
+      case Datatype::BFloat16:
+        reinsertPackedComponents<bfloat16>();
+        break;
       case Datatype::Float32:
         reinsertPackedComponents<float>();
         break;
@@ -359,7 +505,7 @@ void TensorBase::pack() {
   const std::vector<int>& dimensions = getDimensions();
 
   taco_iassert((content->coordinateBufferUsed % content->coordinateSize) == 0);
-  const size_t numCoordinates = content->coordinateBufferUsed / content->coordinateSize;
+  size_t numCoordinates = content->coordinateBufferUsed / content->coordinateSize;
 
   const auto helperFuncs = getHelperFunctions(getFormat(), getComponentType(),
                                               dimensions);
@@ -381,17 +527,81 @@ void TensorBase::pack() {
     bufferStorage->indices[0][0] = (uint8_t*)pos.data();
     bufferStorage->indices[0][1] = (uint8_t*)bufferCoords.data();
 
-    bufferStorage->vals = (uint8_t*)content->coordinateBuffer->data();
+    // The pack kernel assumes the values have the alignment of its allocator,
+    // if it has one, so the values are then copied to an aligned array
+    Array values;
+    if (helperFuncs->getAllocator()->getAlignment() > 0) {
+      values = makeArray(getComponentType(), numCoordinates);
+      memcpy(values.getData(), content->coordinateBuffer->data(),
+             numCoordinates * csize);
+      bufferStorage->vals = (uint8_t*)values.getData();
+    } else {
+      bufferStorage->vals = (uint8_t*)content->coordinateBuffer->data();
+    }
 
     std::vector<void*> arguments = {content->storage, bufferStorage};
     helperFuncs->callFuncPacked("pack", arguments.data());
-    content->valuesSize = unpackTensorData(*((taco_tensor_t*)arguments[0]), *this);
+    content->valuesSize = unpackTensorData(*((taco_tensor_t*)arguments[0]),
+                                           *this, helperFuncs->getAllocator());
 
     deinit_taco_tensor_t(bufferStorage);
     content->coordinateBuffer->clear();
     return;
   }
 
+  // Symmetric tensors only store the lower triangle of their symmetric modes.
+  // Components inserted into the upper triangle are mirrored into the lower
+  // triangle, unless their mirror images were inserted too, in which case 
+  // they must have the same values and are dropped.
+  if (getFormat().isSymmetric()) {
+    const int rowMode = getFormat().getSymmetricModes()[0];
+    const int colMode = getFormat().getSymmetricModes()[1];
+    std::map<std::vector<int>,std::string> lowerValues;
+    char* readPtr = content->coordinateBuffer->data();
+    for (size_t i = 0; i < numCoordinates; ++i) {
+      int* coordinate = (int*)readPtr;
+      if (coordinate[rowMode] >= coordinate[colMode]) {
+        std::vector<int> key(coordinate, coordinate + order);
+        lowerValues.insert({key, std::string((char*)(coordinate + order), 
+                                             csize)});
+      }
+      readPtr += content->coordinateSize;
+    }
+
+    readPtr = content->coordinateBuffer->data();
+    char* writePtr = readPtr;
+    size_t numStored = 0;
+    for (size_t i = 0; i < numCoordinates; ++i) {
+      int* coordinate = (int*)readPtr;
+      bool isStored = true;
+      if (coordinate[rowMode] < coordinate[colMode]) {
+        std::vector<int> mirror(coordinate, coordinate + order);
+        std::swap(mirror[rowMode], mirror[colMode]);
+        auto lowerValue = lowerValues.find(mirror);
+        if (lowerValue != lowerValues.end()) {
+          taco_uassert(memcmp(lowerValue->second.data(), coordinate + order, 
+                              csize) == 0)
+              << "The component of " << getName() << " at ("
+              << util::join(std::vector<int>(coordinate, coordinate + order))
+              << ") differs from its mirror image at (" << util::join(mirror)
+              << "), but " << getName() << " is symmetric";
+          isStored = false;
+        } else {
+          std::swap(coordinate[rowMode], coordinate[colMode]);
+        }
+      }
+      if (isStored) {
+        if (writePtr != readPtr) {
+          memcpy(writePtr, readPtr, content->coordinateSize);
+        }
+        writePtr += content->coordinateSize;
+        numStored++;
+      }
+      readPtr += content->coordinateSize;
+    }
+    numCoordinates = numStored;
+  }
+
   // Permute the coordinates according to the storage mode ordering.
   // This is a workaround since the current pack code only packs tensors in the
   // ordering of the modes.
@@ -427,7 +637,9 @@ void TensorBase::pack() {
   for (int i = 0; i < order; ++i) {
     coordinates[i] = std::vector<int>(numCoordinates);
   }
-  char* values = (char*) malloc(numCoordinates * csize);
+  // The pack kernel assumes the values have the alignment of the allocator
+  Array valuesArray = makeArray(getComponentType(), numCoordinates);
+  char* values = (char*)valuesArray.getData();
   for (size_t i = 0; i < numCoordinates; ++i) {
     int* coordLoc = (int*)&coordinatesPtr[i * coordSize];
     for (int d = 0; d < order; ++d) {
@@ -456,9 +668,13 @@ void TensorBase::pack() {
   // Pack nonzero components into required format
   std::vector<void*> arguments = {content->storage, bufferStorage};
   helperFuncs->callFuncPacked("pack", arguments.data());
-  content->valuesSize = unpackTensorData(*((taco_tensor_t*)arguments[0]), *this);
+  content->valuesSize = unpackTensorData(*((taco_tensor_t*)arguments[0]),
+                                         *this, helperFuncs->getAllocator());
+  checkDiaOverflow(*this);
+  if (getFormat().isDictionaryEncoded()) {
+    encodeValues(getStorage(), content->valuesSize);
+  }
 
-  free(values);
   deinit_taco_tensor_t(bufferStorage);
 }
 
@@ -584,9 +800,13 @@ std::shared_ptr<Module> TensorBase::getComputeKernel(const IndexStmt stmt) {
   computeKernelsMutex.lock();
   const auto computeKernelsReverse =
       util::ReverseConstIterable<TensorBase::KernelsCache>(computeKernels);
+  const auto allocator = getAllocator();
+  const bool pooled = should_use_workspace_pool();
   for (const auto& computeKernel : computeKernelsReverse) {
-    if (isomorphic(stmt, computeKernel.first)) {
-      const auto kernelModule = computeKernel.second;
+    if (std::get<2>(computeKernel)->getAllocator() == allocator &&
+        std::get<1>(computeKernel) == pooled &&
+        isomorphic(stmt, std::get<0>(computeKernel))) {
+      const auto kernelModule = std::get<2>(computeKernel);
       computeKernelsMutex.unlock();
       return kernelModule;
     }
@@ -598,10 +818,116 @@ std::shared_ptr<Module> TensorBase::getComputeKernel(const IndexStmt stmt) {
 void TensorBase::cacheComputeKernel(const IndexStmt stmt,
                                     const std::shared_ptr<Module> kernel) {
   computeKernelsMutex.lock();
-  computeKernels.emplace_back(stmt, kernel);
+  computeKernels.emplace_back(stmt, should_use_workspace_pool(), kernel);
   computeKernelsMutex.unlock();
 }
 
+/// Returns the average number of values that `operand` stores per row (i.e.,
+/// per coordinate of its first mode), or a negative number if the operand has
+/// not been packed or stores no values. The size of the values array is used
+/// since every format supports it, unlike Index::getSize, even though it
+/// counts the padding of formats such as ELL and DIA.
+static double estimateRowSize(TensorBase operand) {
+  if (operand.needsPack() || operand.needsCompute() ||
+      operand.getFormat().isPattern() || operand.getDimension(0) == 0) {
+    return -1.0;
+  }
+  return (double)operand.getStorage().getValues().getSize() / 
+         operand.getDimension(0);
+}
+
+/// Chooses the strategies of the workspace vectors that insertTemporaries
+/// introduces (e.g., to accumulate the rows of sparse matrix products) from
+/// the expected number of components that are accumulated into them at a
+/// time, which is estimated as the product of the average number of nonzeros
+/// in the rows of the packed operands.
+static void chooseWorkspaceStrategies(IndexStmt stmt, 
+                                      map<TensorVar,TensorBase> operands) {
+  match(stmt,
+    function<void(const WhereNode*)>([&](const WhereNode* node) {
+      Where where(node);
+      TensorVar workspace = where.getTemporary();
+      if (workspace.getOrder() != 1 || 
+          !workspace.getType().getShape().getDimension(0).isFixed()) {
+        return;
+      }
+      bool estimated = true;
+      double rowSize = 1.0;
+      match(where.getProducer(),
+        function<void(const AccessNode*)>([&](const AccessNode* op) {
+          if (op->tensorVar == workspace) {
+            return;
+          }
+          if (!util::contains(operands, op->tensorVar) || 
+              op->tensorVar.getOrder() != 2) {
+            estimated = false;
+            return;
+          }
+          const double operandRowSize = 
+              estimateRowSize(operands.at(op->tensorVar));
+          if (operandRowSize < 0.0) {
+            estimated = false;
+            return;
+          }
+          rowSize *= operandRowSize;
+        })
+      );
+      if (estimated) {
+        int64_t dimension = 
+            workspace.getType().getShape().getDimension(0).getSize();
+        workspace.setWorkspaceStrategy(chooseWorkspaceStrategy(rowSize, 
+                                                               dimension));
+      }
+    })
+  );
+}
+
+/// Checks whether threads that parallelize the outer loop of `stmt` should
+/// accumulate into private copies of the dense result, which is the case when
+/// privatized reductions are enabled (see taco_set_privatized_reductions) and
+/// the result is small relative to the number of values stored by the packed
+/// operands.
+static bool shouldPrivatizeReductions(const TensorBase& result,
+                                      map<TensorVar,TensorBase> operands) {
+  if (!taco_get_privatized_reductions() || result.getOrder() == 0 || 
+      !isDense(result.getFormat())) {
+    return false;
+  }
+  int64_t resultSize = 1;
+  for (int dimension : result.getDimensions()) {
+    resultSize *= dimension;
+  }
+  int64_t work = 0;
+  for (auto& operand : operands) {
+    if (operand.second.needsPack() || operand.second.needsCompute() ||
+        operand.second.getFormat().isPattern()) {
+      return false;
+    }
+    if (operand.second.getOrder() > 0) {
+      work = std::max(work, (int64_t)operand.second.getStorage().getValues()
+                                                 .getSize());
+    }
+  }
+  return shouldPrivatizeReductions(resultSize, work, taco_get_num_threads());
+}
+
+/// Schedules `stmt` to assemble `result` with ungrouped insertion if `result`
+/// has levels that support neither appending nor inserting coordinates (e.g.,
+/// hashed levels, whose tables are sized by the number of coordinates that
+/// are inserted into them) and `stmt` does not assemble `result` already.
+static IndexStmt setComputeAssembleStrategy(IndexStmt stmt, TensorVar result) {
+  if (util::all(result.getFormat().getModeFormats(), [](ModeFormat modeFormat) {
+        return modeFormat.hasAppend() || modeFormat.hasInsert();
+      })) {
+    return stmt;
+  }
+  bool hasAssemble = false;
+  match(stmt, function<void(const AssembleNode*)>([&](const AssembleNode*) {
+    hasAssemble = true;
+  }));
+  return hasAssemble ? stmt : stmt.assemble(result, AssembleStrategy::Insert);
+}
+
 void TensorBase::compile() {
   Assignment assignment = getAssignment();
   taco_uassert(assignment.defined())
@@ -637,7 +963,9 @@ void TensorBase::compile() {
   IndexStmt stmt = makeConcreteNotation(makeReductionNotation(assignment));
   stmt = reorderLoopsTopologically(stmt);
   stmt = insertTemporaries(stmt);
-  stmt = parallelizeOuterLoop(stmt);
+  chooseWorkspaceStrategies(stmt, getTensors(assignment.getRhs()));
+  stmt = parallelizeOuterLoop(stmt, shouldPrivatizeReductions(
+      *this, getTensors(assignment.getRhs())));
   compile(stmt, content->assembleWhileCompute);
 }
 
@@ -646,9 +974,14 @@ void TensorBase::compile(taco::IndexStmt stmt, bool assembleWhileCompute) {
     return;
   }
   setNeedsCompile(false);
+  taco_uassert(!getFormat().isDictionaryEncoded())
+      << error::compile_dictionary_encoded_result;
+  taco_uassert(!getFormat().isSymmetric())
+      << error::compile_symmetric_result;
 
   IndexStmt concretizedAssign = stmt;
   IndexStmt stmtToCompile = stmt.concretize();
+  stmtToCompile = setComputeAssembleStrategy(stmtToCompile, getTensorVar());
   stmtToCompile = scalarPromote(stmtToCompile);
 
   if (!std::getenv("CACHE_KERNELS") ||
@@ -817,12 +1150,15 @@ void TensorBase::assemble() {
   }
 
   auto arguments = packArguments(*this);
+  checkValuesAlignment(arguments,
+                       content->module->getAllocator()->getAlignment());
   content->module->callFuncPacked("assemble", arguments.data());
 
   if (!content->assembleWhileCompute) {
     setNeedsAssemble(false);
     taco_tensor_t* tensorData = ((taco_tensor_t*)arguments[0]);
-    content->valuesSize = unpackTensorData(*tensorData, *this);
+    content->valuesSize = unpackTensorData(*tensorData, *this,
+                                           content->module->getAllocator());
   }
 }
 
@@ -840,12 +1176,15 @@ void TensorBase::compute() {
   }
 
   auto arguments = packArguments(*this);
+  checkValuesAlignment(arguments,
+                       content->module->getAllocator()->getAlignment());
   this->content->module->callFuncPacked("compute", arguments.data());
 
   if (content->assembleWhileCompute) {
     setNeedsAssemble(false);
     taco_tensor_t* tensorData = ((taco_tensor_t*)arguments[0]);
-    content->valuesSize = unpackTensorData(*tensorData, *this);
+    content->valuesSize = unpackTensorData(*tensorData, *this,
+                                           content->module->getAllocator());
   }
 }
 
@@ -888,6 +1227,20 @@ Assignment TensorBase::getAssignment() const {
   return content->assignment;
 }
 
+void TensorBase::setAccumulatorType(Datatype accumulatorType) {
+  Assignment assignment = getAssignment();
+  taco_uassert(assignment.defined())
+      << "Cannot set the accumulator type of a tensor without an expression";
+  if (assignment.getAccumulatorType() == accumulatorType) {
+    return;
+  }
+  setNeedsCompile(true);
+  setNeedsAssemble(true);
+  setNeedsCompute(true);
+  setAssignment(Assignment(assignment.getLhs(), assignment.getRhs(),
+                           assignment.getOperator(), accumulatorType));
+}
+
 void TensorBase::printComputeIR(ostream& os, bool color, bool simplify) const {
   std::shared_ptr<ir::CodeGen> codegen = ir::CodeGen::init_default(os, ir::CodeGen::ImplementationGen);
   codegen->compile(content->computeFunc.as<Function>(), false);
@@ -938,10 +1291,12 @@ TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
   helperFunctionsMutex.lock();
   const auto helperFunctionsReverse =
       util::ReverseConstIterable<TensorBase::HelperFuncsCache>(helperFunctions);
+  const auto allocator = getAllocator();
   for (const auto& helperFuncs : helperFunctionsReverse) {
     if (std::get<0>(helperFuncs) == format &&
         std::get<1>(helperFuncs) == ctype &&
-        std::get<2>(helperFuncs) == dimensions) {
+        std::get<2>(helperFuncs) == dimensions &&
+        std::get<3>(helperFuncs)->getAllocator() == allocator) {
       // If helper functions had already been generated for specified tensor
       // format and type, then use cached version.
       const auto helperFuncsModule = std::get<3>(helperFuncs);
@@ -975,20 +1330,7 @@ TensorBase::getHelperFunctions(const Format& format, Datatype ctype,
       iterateStmt = forall(indexVars[mode], iterateStmt);
     }
 
-    bool doAppend = true;
-    for (int i = format.getOrder() - 1; i >= 0; --i) {
-      const auto modeFormat = format.getModeFormats()[i];
-      if (modeFormat.isBranchless() && i != 0) {
-        const auto parentModeFormat = format.getModeFormats()[i - 1];
-        if (parentModeFormat.isUnique() || !parentModeFormat.hasAppend()) {
-          doAppend = false;
-          break;
-        }
-      }
-    }
-    if (!doAppend) {
-      packStmt = packStmt.assemble(packedTensor, AssembleStrategy::Insert);
-    }
+    packStmt = setPackAssembleStrategy(packStmt, packedTensor);
 
     // Lower packing and iterator code.
     helperModule->addFunction(lower(packStmt, "pack", true, true));
@@ -1138,6 +1480,8 @@ bool equals(const TensorBase& a, const TensorBase& b) {
     case Datatype::Int32: return equalsTyped<int32_t>(a, b);
     case Datatype::Int64: return equalsTyped<int64_t>(a, b);
     case Datatype::Int128: return equalsTyped<long long>(a, b);
+    case Datatype::Float16: return equalsTyped<float16>(a, b);
+    case Datatype::BFloat16: return equalsTyped<bfloat16>(a, b);
     case Datatype::Float32: return equalsTyped<float>(a, b);
     case Datatype::Float64: return equalsTyped<double>(a, b);
     case Datatype::Complex64: return equalsTyped<std::complex<float>>(a, b);
@@ -1197,6 +1541,8 @@ ostream& operator<<(ostream& os, const TensorBase& tensor) {
       case Datatype::Int32: os << ((int32_t*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Int64: os << ((int64_t*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Int128: os << ((long long*)(ptr+tensor.getOrder()))[0] << std::endl; break;
+      case Datatype::Float16: os << ((float16*)(ptr+tensor.getOrder()))[0] << std::endl; break;
+      case Datatype::BFloat16: os << ((bfloat16*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Float32: os << ((float*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Float64: os << ((double*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Complex64: os << ((std::complex<float>*)(ptr+tensor.getOrder()))[0] << std::endl; break;
@@ -1237,6 +1583,8 @@ ostream& operator<<(ostream& os, TensorBase& tensor) {
       case Datatype::Int32: os << ((int32_t*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Int64: os << ((int64_t*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Int128: os << ((long long*)(ptr+tensor.getOrder()))[0] << std::endl; break;
+      case Datatype::Float16: os << ((float16*)(ptr+tensor.getOrder()))[0] << std::endl; break;
+      case Datatype::BFloat16: os << ((bfloat16*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Float32: os << ((float*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Float64: os << ((double*)(ptr+tensor.getOrder()))[0] << std::endl; break;
       case Datatype::Complex64: os << ((std::complex<float>*)(ptr+tensor.getOrder()))[0] << std::endl; break;
@@ -1387,6 +1735,8 @@ void packOperands(const TensorBase& tensor) {
 static ParallelSchedule taco_parallel_sched = ParallelSchedule::Static;
 static int taco_chunk_size = 0;
 static int taco_num_threads = 1;
+static bool taco_parallel_assembly = false;
+static bool taco_privatized_reductions = false;
 
 void taco_set_parallel_schedule(ParallelSchedule sched, int chunk_size) {
   taco_parallel_sched = sched;
@@ -1398,6 +1748,22 @@ void taco_get_parallel_schedule(ParallelSchedule *sched, int *chunk_size) {
   *chunk_size = taco_chunk_size;
 }
 
+void taco_set_parallel_assembly(bool parallel_assembly) {
+  taco_parallel_assembly = parallel_assembly;
+}
+
+bool taco_get_parallel_assembly() {
+  return taco_parallel_assembly;
+}
+
+void taco_set_privatized_reductions(bool privatized_reductions) {
+  taco_privatized_reductions = privatized_reductions;
+}
+
+bool taco_get_privatized_reductions() {
+  return taco_privatized_reductions;
+}
+
 void taco_set_num_threads(int num_threads) {
   if (num_threads > 0) {
     taco_num_threads = num_threads;
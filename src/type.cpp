@@ -8,6 +8,7 @@
 #include <ostream>
 #include <set>
 #include <complex>
+#include <cstring>
 
 using namespace std;
 
@@ -38,7 +39,8 @@ bool Datatype::isInt() const {
 }
 
 bool Datatype::isFloat() const {
-  return getKind() == Float32 || getKind() == Float64;
+  return getKind() == Float16 || getKind() == BFloat16 ||
+         getKind() == Float32 || getKind() == Float64;
 }
 
 bool Datatype::isComplex() const {
@@ -90,6 +92,8 @@ int Datatype::getNumBits() const {
       return 8;
     case UInt16:
     case Int16:
+    case Float16:
+    case BFloat16:
       return 16;
     case UInt32:
     case Int32:
@@ -114,6 +118,8 @@ std::ostream& operator<<(std::ostream& os, const Datatype& type) {
   if (type.isBool()) os << "bool";
   else if (type.isInt()) os << "int" << type.getNumBits() << "_t";
   else if (type.isUInt()) os << "uint" << type.getNumBits() << "_t";
+  else if (type == Datatype::Float16) os << "float16";
+  else if (type == Datatype::BFloat16) os << "bfloat16";
   else if (type == Datatype::Float32) os << "float";
   else if (type == Datatype::Float64) os << "double";
   else if (type == Datatype::Complex64) os << "float complex";
@@ -135,6 +141,8 @@ std::ostream& operator<<(std::ostream& os, const Datatype::Kind& kind) {
     case Datatype::Int32: os << "Int32"; break;
     case Datatype::Int64: os << "Int64"; break;
     case Datatype::Int128: os << "Int128"; break;
+    case Datatype::Float16: os << "Float16"; break;
+    case Datatype::BFloat16: os << "BFloat16"; break;
     case Datatype::Float32: os << "Float32"; break;
     case Datatype::Float64: os << "Float64"; break;
     case Datatype::Complex64: os << "Complex64"; break;
@@ -194,6 +202,7 @@ Datatype Int128 = Datatype(Datatype::UInt128);
   
 Datatype Float(int bits) {
   switch (bits) {
+    case 16: return Datatype(Datatype::Float16);
     case 32: return Datatype(Datatype::Float32);
     case 64: return Datatype(Datatype::Float64);
     default: 
@@ -202,9 +211,104 @@ Datatype Float(int bits) {
   }
 }
 
+Datatype Float16 = Datatype(Datatype::Float16);
+Datatype BFloat16 = Datatype(Datatype::BFloat16);
 Datatype Float32 = Datatype(Datatype::Float32);
 Datatype Float64 = Datatype(Datatype::Float64);
 
+// class float16
+float16::float16(float value) {
+  uint32_t floatBits;
+  memcpy(&floatBits, &value, sizeof(float));
+  const uint16_t sign = (floatBits >> 16) & 0x8000;
+  const int exponent = (int)((floatBits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = floatBits & 0x7fffff;
+
+  if (((floatBits >> 23) & 0xff) == 0xff) {
+    // Infinities and NaNs
+    bits = sign | 0x7c00 | (mantissa ? 0x200 : 0);
+    return;
+  }
+  if (exponent >= 31) {
+    bits = sign | 0x7c00;
+    return;
+  }
+
+  // Round to nearest even, shifting subnormals by their exponent
+  uint32_t half;
+  uint32_t shift = 13;
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      bits = sign;
+      return;
+    }
+    mantissa |= 0x800000;
+    shift = 14 - exponent;
+    half = mantissa >> shift;
+  } else {
+    half = ((uint32_t)exponent << 10) | (mantissa >> shift);
+  }
+  const uint32_t remainder = mantissa & ((1u << shift) - 1);
+  const uint32_t halfway = 1u << (shift - 1);
+  if (remainder > halfway || (remainder == halfway && (half & 1))) {
+    half++;
+  }
+  bits = sign | (uint16_t)half;
+}
+
+float16::operator float() const {
+  const uint32_t sign = (uint32_t)(bits & 0x8000) << 16;
+  uint32_t exponent = (bits >> 10) & 0x1f;
+  uint32_t mantissa = bits & 0x3ff;
+  uint32_t floatBits;
+  if (exponent == 0x1f) {
+    floatBits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    floatBits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    floatBits = sign;
+  } else {
+    // Normalize subnormals
+    exponent = 113;
+    while (!(mantissa & 0x400)) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    floatBits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float value;
+  memcpy(&value, &floatBits, sizeof(float));
+  return value;
+}
+
+std::ostream& operator<<(std::ostream& os, const float16& value) {
+  return os << (float)value;
+}
+
+// class bfloat16
+bfloat16::bfloat16(float value) {
+  uint32_t floatBits;
+  memcpy(&floatBits, &value, sizeof(float));
+  if ((floatBits & 0x7fffffff) > 0x7f800000) {
+    // Keep NaNs quiet instead of rounding them to infinities
+    bits = (floatBits >> 16) | 0x40;
+    return;
+  }
+  floatBits += 0x7fff + ((floatBits >> 16) & 1);
+  bits = floatBits >> 16;
+}
+
+bfloat16::operator float() const {
+  const uint32_t floatBits = (uint32_t)bits << 16;
+  float value;
+  memcpy(&value, &floatBits, sizeof(float));
+  return value;
+}
+
+std::ostream& operator<<(std::ostream& os, const bfloat16& value) {
+  return os << (float)value;
+}
+
 Datatype Complex(int bits) {
   switch (bits) {
     case 64: return Datatype(Datatype::Complex64);
@@ -7,6 +7,9 @@
 #include "taco/format.h"
 #include "taco/index_notation/index_notation.h"
 #include "taco/storage/storage.h"
+#include "taco/lower/mode_format_hashed.h"
+#include "taco/lower/mode_format_ell.h"
+#include "taco/lower/mode_format_dia.h"
 #include "taco/util/strings.h"
 
 using namespace taco;
@@ -72,3 +75,916 @@ TEST(format, dense) {
   A.pack();
   ASSERT_COMPONENTS_EQUALS({{{3}}, {{3}}}, {0,2,0, 0,0,0, 3,0,4}, A);
 }
+
+TEST(format, narrowCoordinateTypes) {
+  ASSERT_EQ(UInt8, narrowestCoordinateType(256));
+  ASSERT_EQ(UInt16, narrowestCoordinateType(257));
+  ASSERT_EQ(UInt16, narrowestCoordinateType(65536));
+  ASSERT_EQ(Int32, narrowestCoordinateType(65537));
+
+  Format dcsc = narrowCoordinateTypes(DCSC, {300, 3});
+  ASSERT_EQ(Int32, dcsc.getCoordinateTypePos(0));
+  ASSERT_EQ(UInt8, dcsc.getCoordinateTypeIdx(0));
+  ASSERT_EQ(UInt16, dcsc.getCoordinateTypeIdx(1));
+  ASSERT_NE(DCSC, dcsc);
+}
+
+TEST(format, narrowCoordinatesPack) {
+  for (auto format : {CSR, DCSR, COO(2)}) {
+    Format narrow = narrowCoordinateTypes(format, {3, 3});
+    Tensor<double> A = d33a("A", narrow);
+    A.pack();
+    ASSERT_TRUE(d33a_data().compare(A));
+
+    const auto& index = A.getStorage().getIndex();
+    for (int i = 0; i < narrow.getOrder(); ++i) {
+      if (narrow.getModeFormats()[i] != Dense) {
+        ASSERT_EQ(UInt8, index.getModeIndex(i).getIndexArray(1).getType());
+      }
+    }
+  }
+}
+
+TEST(format, narrowCoordinatesCompute) {
+  const int NUM_I = 300;
+  const int NUM_J = 60000;
+  Tensor<double> A("A", {NUM_I, NUM_J}, 
+                   narrowCoordinateTypes(DCSR, {NUM_I, NUM_J}));
+  Tensor<double> B("B", {NUM_I, NUM_J}, CSR);
+  Tensor<double> x("x", {NUM_J}, Format({Dense}));
+  for (int i = 0; i < NUM_I; i += 7) {
+    for (int j = i; j < NUM_J; j += 997) {
+      A.insert({i, j}, (double)(i + j % 5));
+      B.insert({i, j}, (double)(i + j % 5));
+    }
+  }
+  for (int j = 0; j < NUM_J; ++j) {
+    x.insert({j}, (double)(j % 3));
+  }
+  A.pack();
+  B.pack();
+  x.pack();
+
+  IndexVar i, j;
+  Tensor<double> y("y", {NUM_I}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.evaluate();
+
+  Tensor<double> expected("expected", {NUM_I}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  Tensor<double> C("C", {NUM_I, NUM_J}, 
+                   narrowCoordinateTypes(CSR, {NUM_I, NUM_J}));
+  C(i,j) = A(i,j) + B(i,j);
+  C.evaluate();
+  ASSERT_EQ(UInt16, 
+      C.getStorage().getIndex().getModeIndex(1).getIndexArray(1).getType());
+
+  Tensor<double> D("D", {NUM_I, NUM_J}, CSR);
+  D(i,j) = B(i,j) + B(i,j);
+  D.evaluate();
+  ASSERT_TENSOR_EQ(D, C);
+}
+
+TEST(format, hashedPack) {
+  Tensor<double> a = d5a("a", Format({Hashed}));
+  a.pack();
+  EXPECT_TRUE(d5a_data().compare(a));
+
+  // Tables have twice as many slots as coordinates, but no more slots than
+  // the dimension and at least one slot
+  Tensor<double> A = d33a("A", Format({Dense, Hashed}));
+  A.pack();
+  EXPECT_TRUE(d33a_data().compare(A));
+  ASSERT_EQ((size_t)2+1+3, A.getStorage().getValues().getSize());
+
+  // Ungrouped insertion supports one hashed level per tensor
+  Tensor<double> B = d33a("B", Format({Hashed, Hashed}));
+  ASSERT_THROW(B.pack(), taco::TacoException);
+
+  // Tables of a declared width have at least that many slots
+  ModeFormat narrowHashed(std::make_shared<HashedModeFormat>(false, 2));
+  Tensor<double> C = d233a("C", Format({Dense, Dense, narrowHashed}));
+  C.pack();
+  EXPECT_TRUE(d233a_data().compare(C));
+  ASSERT_EQ((size_t)3+2+2+2+2+3, C.getStorage().getValues().getSize());
+
+  // Tables are sized by the number of coordinates packed into them rather
+  // than by the dimension
+  Tensor<double> D("D", {10, 1000}, Format({Dense, Hashed}));
+  Tensor<double> expected("expected", {10, 1000}, Format({Dense, Dense}));
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 3; j++) {
+      D.insert({i, 100 * j + i}, (double)(i + j));
+      expected.insert({i, 100 * j + i}, (double)(i + j));
+    }
+  }
+  D.pack();
+  expected.pack();
+  ASSERT_EQ((size_t)10*6, D.getStorage().getValues().getSize());
+  Tensor<double> converted("converted", {10, 1000}, Format({Dense, Dense}));
+  IndexVar i("i"), j("j");
+  converted(i, j) = D(i, j);
+  converted.evaluate();
+  ASSERT_TENSOR_EQ(expected, converted);
+
+  // Tables hold more coordinates than their declared width
+  Tensor<double> E("E", {3, 3}, Format({Dense, narrowHashed}));
+  Tensor<double> expectedE("expectedE", {3, 3}, Format({Dense, Dense}));
+  for (int j = 0; j < 3; j++) {
+    E.insert({0, j}, (double)(j + 1));
+    expectedE.insert({0, j}, (double)(j + 1));
+  }
+  E.pack();
+  expectedE.pack();
+  ASSERT_EQ((size_t)3+2+2, E.getStorage().getValues().getSize());
+  Tensor<double> convertedE("convertedE", {3, 3}, Format({Dense, Dense}));
+  convertedE(i, j) = E(i, j);
+  convertedE.evaluate();
+  ASSERT_TENSOR_EQ(expectedE, convertedE);
+}
+
+TEST(format, hashedCompute) {
+  const int NUM_I = 40;
+  const int NUM_J = 50;
+  Tensor<double> A("A", {NUM_I, NUM_J}, Format({Dense, Hashed}));
+  Tensor<double> B("B", {NUM_I, NUM_J}, CSR);
+  Tensor<double> x("x", {NUM_J}, Format({Dense}));
+  for (int i = 0; i < NUM_I; ++i) {
+    for (int j = (i * 7) % 5; j < NUM_J; j += 3 + i % 4) {
+      A.insert({i, j}, (double)(i + j));
+      B.insert({i, j}, (double)(i + j));
+    }
+  }
+  for (int j = 0; j < NUM_J; ++j) {
+    x.insert({j}, (double)(j % 3));
+  }
+  A.pack();
+  B.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> y("y", {NUM_I}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.evaluate();
+
+  Tensor<double> expected("expected", {NUM_I}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  // Locate into the hashed level while iterating over the compressed level
+  Tensor<double> C("C", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  C(i,j) = B(i,j) * A(i,j);
+  C.evaluate();
+
+  Tensor<double> D("D", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  D(i,j) = B(i,j) * B(i,j);
+  D.evaluate();
+  ASSERT_TENSOR_EQ(D, C);
+
+  // Scatter products into a hashed result in the order they are computed
+  Tensor<double> S("S", {NUM_J, NUM_J}, CSR);
+  for (int k = 0; k < NUM_J; ++k) {
+    S.insert({k, (k * 13) % NUM_J}, 1.0 + k);
+    S.insert({k, (k * 29 + 7) % NUM_J}, 2.0);
+  }
+  S.pack();
+
+  Tensor<double> H("H", {NUM_I, NUM_J}, Format({Dense, Hashed}));
+  H(i,j) = B(i,k) * S(k,j);
+  IndexStmt stmt = H.getAssignment().concretize();
+  stmt = stmt.reorder({i,k,j});
+  H.compile(stmt);
+  H.assemble();
+  H.compute();
+
+  Tensor<double> E("E", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  E(i,j) = B(i,k) * S(k,j);
+  E.evaluate();
+
+  Tensor<double> F("F", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  F(i,j) = H(i,j);
+  F.evaluate();
+  ASSERT_TENSOR_EQ(E, F);
+
+  // Kernels size the tables of hashed results by the number of coordinates 
+  // that are inserted into them rather than by the dimension
+  Tensor<double> G("G", {4, 100000}, CSR);
+  G.insert({0, 5}, 1.0);
+  G.insert({3, 99999}, 2.0);
+  G.pack();
+  Tensor<double> W("W", {4, 100000}, Format({Dense, Hashed}));
+  W(i,j) = G(i,j) * 2;
+  W.evaluate();
+  ASSERT_EQ((size_t)2+1+1+2, W.getStorage().getValues().getSize());
+
+  Tensor<double> expectedW("expectedW", {4, 100000}, CSR);
+  expectedW.insert({0, 5}, 2.0);
+  expectedW.insert({3, 99999}, 4.0);
+  expectedW.pack();
+  Tensor<double> convertedW("convertedW", {4, 100000}, CSR);
+  convertedW(i,j) = W(i,j);
+  convertedW.evaluate();
+  ASSERT_TENSOR_EQ(expectedW, convertedW);
+}
+
+TEST(format, bitmapPack) {
+  Tensor<double> a = d5a("a", Format({Bitmap}));
+  a.pack();
+  EXPECT_TRUE(d5a_data().compare(a));
+  ASSERT_EQ((size_t)5, a.getStorage().getValues().getSize());
+
+  Tensor<double> A = d33a("A", Format({Dense, Bitmap}));
+  A.pack();
+  EXPECT_TRUE(d33a_data().compare(A));
+  ASSERT_EQ((size_t)3*3, A.getStorage().getValues().getSize());
+
+  Tensor<double> B = d233a("B", Format({Dense, Dense, Bitmap}));
+  B.pack();
+  EXPECT_TRUE(d233a_data().compare(B));
+}
+
+TEST(format, bitmapCompute) {
+  const int NUM_I = 40;
+  const int NUM_J = 150;
+  Tensor<double> A("A", {NUM_I, NUM_J}, Format({Dense, Bitmap}));
+  Tensor<double> B("B", {NUM_I, NUM_J}, CSR);
+  Tensor<double> C("C", {NUM_I, NUM_J}, Format({Dense, Bitmap}));
+  Tensor<double> D("D", {NUM_I, NUM_J}, CSR);
+  Tensor<double> x("x", {NUM_J}, Format({Dense}));
+  for (int i = 0; i < NUM_I; ++i) {
+    for (int j = (i * 7) % 5; j < NUM_J; j += 3 + i % 4) {
+      A.insert({i, j}, (double)(i + j));
+      B.insert({i, j}, (double)(i + j));
+    }
+    for (int j = i % 3; j < NUM_J; j += 2 + i % 5) {
+      C.insert({i, j}, (double)(i - j));
+      D.insert({i, j}, (double)(i - j));
+    }
+  }
+  for (int j = 0; j < NUM_J; ++j) {
+    x.insert({j}, (double)(j % 3));
+  }
+  A.pack();
+  B.pack();
+  C.pack();
+  D.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j");
+  Tensor<double> y("y", {NUM_I}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.evaluate();
+
+  Tensor<double> expected("expected", {NUM_I}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  // Intersect two bitmap levels
+  Tensor<double> E("E", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  E(i,j) = A(i,j) * C(i,j);
+  E.evaluate();
+
+  Tensor<double> F("F", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  F(i,j) = B(i,j) * D(i,j);
+  F.evaluate();
+  ASSERT_TENSOR_EQ(F, E);
+
+  // Only bitmaps that are required by every lattice point may be intersected
+  Tensor<double> G("G", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  G(i,j) = A(i,j) * (C(i,j) + D(i,j));
+  G.evaluate();
+
+  Tensor<double> H("H", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  H(i,j) = B(i,j) * (D(i,j) + D(i,j));
+  H.evaluate();
+  ASSERT_TENSOR_EQ(H, G);
+
+  Tensor<double> K("K", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  K(i,j) = A(i,j) + D(i,j);
+  K.evaluate();
+
+  Tensor<double> L("L", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  L(i,j) = B(i,j) + D(i,j);
+  L.evaluate();
+  ASSERT_TENSOR_EQ(L, K);
+
+  // Insert into a bitmap result
+  Tensor<double> M("M", {NUM_I, NUM_J}, Format({Dense, Bitmap}));
+  M(i,j) = B(i,j) * D(i,j);
+  M.evaluate();
+
+  Tensor<double> N("N", {NUM_I, NUM_J}, Format({Dense, Dense}));
+  N(i,j) = M(i,j);
+  N.evaluate();
+  ASSERT_TENSOR_EQ(F, N);
+}
+
+TEST(format, ellPack) {
+  ModeFormat slicedEll(std::make_shared<EllModeFormat>(false, 2));
+  for (ModeFormat ell : {Ell, slicedEll}) {
+    Tensor<double> a = d5a("a", Format({ell}));
+    a.pack();
+    EXPECT_TRUE(d5a_data().compare(a));
+
+    Tensor<double> A = d33a("A", Format({Dense, ell}));
+    A.pack();
+    EXPECT_TRUE(d33a_data().compare(A));
+
+    Tensor<double> B = d233a("B", Format({Dense, Dense, ell}));
+    B.pack();
+    EXPECT_TRUE(d233a_data().compare(B));
+  }
+
+  // Every row of an ELL level is padded to the width of the widest row
+  Tensor<double> A = d33a("A", ELL);
+  A.pack();
+  ASSERT_EQ((size_t)3*2, A.getStorage().getValues().getSize());
+}
+
+TEST(format, ellCompute) {
+  const int NUM_I = 41;
+  const int NUM_J = 50;
+  const int NUM_K = 4;
+  ModeFormat slicedEll(std::make_shared<EllModeFormat>(false, 4));
+  Tensor<double> B("B", {NUM_I, NUM_J}, CSR);
+  Tensor<double> X("X", {NUM_J, NUM_K}, Format({Dense, Dense}));
+  Tensor<double> x("x", {NUM_J}, Format({Dense}));
+  for (int i = 0; i < NUM_I; ++i) {
+    for (int j = (i * 7) % 5; j < NUM_J; j += 3 + i % 11) {
+      B.insert({i, j}, (double)(i + j));
+    }
+  }
+  for (int j = 0; j < NUM_J; ++j) {
+    x.insert({j}, (double)(j % 3));
+    for (int k = 0; k < NUM_K; ++k) {
+      X.insert({j, k}, (double)(j - k));
+    }
+  }
+  B.pack();
+  X.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> expected("expected", {NUM_I}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+
+  Tensor<double> expectedMM("expectedMM", {NUM_I, NUM_K}, 
+                            Format({Dense, Dense}));
+  expectedMM(i,k) = B(i,j) * X(j,k);
+  expectedMM.evaluate();
+
+  Tensor<double> expectedCopy("expectedCopy", {NUM_I, NUM_J}, 
+                              Format({Dense, Dense}));
+  expectedCopy(i,j) = B(i,j);
+  expectedCopy.evaluate();
+
+  for (ModeFormat ell : {Ell, slicedEll}) {
+    // Convert from CSR
+    Tensor<double> A("A", {NUM_I, NUM_J}, Format({Dense, ell}));
+    A(i,j) = B(i,j);
+    IndexStmt stmt = A.getAssignment().concretize();
+    stmt = stmt.assemble(A.getTensorVar(), AssembleStrategy::Insert);
+    A.compile(stmt);
+    A.assemble();
+    A.compute();
+
+    Tensor<double> y("y", {NUM_I}, Format({Dense}));
+    y(i) = A(i,j) * x(j);
+    y.evaluate();
+    ASSERT_TENSOR_EQ(expected, y);
+
+    Tensor<double> Y("Y", {NUM_I, NUM_K}, Format({Dense, Dense}));
+    Y(i,k) = A(i,j) * X(j,k);
+    Y.evaluate();
+    ASSERT_TENSOR_EQ(expectedMM, Y);
+
+    // Padding must not be written to results indexed by the padded level
+    Tensor<double> C("C", {NUM_I, NUM_J}, Format({Dense, Dense}));
+    C(i,j) = A(i,j);
+    C.evaluate();
+    ASSERT_TENSOR_EQ(expectedCopy, C);
+  }
+}
+
+TEST(format, diaPack) {
+  ModeFormat dia(std::make_shared<DiaModeFormat>(false, std::vector<int>{4,1}));
+  Tensor<double> a = d5a("a", Format({dia}));
+  a.pack();
+  EXPECT_TRUE(d5a_data().compare(a));
+
+  // Every row stores one slot per diagonal followed by an overflow slot
+  Tensor<double> A = d33a("A", DIA({1,-2,0}));
+  A.pack();
+  EXPECT_TRUE(d33a_data().compare(A));
+  ASSERT_EQ((size_t)3*4, A.getStorage().getValues().getSize());
+
+  ModeFormat band(std::make_shared<DiaModeFormat>(false, 
+                                                  std::vector<int>{-2,0,1}));
+  Tensor<double> B = d233a("B", Format({Dense, Dense, band}));
+  B.pack();
+  EXPECT_TRUE(d233a_data().compare(B));
+
+  // Components that do not lie on any of the diagonals cannot be stored
+  Tensor<double> C("C", {3, 3}, DIA({0,1}));
+  C.insert({0, 0}, 1.0);
+  C.insert({2, 0}, 2.0);
+  ASSERT_THROW(C.pack(), taco::TacoException);
+
+  Tensor<double> D("D", {3, 3}, CSR);
+  D.insert({0, 0}, 1.0);
+  D.insert({2, 0}, 2.0);
+  D.pack();
+  IndexVar i("i"), j("j");
+  // Kernels drop computed components that do not lie on any of the diagonals
+  Tensor<double> E("E", {3, 3}, DIA({0,1}));
+  E(i,j) = D(i,j);
+  E.evaluate();
+  Tensor<double> F("F", {3, 3}, Format({Dense, Dense}));
+  F(i,j) = E(i,j);
+  F.evaluate();
+  Tensor<double> expected("expected", {3, 3}, Format({Dense, Dense}));
+  expected.insert({0, 0}, 1.0);
+  expected.pack();
+  ASSERT_TENSOR_EQ(expected, F);
+}
+
+TEST(format, diaCompute) {
+  const int N = 40;
+  const int NUM_K = 4;
+  const std::vector<int> offsets = {-5, -1, 0, 1, 5};
+  Tensor<double> A("A", {N, N}, DIA(offsets));
+  Tensor<double> B("B", {N, N}, CSR);
+  Tensor<double> X("X", {N, NUM_K}, Format({Dense, Dense}));
+  Tensor<double> x("x", {N}, Format({Dense}));
+  for (int i = 0; i < N; ++i) {
+    for (int offset : offsets) {
+      const int j = i + offset;
+      if (j >= 0 && j < N && (i + j) % 7 != 0) {
+        A.insert({i, j}, (double)(i - 2 * j));
+        B.insert({i, j}, (double)(i - 2 * j));
+      }
+    }
+  }
+  for (int j = 0; j < N; ++j) {
+    x.insert({j}, (double)(j % 3));
+    for (int k = 0; k < NUM_K; ++k) {
+      X.insert({j, k}, (double)(j - k));
+    }
+  }
+  A.pack();
+  B.pack();
+  X.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> y("y", {N}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.evaluate();
+
+  Tensor<double> expected("expected", {N}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  Tensor<double> Y("Y", {N, NUM_K}, Format({Dense, Dense}));
+  Y(i,k) = A(i,j) * X(j,k);
+  Y.evaluate();
+
+  Tensor<double> expectedMM("expectedMM", {N, NUM_K}, Format({Dense, Dense}));
+  expectedMM(i,k) = B(i,j) * X(j,k);
+  expectedMM.evaluate();
+  ASSERT_TENSOR_EQ(expectedMM, Y);
+
+  // Convert from CSR by locating diagonals of the DIA result
+  Tensor<double> C("C", {N, N}, DIA(offsets));
+  C(i,j) = B(i,j);
+  C.evaluate();
+
+  // Slots outside of the matrix must not be written to dense results
+  Tensor<double> D("D", {N, N}, Format({Dense, Dense}));
+  D(i,j) = C(i,j);
+  D.evaluate();
+
+  Tensor<double> E("E", {N, N}, Format({Dense, Dense}));
+  E(i,j) = B(i,j);
+  E.evaluate();
+  ASSERT_TENSOR_EQ(E, D);
+}
+
+TEST(format, bcsr) {
+  const int NUM_I = 13;
+  const int NUM_J = 15;
+  Tensor<double> B("B", {NUM_I, NUM_J}, CSR);
+  Tensor<double> x("x", {NUM_J}, Format({Dense}));
+  for (int i = 0; i < NUM_I; ++i) {
+    for (int j = (i / 3) * 3; j < NUM_J; j += 4 + i % 5) {
+      B.insert({i, j}, (double)(i + j));
+    }
+  }
+  for (int j = 0; j < NUM_J; ++j) {
+    x.insert({j}, (double)(j % 4));
+  }
+  B.pack();
+  x.pack();
+
+  double fillRatio = 0.0;
+  TensorBase A = makeBlocked<double>("A", B, {3,3}, BCSR, &fillRatio);
+  ASSERT_EQ(std::vector<int>({5,5,3,3}), A.getDimensions());
+  ASSERT_EQ((double)A.getStorage().getValues().getSize() / 
+            B.getStorage().getValues().getSize(), fillRatio);
+  ASSERT_LE(1.0, fillRatio);
+
+  TensorBase xb = makeBlocked<double>("xb", x, {3}, Format({Dense,Dense}));
+
+  IndexVar i("i"), j("j"), ib("ib"), jb("jb");
+  Tensor<double> y("y", {5, 3}, Format({Dense,Dense}));
+  y(ib,i) = A(ib,jb,i,j) * xb(jb,j);
+  y.evaluate();
+  // Loops over the 3x3 blocks are fully unrolled
+  std::string source = y.getSource();
+  std::string compute = source.substr(source.find("int compute("));
+  ASSERT_EQ(std::string::npos, compute.find("for (int32_t i = "));
+  ASSERT_EQ(std::string::npos, compute.find("for (int32_t j = "));
+
+  Tensor<double> expected("expected", {NUM_I}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(makeBlocked<double>("expectedb", expected, {3}, 
+                                       Format({Dense,Dense})), y);
+}
+
+TEST(format, bcsf) {
+  Tensor<double> B = d333a("B", Format({Sparse, Sparse, Sparse}));
+  Tensor<double> c = d3a("c", Format({Dense}));
+  B.pack();
+  c.pack();
+
+  TensorBase A = makeBlocked<double>("A", B, {2,2,2}, BCSF(3));
+  TensorBase cb = makeBlocked<double>("cb", c, {2}, Format({Dense,Dense}));
+
+  IndexVar i("i"), j("j"), k("k"), ib("ib"), jb("jb"), kb("kb");
+  Tensor<double> Y("Y", {2, 2, 2, 2}, Format({Dense,Dense,Dense,Dense}));
+  Y(ib,jb,i,j) = A(ib,jb,kb,i,j,k) * cb(kb,k);
+  Y.evaluate();
+
+  Tensor<double> expected("expected", {3, 3}, Format({Dense,Dense}));
+  expected(i,j) = B(i,j,k) * c(k);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(makeBlocked<double>("expectedb", expected, {2,2}, 
+                                       Format({Dense,Dense,Dense,Dense})), Y);
+}
+
+TEST(format, rlePack) {
+  Tensor<double> a = d5a("a", Format({Rle}));
+  a.pack();
+  EXPECT_TRUE(d5a_data().compare(a));
+
+  // Every run stores its first coordinate and position
+  Tensor<double> A = d33a("A", RLE);
+  A.pack();
+  EXPECT_TRUE(d33a_data().compare(A));
+  const Array& run = A.getStorage().getIndex().getModeIndex(1).getIndexArray(1);
+  ASSERT_EQ(2*run.get(0).getAsIndex() + 3, run.getSize());
+
+  Tensor<double> B = d233a("B", Format({Dense, Sparse, Rle}));
+  B.pack();
+  EXPECT_TRUE(d233a_data().compare(B));
+}
+
+TEST(format, rleCompute) {
+  const int N = 40;
+  Tensor<double> A("A", {N, N}, RLE);
+  Tensor<double> B("B", {N, N}, CSR);
+  Tensor<double> x("x", {N}, Format({Dense}));
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if ((j >= i && j < i + 5) || (i % 3 == 0 && j > 30) || j == (7*i) % N) {
+        A.insert({i, j}, (double)(i - 2 * j));
+        B.insert({i, j}, (double)(i - 2 * j));
+      }
+    }
+  }
+  for (int j = 0; j < N; ++j) {
+    x.insert({j}, (double)(j % 3));
+  }
+  A.pack();
+  B.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j"), f("f"), fpos("fpos"), chunk("chunk"), fpos1("fpos1");
+  Tensor<double> expected("expected", {N}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+
+  Tensor<double> y("y", {N}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.evaluate();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  // Position loops locate the runs of positions
+  Tensor<double> z("z", {N}, Format({Dense}));
+  z(i) = A(i,j) * x(j);
+  IndexStmt stmt = z.getAssignment().concretize();
+  stmt = stmt.fuse(i, j, f)
+             .pos(f, fpos, A(i,j))
+             .split(fpos, chunk, fpos1, 8)
+             .parallelize(chunk, ParallelUnit::CPUThread, 
+                          OutputRaceStrategy::Atomics);
+  z.compile(stmt);
+  z.assemble();
+  z.compute();
+  ASSERT_TENSOR_EQ(expected, z);
+
+  // Assemble run-length results
+  Tensor<double> C("C", {N, N}, RLE);
+  C(i,j) = A(i,j) + B(i,j) * x(j);
+  C.evaluate();
+
+  Tensor<double> D("D", {N, N}, CSR);
+  D(i,j) = B(i,j) + B(i,j) * x(j);
+  D.evaluate();
+  ASSERT_TENSOR_EQ(D, C);
+}
+
+static Format symmetric(Format format) {
+  format.setSymmetricModes({0, 1});
+  return format;
+}
+
+TEST(format, symmetricPack) {
+  // Only the lower triangle of symmetric tensors is stored
+  const int N = 10;
+  Tensor<double> A("A", {N, N}, symmetric(CSR));
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if ((i + j) % 3 == 0 || i == j) {
+        A.insert({i, j}, (double)(i * j + i + j));
+      }
+    }
+  }
+  A.pack();
+
+  int numStored = 0;
+  for (auto& value : A) {
+    ASSERT_GE(value.first[0], value.first[1]);
+    ASSERT_EQ((double)(value.first[0] * value.first[1] + value.first[0] + 
+                       value.first[1]), value.second);
+    numStored++;
+  }
+  ASSERT_EQ(25, numStored);
+  ASSERT_NE(CSR, A.getFormat());
+
+  // Components of the upper triangle are mirrored into the lower triangle
+  Tensor<double> B("B", {N, N}, symmetric(CSR));
+  Tensor<double> expected("expected", {N, N}, CSR);
+  for (int i = 0; i < N; ++i) {
+    for (int j = i; j < N; ++j) {
+      if ((i + j) % 3 == 0) {
+        B.insert({i, j}, (double)(i + 2 * j));
+        expected.insert({j, i}, (double)(i + 2 * j));
+      }
+    }
+  }
+  B.pack();
+  expected.pack();
+  ASSERT_TRUE(equals(expected, B));
+
+  Tensor<double> C("C", {N, N}, symmetric(CSR));
+  C.insert({1, 2}, 1.0);
+  C.insert({2, 1}, 2.0);
+  ASSERT_THROW(C.pack(), taco::TacoException);
+}
+
+TEST(format, symmetricCompute) {
+  const int N = 40;
+  Tensor<double> A("A", {N, N}, symmetric(CSR));
+  Tensor<double> B("B", {N, N}, CSR);
+  Tensor<double> x("x", {N}, Format({Dense}));
+  Tensor<double> X("X", {N, 4}, Format({Dense, Dense}));
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if ((i * j) % 7 == 1 || i == j || i + j == N) {
+        A.insert({i, j}, (double)(i + j + 1));
+        B.insert({i, j}, (double)(i + j + 1));
+      }
+    }
+    x.insert({i}, (double)(i % 5));
+    for (int k = 0; k < 4; ++k) {
+      X.insert({i, k}, (double)(i - k));
+    }
+  }
+  A.pack();
+  B.pack();
+  x.pack();
+  X.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> expected("expected", {N}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+
+  // Every stored off-diagonal component updates both result components
+  Tensor<double> y("y", {N}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.evaluate();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  Tensor<double> z("z", {N}, Format({Dense}));
+  z(i) = A(i,j) * x(j);
+  IndexStmt stmt = z.getAssignment().concretize();
+  stmt = stmt.parallelize(i, ParallelUnit::CPUThread,
+                          OutputRaceStrategy::Atomics);
+  z.compile(stmt);
+  z.assemble();
+  z.compute();
+  ASSERT_TENSOR_EQ(expected, z);
+
+  Tensor<double> expectedY("expectedY", {N, 4}, Format({Dense, Dense}));
+  expectedY(i,k) = B(i,j) * X(j,k);
+  expectedY.evaluate();
+
+  Tensor<double> Y("Y", {N, 4}, Format({Dense, Dense}));
+  Y(i,k) = A(i,j) * X(j,k);
+  Y.evaluate();
+  ASSERT_TENSOR_EQ(expectedY, Y);
+
+  Tensor<double> expectedA("expectedA");
+  expectedA = B(i,j) * x(i) * x(j);
+  expectedA.evaluate();
+
+  Tensor<double> a("a");
+  a = A(i,j) * x(i) * x(j);
+  a.evaluate();
+  ASSERT_TENSOR_EQ(expectedA, a);
+
+  // Symmetric tensors cannot be computed, since kernels would store both 
+  // triangles, which operands would then mirror again
+  Tensor<double> S("S", {N, N}, symmetric(CSR));
+  S(i,j) = B(i,j);
+  ASSERT_THROW(S.compile(), taco::TacoException);
+
+  Tensor<double> T("T", {N, N}, symmetric(Format({Dense, Sparse})));
+  for (auto& value : B) {
+    T.insert({value.first[0], value.first[1]}, value.second);
+  }
+  T.pack();
+  Tensor<double> w("w", {N}, Format({Dense}));
+  w(i) = T(i,j) * x(j);
+  w.evaluate();
+  ASSERT_TENSOR_EQ(expected, w);
+}
+
+static Format pattern(Format format) {
+  format.setPattern(true);
+  return format;
+}
+
+TEST(format, patternPack) {
+  // Pattern tensors store coordinates but no values
+  Tensor<double> A("A", {5, 5}, pattern(CSR));
+  A.insert({0, 1}, 1.0);
+  A.insert({2, 2}, 1.0);
+  A.insert({4, 0}, 1.0);
+  A.pack();
+  ASSERT_EQ(0u, A.getStorage().getValues().getSize());
+
+  Tensor<double> expected("expected", {5, 5}, CSR);
+  expected.insert({0, 1}, 1.0);
+  expected.insert({2, 2}, 1.0);
+  expected.insert({4, 0}, 1.0);
+  expected.pack();
+  ASSERT_TENSOR_EQ(expected, A);
+}
+
+TEST(format, patternCompute) {
+  const int N = 30;
+  Tensor<double> A("A", {N, N}, pattern(CSR));
+  Tensor<double> B("B", {N, N}, CSR);
+  Tensor<double> M("M", {N, N}, CSR);
+  Tensor<double> x("x", {N}, Format({Dense}));
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if (i != j && ((i + j) % 4 == 0 || (i * j) % 7 == 1)) {
+        A.insert({i, j}, 1.0);
+        B.insert({i, j}, 1.0);
+      }
+      if (j % 3 != 0) {
+        M.insert({i, j}, 1.0);
+      }
+    }
+    x.insert({i}, (double)(i % 6));
+  }
+  A.pack();
+  B.pack();
+  M.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j");
+  Tensor<double> expected("expected", {N}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+
+  // Kernels read no values from pattern tensors
+  Tensor<double> y("y", {N}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.compile();
+  ASSERT_EQ(std::string::npos, y.getSource().find("A_vals"));
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  // Pattern results store the coordinates of their components
+  Tensor<double> expectedC("expectedC", {N, N}, CSR);
+  expectedC(i,j) = B(i,j) * M(i,j);
+  expectedC.evaluate();
+
+  Tensor<double> C("C", {N, N}, pattern(CSR));
+  C(i,j) = A(i,j) * M(i,j);
+  C.evaluate();
+  ASSERT_EQ(0u, C.getStorage().getValues().getSize());
+  ASSERT_TENSOR_EQ(expectedC, C);
+}
+
+static Format dictionary(Format format, Datatype codeType) {
+  format.setValueEncoding(codeType);
+  return format;
+}
+
+TEST(format, dictionaryPack) {
+  // Encoded tensors store a code per component and one copy of every value
+  Tensor<double> A("A", {5, 5}, dictionary(CSR, UInt8));
+  Tensor<double> expected("expected", {5, 5}, CSR);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      if ((i + j) % 2 == 0) {
+        A.insert({i, j}, (double)((i * j) % 3) + 0.5);
+        expected.insert({i, j}, (double)((i * j) % 3) + 0.5);
+      }
+    }
+  }
+  A.pack();
+  expected.pack();
+  ASSERT_EQ(UInt8, A.getStorage().getValues().getType());
+  ASSERT_EQ(13u, A.getStorage().getValues().getSize());
+  ASSERT_EQ(3u, A.getStorage().getValuesDictionary().getSize());
+  ASSERT_TENSOR_EQ(expected, A);
+
+  // Repacking decodes the packed components
+  A.insert({0, 1}, 4.0);
+  expected.insert({0, 1}, 4.0);
+  A.pack();
+  expected.pack();
+  ASSERT_EQ(4u, A.getStorage().getValuesDictionary().getSize());
+  ASSERT_TENSOR_EQ(expected, A);
+
+  // Codes must be wide enough for every distinct value
+  Tensor<double> B("B", {300}, dictionary(Format({Sparse}), UInt8));
+  for (int i = 0; i < 300; ++i) {
+    B.insert({i}, (double)i);
+  }
+  ASSERT_THROW(B.pack(), taco::TacoException);
+}
+
+TEST(format, dictionaryCompute) {
+  const int N = 30;
+  Tensor<float> A("A", {N, N}, dictionary(CSR, UInt16));
+  Tensor<float> B("B", {N, N}, CSR);
+  Tensor<float> x("x", {N}, Format({Dense}));
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if ((i + j) % 4 == 0 || (i * j) % 7 == 1) {
+        A.insert({i, j}, (float)((i + 2 * j) % 5));
+        B.insert({i, j}, (float)((i + 2 * j) % 5));
+      }
+    }
+    x.insert({i}, (float)(i % 6));
+  }
+  A.pack();
+  B.pack();
+  x.pack();
+
+  IndexVar i("i"), j("j");
+  Tensor<float> expected("expected", {N}, Format({Dense}));
+  expected(i) = B(i,j) * x(j);
+  expected.evaluate();
+
+  // Kernels decode values through the dictionary
+  Tensor<float> y("y", {N}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.compile();
+  ASSERT_NE(std::string::npos, y.getSource().find("A_vals_dict[A_vals["));
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  // Encoded tensors cannot be computed
+  Tensor<float> C("C", {N, N}, dictionary(CSR, UInt8));
+  C(i,j) = B(i,j);
+  ASSERT_THROW(C.compile(), taco::TacoException);
+}
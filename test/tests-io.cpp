@@ -125,5 +125,43 @@ TEST(io, mtxsymmetric) {
   expected.pack();
 
 
+  ASSERT_TRUE(equals(expected, tensor));
+}
+
+TEST(io, mtxsymmetricTriangle) {
+  // Symmetric formats store each entry of symmetric files once
+  Format format = CSR;
+  format.setSymmetricModes({0, 1});
+  Tensor<double> tensor = read(testDataDirectory()+"ds33.mtx", format);
+  ASSERT_EQ(format, tensor.getFormat());
+
+  TensorBase expected(Float64, {3,3}, format);
+  expected.insert({1, 0}, 1.0);
+  expected.insert({1, 1}, 2.0);
+  expected.insert({2, 0}, 3.0);
+  expected.pack();
+
+  ASSERT_TRUE(equals(expected, tensor));
+  ASSERT_EQ(3u, tensor.getStorage().getValues().getSize());
+}
+
+TEST(io, mtxpattern) {
+  std::stringstream stream;
+  stream << "%%MatrixMarket matrix coordinate pattern general" << std::endl
+         << "3 3 3" << std::endl
+         << "1 2" << std::endl
+         << "2 2" << std::endl
+         << "3 1" << std::endl;
+  Format format = CSR;
+  format.setPattern(true);
+  Tensor<double> tensor = read(stream, FileType::mtx, format);
+  ASSERT_EQ(0u, tensor.getStorage().getValues().getSize());
+
+  TensorBase expected(Float64, {3,3}, Sparse);
+  expected.insert({0, 1}, 1.0);
+  expected.insert({1, 1}, 1.0);
+  expected.insert({2, 0}, 1.0);
+  expected.pack();
+
   ASSERT_TRUE(equals(expected, tensor));
 }
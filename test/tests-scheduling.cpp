@@ -535,6 +535,87 @@ TEST(scheduling, parallelizeTemporaryReduction) {
 //  codegen->compile(compute, true);
 }
 
+TEST(scheduling, parallelizePrivatizedReduction) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  Tensor<double> A("A", {40, 10}, CSR);
+  Tensor<double> x("x", {40}, {Dense});
+  for (int i = 0; i < 40; i++) {
+    for (int j = i % 3; j < 10; j += 2) {
+      A.insert({i, j}, (double) (i + j));
+    }
+    x.insert({i}, (double) i);
+  }
+  A.pack();
+  x.pack();
+
+  Tensor<double> expected("expected", {10}, {Dense});
+  expected(j) = A(i, j) * x(i);
+  expected.evaluate();
+
+  Tensor<double> expectedDot("expectedDot");
+  expectedDot = x(i) * x(i);
+  expectedDot.evaluate();
+
+  for (auto strategy : {OutputRaceStrategy::Temporary, 
+                        OutputRaceStrategy::ParallelReduction}) {
+    SCOPED_TRACE(OutputRaceStrategy_NAMES[(int)strategy]);
+    Tensor<double> y("y", {10}, {Dense});
+    y(j) = A(i, j) * x(i);
+    IndexStmt stmt = reorderLoopsTopologically(y.getAssignment().concretize());
+    stmt = stmt.parallelize(i, ParallelUnit::CPUThread, strategy);
+    y.compile(stmt);
+    ASSERT_NE(std::string::npos, y.getSource().find("y_thread_vals[j]"));
+    y.assemble();
+    y.compute();
+    ASSERT_TENSOR_EQ(expected, y);
+
+    Tensor<double> dot("dot");
+    dot = x(i) * x(i);
+    stmt = dot.getAssignment().concretize()
+              .parallelize(i, ParallelUnit::CPUThread, strategy);
+    dot.compile(stmt);
+    ASSERT_NE(std::string::npos, dot.getSource().find("dot_thread_vals[0]"));
+    dot.assemble();
+    dot.compute();
+    ASSERT_TENSOR_EQ(expectedDot, dot);
+  }
+
+  // Threads only privatize dense results
+  Tensor<double> z("z", {10}, {Hashed});
+  z(j) = A(i, j) * x(i);
+  IndexStmt stmt = reorderLoopsTopologically(z.getAssignment().concretize());
+  string reason;
+  ASSERT_FALSE(Parallelize(i, ParallelUnit::CPUThread, 
+                           OutputRaceStrategy::Temporary).apply(stmt, &reason)
+                                                         .defined());
+  ASSERT_NE(std::string::npos, reason.find("private copies of dense results"));
+
+  // Results that are small relative to the operands are privatized when
+  // privatized reductions are enabled and kernels run on several threads
+  ASSERT_TRUE(shouldPrivatizeReductions(10, 200, 4));
+  ASSERT_FALSE(shouldPrivatizeReductions(100, 200, 4));
+  ASSERT_FALSE(shouldPrivatizeReductions(10, 200, 1));
+  taco_set_num_threads(4);
+  ASSERT_FALSE(taco_get_privatized_reductions());
+  Tensor<double> u("u", {10}, {Dense});
+  u(j) = A(i, j) * x(i);
+  u.compile();
+  ASSERT_EQ(std::string::npos, u.getSource().find("u_thread_vals"));
+
+  taco_set_privatized_reductions(true);
+  Tensor<double> y("y", {10}, {Dense});
+  y(j) = A(i, j) * x(i);
+  y.compile();
+  taco_set_privatized_reductions(false);
+  taco_set_num_threads(1);
+  ASSERT_NE(std::string::npos, y.getSource().find("y_thread_vals"));
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+}
+
 TEST(scheduling, multilevel_tiling) {
   Tensor<double> A("A", {8}, Format({Sparse}));
   Tensor<double> B("B", {8}, Format({Sparse}));
@@ -1054,6 +1135,142 @@ TEST(scheduling, divide) {
   });
 }
 
+TEST(scheduling, splitTailStrategies) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  const int dim = 37;
+  Tensor<double> a("a", {dim}, Dense);
+  Tensor<double> b("b", {dim}, Dense);
+  for (int i = 0; i < dim; i++) {
+    a.insert({i}, (double)i);
+    b.insert({i}, (double)(i % 5));
+  }
+  a.pack(); b.pack();
+
+  IndexVar i("i"), i0("i0"), i1("i1");
+
+  Tensor<double> expected("expected", {dim}, Dense);
+  expected(i) = a(i) + b(i);
+  expected.evaluate();
+
+  // Peeled splits guard a copy of the inner loop that only runs for the
+  // iterations that do not fit, so the main inner loop is branch-free.
+  Tensor<double> y("y", {dim}, Dense);
+  y(i) = a(i) + b(i);
+  IndexStmt stmt = y.getAssignment().concretize();
+  stmt = stmt.split(i, i0, i1, 16, TailStrategy::Peel);
+  std::stringstream ss;
+  ss << stmt;
+  EXPECT_NE(std::string::npos, ss.str().find("split(i, i0, i1, 16, Peel)"));
+  y.compile(stmt);
+  std::string source = y.getSource();
+  size_t guardedLoop = source.find("for (int32_t i1 = 0; i1 < 16; i1++)");
+  ASSERT_NE(std::string::npos, guardedLoop);
+  size_t peeledLoop = source.find("for (int32_t i1 = 0; i1 < 16; i1++)", 
+                                  guardedLoop + 1);
+  ASSERT_NE(std::string::npos, peeledLoop);
+  EXPECT_EQ(std::string::npos, source.find("continue", peeledLoop));
+  y.assemble();
+  y.compute();
+  ASSERT_TENSOR_EQ(expected, y);
+
+  Tensor<double> z("z", {dim}, Dense);
+  z(i) = a(i) + b(i);
+  stmt = z.getAssignment().concretize();
+  stmt = stmt.divide(i, i0, i1, 4, TailStrategy::Peel);
+  z.compile(stmt);
+  z.assemble();
+  z.compute();
+  ASSERT_TENSOR_EQ(expected, z);
+}
+
+TEST(scheduling, unrollAndJam) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  const int dim = 30;
+  const int K = 6;
+  Tensor<double> A("A", {dim, dim}, CSR);
+  Tensor<double> B("B", {dim, K}, {Dense, Dense});
+  Tensor<double> x("x", {dim}, Dense);
+  for (int i = 0; i < dim; i++) {
+    for (int j = i % 3; j < dim; j += 1 + i % 4) {
+      A.insert({i, j}, (double)(i + j));
+    }
+    for (int k = 0; k < K; k++) {
+      B.insert({i, k}, (double)((i * k) % 7));
+    }
+    x.insert({i}, (double)(i % 5));
+  }
+  A.pack(); B.pack(); x.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+
+  // The loop over the nonzeros of a row is jammed into the unrolled loop 
+  // over the columns of B, which accumulate into separate scalars.
+  Tensor<double> C("C", {dim, K}, {Dense, Dense});
+  C(i, k) = A(i, j) * B(j, k);
+  IndexStmt stmt = C.getAssignment().concretize();
+  stmt = stmt.reorder({i, k, j}).unroll(k, 4);
+  C.compile(stmt);
+  std::string source = C.getSource();
+  EXPECT_EQ(std::string::npos, source.find("#pragma unroll"));
+  EXPECT_NE(std::string::npos, source.find("k += 4"));
+  int rowLoops = 0;
+  for (size_t pos = source.find("for (int32_t jA"); pos != std::string::npos;
+       pos = source.find("for (int32_t jA", pos + 1)) {
+    rowLoops++;
+  }
+  // One loop runs the unrolled iterations and one the remaining iteration
+  EXPECT_EQ(2, rowLoops);
+  C.assemble();
+  C.compute();
+
+  Tensor<double> CExpected("CExpected", {dim, K}, {Dense, Dense});
+  CExpected(i, k) = A(i, j) * B(j, k);
+  CExpected.evaluate();
+  ASSERT_TENSOR_EQ(CExpected, C);
+
+  // Loops that store to locations that do not depend on the unrolled loop 
+  // variable are not jammed, since every copy updates the same components
+  Tensor<double> D("D", {dim, dim}, {Dense, Dense});
+  D(i, j) = A(i, j) * B(j, k);
+  stmt = D.getAssignment().concretize();
+  stmt = stmt.reorder({i, k, j}).unroll(k, 4);
+  D.compile(stmt);
+  source = D.getSource();
+  rowLoops = 0;
+  for (size_t pos = source.find("for (int32_t jA"); pos != std::string::npos;
+       pos = source.find("for (int32_t jA", pos + 1)) {
+    rowLoops++;
+  }
+  EXPECT_EQ(5, rowLoops);
+  D.assemble();
+  D.compute();
+
+  Tensor<double> DExpected("DExpected", {dim, dim}, {Dense, Dense});
+  DExpected(i, j) = A(i, j) * B(j, k);
+  DExpected.evaluate();
+  ASSERT_TENSOR_EQ(DExpected, D);
+
+  // Loops that update a result in every iteration are unrolled without 
+  // jamming, with a remainder loop for the last nonzeros of a row
+  Tensor<double> y("y", {dim}, Dense);
+  y(i) = A(i, j) * x(j);
+  stmt = y.getAssignment().concretize();
+  stmt = stmt.unroll(j, 4);
+  y.compile(stmt);
+  EXPECT_NE(std::string::npos, y.getSource().find("jA += 4"));
+  y.assemble();
+  y.compute();
+
+  Tensor<double> yExpected("yExpected", {dim}, Dense);
+  yExpected(i) = A(i, j) * x(j);
+  yExpected.evaluate();
+  ASSERT_TENSOR_EQ(yExpected, y);
+}
+
 TEST(scheduling, mergeby) {
   auto dim = 256;
   float sparsity = 0.1;
@@ -1125,6 +1342,349 @@ TEST(scheduling, mergeby) {
   });
 }
 
+TEST(scheduling, balancedParallelSchedule) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  const int dim = 200;
+  Tensor<double> A("A", {dim, dim}, CSR);
+  Tensor<double> D("D", {dim, dim}, {Dense, Dense});
+  Tensor<double> x("x", {dim}, Dense);
+
+  // A few rows hold most of the nonzeros
+  srand(90125);
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      auto rand_float = (float)rand()/(float)(RAND_MAX);
+      if (i % 50 == 7 || rand_float < 0.02) {
+        A.insert({i, j}, (double)((i + j) % 10));
+      }
+      D.insert({i, j}, (double)rand_float);
+    }
+    x.insert({i}, (double)(i % 4));
+  }
+  A.pack(); D.pack(); x.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  taco_set_parallel_schedule(ParallelSchedule::Balanced, 16);
+
+  // Rows are split across chunks of 16 nonzeros and partial rows are reduced
+  // into the result once per chunk.
+  Tensor<double> y("y", {dim}, Dense);
+  y(i) = A(i, j) * x(j);
+  y.compile();
+  EXPECT_NE(std::string::npos, y.getSource().find("taco_binarySearchBefore(A2_pos"));
+  EXPECT_NE(std::string::npos, y.getSource().find("y_row"));
+  y.assemble();
+  y.compute();
+
+  Tensor<double> C("C", {dim, dim}, {Dense, Dense});
+  C(i, k) = A(i, j) * D(j, k);
+  C.compile();
+  C.assemble();
+  C.compute();
+
+  // Operands that are indexed by the rows fall back to the static schedule
+  Tensor<double> E("E", {dim, dim}, {Dense, Dense});
+  E(i, j) = A(i, j) * D(i, j);
+  E.compile();
+  EXPECT_EQ(std::string::npos, E.getSource().find("taco_binarySearchBefore(A2_pos"));
+  E.assemble();
+  E.compute();
+
+  taco_set_parallel_schedule(ParallelSchedule::Static);
+
+  Tensor<double> yExpected("yExpected", {dim}, Dense);
+  yExpected(i) = A(i, j) * x(j);
+  yExpected.evaluate();
+  ASSERT_TENSOR_EQ(yExpected, y);
+
+  Tensor<double> CExpected("CExpected", {dim, dim}, {Dense, Dense});
+  CExpected(i, k) = A(i, j) * D(j, k);
+  CExpected.evaluate();
+  ASSERT_TENSOR_EQ(CExpected, C);
+
+  Tensor<double> EExpected("EExpected", {dim, dim}, {Dense, Dense});
+  EExpected(i, j) = A(i, j) * D(i, j);
+  EExpected.evaluate();
+  ASSERT_TENSOR_EQ(EExpected, E);
+}
+
+TEST(scheduling, segmentedAtomicReduction) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  const int dim = 40;
+  Tensor<double> A("A", {dim, dim}, CSR);
+  Tensor<double> B("B", {dim, dim, dim}, {Dense, Sparse, Sparse});
+  Tensor<double> x("x", {dim}, Dense);
+  for (int i = 0; i < dim; i++) {
+    for (int j = i % 3; j < dim; j += 1 + i % 5) {
+      A.insert({i, j}, (double)((i + j) % 7));
+      for (int k = j % 2; k < dim; k += 2 + i % 3) {
+        B.insert({i, j, k}, (double)((i + j + k) % 5));
+      }
+    }
+    x.insert({i}, (double)(i % 4));
+  }
+  A.pack(); B.pack(); x.pack();
+
+  IndexVar i("i"), j("j"), k("k"), f("f"), g("g");
+  IndexVar fpos("fpos"), chunk("chunk"), fpos2("fpos2");
+
+  // Chunks of three fused loops add each matrix component they reduce into 
+  // once, when the segment of the component ends or the chunk ends.
+  Tensor<double> Y("Y", {dim, dim}, {Dense, Dense});
+  Y(i, j) = B(i, j, k) * x(k);
+  IndexStmt stmt = Y.getAssignment().concretize();
+  stmt = stmt.fuse(i, j, f).fuse(f, k, g).pos(g, fpos, B(i, j, k))
+             .split(fpos, chunk, fpos2, 16)
+             .parallelize(chunk, ParallelUnit::CPUThread, 
+                          OutputRaceStrategy::Atomics);
+  Y.compile(stmt);
+  std::string source = Y.getSource();
+  size_t firstAtomic = source.find("#pragma omp atomic");
+  ASSERT_NE(std::string::npos, firstAtomic);
+  EXPECT_NE(std::string::npos, source.find("Y_row"));
+  EXPECT_EQ(std::string::npos, 
+            source.find("#pragma omp atomic", 
+                        source.find("#pragma omp atomic", firstAtomic + 1) + 1));
+  Y.assemble();
+  Y.compute();
+
+  Tensor<double> YExpected("YExpected", {dim, dim}, {Dense, Dense});
+  YExpected(i, j) = B(i, j, k) * x(k);
+  YExpected.evaluate();
+  ASSERT_TENSOR_EQ(YExpected, Y);
+
+  // Chunks of a split position loop reduce into a scalar of their own that 
+  // they add to the result once.
+  Tensor<double> y("y", {dim}, Dense);
+  y(i) = A(i, j) * x(j);
+  stmt = y.getAssignment().concretize();
+  stmt = stmt.pos(j, fpos, A(i, j)).split(fpos, chunk, fpos2, 4)
+             .parallelize(chunk, ParallelUnit::CPUThread, 
+                          OutputRaceStrategy::Atomics);
+  y.compile(stmt);
+  source = y.getSource();
+  EXPECT_LT(source.find("#pragma omp parallel for"), 
+            source.find("double tfpos2y_val"));
+  y.assemble();
+  y.compute();
+
+  Tensor<double> yExpected("yExpected", {dim}, Dense);
+  yExpected(i) = A(i, j) * x(j);
+  yExpected.evaluate();
+  ASSERT_TENSOR_EQ(yExpected, y);
+}
+
+TEST(scheduling, explicitVectorLoops) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  const int dim = 50;
+  Tensor<double> A("A", {dim, dim}, CSR);
+  Tensor<double> D("D", {dim, 8}, {Dense, Dense});
+  Tensor<double> x("x", {dim}, Dense);
+  for (int i = 0; i < dim; i++) {
+    for (int j = i % 4; j < dim; j += 1 + i % 3) {
+      A.insert({i, j}, (double)((i + j) % 9));
+    }
+    for (int k = 0; k < 8; k++) {
+      D.insert({i, k}, (double)((i * k) % 5));
+    }
+    x.insert({i}, (double)(i % 7));
+  }
+  A.pack(); D.pack(); x.pack();
+
+  IndexVar i("i"), j("j"), k("k"), jpos("jpos"), jpos0("jpos0"), jpos1("jpos1");
+
+  // Vector lanes gather x at the coordinates of A, are reduced horizontally, 
+  // and leave the iterations past the last full vector to a scalar loop.
+  Tensor<double> y("y", {dim}, Dense);
+  y(i) = A(i, j) * x(j);
+  IndexStmt stmt = y.getAssignment().concretize();
+  stmt = stmt.pos(j, jpos, A(i, j)).split(jpos, jpos0, jpos1, 6)
+             .parallelize(jpos1, ParallelUnit::CPUVector, 
+                          OutputRaceStrategy::ParallelReduction);
+  y.compile(stmt);
+  std::string source = y.getSource();
+  EXPECT_NE(std::string::npos, source.find("x_vals[j[3]]"));
+  EXPECT_NE(std::string::npos, source.find("_vec[3];"));
+  EXPECT_NE(std::string::npos, source.find("for (; jpos1 < 6; jpos1++)"));
+  EXPECT_EQ(std::string::npos, source.find("#pragma clang loop"));
+  y.assemble();
+  y.compute();
+
+  Tensor<double> yExpected("yExpected", {dim}, Dense);
+  yExpected(i) = A(i, j) * x(j);
+  yExpected.evaluate();
+  ASSERT_TENSOR_EQ(yExpected, y);
+
+  // Loops that are not straight-line code are vectorized with pragmas
+  Tensor<double> C("C", {dim, 8}, {Dense, Dense});
+  C(i, k) = A(i, j) * D(j, k);
+  stmt = C.getAssignment().concretize();
+  stmt = stmt.pos(j, jpos, A(i, j)).split(jpos, jpos0, jpos1, 4)
+             .reorder({jpos0, jpos1, k})
+             .parallelize(jpos1, ParallelUnit::CPUVector, 
+                          OutputRaceStrategy::IgnoreRaces);
+  C.compile(stmt);
+  EXPECT_NE(std::string::npos, C.getSource().find("#pragma clang loop"));
+  C.assemble();
+  C.compute();
+
+  Tensor<double> CExpected("CExpected", {dim, 8}, {Dense, Dense});
+  CExpected(i, k) = A(i, j) * D(j, k);
+  CExpected.evaluate();
+  ASSERT_TENSOR_EQ(CExpected, C);
+
+  // Gathers compute their location vector once rather than once per lane
+  ir::Expr n = ir::Var::make("n", Int32);
+  ir::Expr p = ir::Var::make("p", Int32);
+  ir::Expr idx = ir::Var::make("idx", Int32, true);
+  ir::Expr xVals = ir::Var::make("x_vals", Float64, true);
+  ir::Expr yVals = ir::Var::make("y_vals", Float64, true);
+  ir::Expr gather = ir::Load::make(xVals, 
+      ir::Mul::make(ir::Load::make(idx, p), 2));
+  ir::Stmt loop = ir::For::make(p, 0, n, 1, 
+                                ir::Store::make(yVals, p, gather),
+                                ir::LoopKind::Vectorized, 
+                                ParallelUnit::CPUVector);
+  std::stringstream gatherSource;
+  ir::CodeGen_C codegen(gatherSource, ir::CodeGen::ImplementationGen);
+  codegen.compile(ir::Function::make("gather", {yVals}, {xVals, idx, n}, 
+                                     loop), false);
+  EXPECT_NE(std::string::npos, gatherSource.str().find("x_vals[loc[3]]"));
+  EXPECT_EQ(std::string::npos, gatherSource.str().find("x_vals[((*"));
+}
+
+TEST(scheduling, parallelAssembly) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  const int dim = 100;
+  Tensor<double> A("A", {dim, dim}, CSR);
+  Tensor<double> B("B", {dim, dim}, CSR);
+
+  srand(4357);
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      if (rand() % 20 == 0) {
+        A.insert({i, j}, (double)(rand() % 10 + 1));
+      }
+      if (rand() % 25 == 0) {
+        B.insert({i, j}, (double)(rand() % 10 + 1));
+      }
+    }
+  }
+  A.pack(); B.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  taco_set_parallel_assembly(true);
+
+  Tensor<double> C("C", {dim, dim}, CSR);
+  C(i, j) = A(i, j) + B(i, j);
+  C.compile();
+  C.assemble();
+  C.compute();
+
+  Tensor<double> D("D", {dim, dim}, CSR);
+  D(i, k) = A(i, j) * B(j, k);
+  D.compile();
+  D.assemble();
+  D.compute();
+
+  taco_set_parallel_assembly(false);
+
+  // The pos arrays of both results are prefix summed in parallel
+  EXPECT_NE(std::string::npos, C.getSource().find("C2_pos_block_sums"));
+  EXPECT_NE(std::string::npos, D.getSource().find("D2_pos_block_sums"));
+
+  Tensor<double> CExpected("CExpected", {dim, dim}, CSR);
+  CExpected(i, j) = A(i, j) + B(i, j);
+  CExpected.evaluate();
+  ASSERT_EQ(std::string::npos, 
+            CExpected.getSource().find("CExpected2_pos_block_sums"));
+  ASSERT_TENSOR_EQ(CExpected, C);
+
+  Tensor<double> DExpected("DExpected", {dim, dim}, CSR);
+  DExpected(i, k) = A(i, j) * B(j, k);
+  DExpected.evaluate();
+  ASSERT_TENSOR_EQ(DExpected, D);
+}
+
+TEST(scheduling, mergeby_merge_path) {
+  auto dim = 256;
+  Tensor<double> A("A", {dim, dim}, {Sparse, Sparse});
+  Tensor<double> B("B", {dim, dim}, {Sparse, Sparse});
+  Tensor<double> x("x", {dim}, Sparse);
+  Tensor<double> z("z", {dim}, Sparse);
+  IndexVar i("i"), j("j");
+
+  srand(73127);
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      auto rand_float = (float)rand()/(float)(RAND_MAX);
+      if (rand_float < 0.05) {
+        A.insert({i, j}, (double)(i + j));
+      }
+      if (rand_float > 0.97 || (i > 200 && rand_float > 0.5)) {
+        B.insert({i, j}, 1.0);
+      }
+    }
+    if (i % 3 == 0) {
+      x.insert({i}, (double)i);
+    }
+    if (i % 7 == 0 || i > 230) {
+      z.insert({i}, 2.0);
+    }
+  }
+  A.pack(); B.pack(); x.pack(); z.pack();
+
+  auto testVector = [&](IndexExpr expr) {
+    Tensor<double> y("y", {dim}, Dense);
+    y(i) = expr;
+    IndexStmt stmt = y.getAssignment().concretize();
+    stmt = stmt.mergeby(i, MergeStrategy::MergePath)
+               .parallelize(i, ParallelUnit::CPUThread, 
+                            OutputRaceStrategy::NoRaces);
+    y.compile(stmt);
+    ASSERT_NE(std::string::npos, y.getSource().find("taco_lowerBound("));
+    y.evaluate();
+    Tensor<double> expected("expected", {dim}, Dense);
+    expected(i) = expr;
+    expected.evaluate();
+    ASSERT_TENSOR_EQ(expected, y);
+  };
+  testVector(x(i) + z(i));
+  testVector(x(i) * z(i));
+  testVector(x(i) - x(i) * z(i));
+
+  // Rows of the matrices are partitioned and merged in parallel, while their
+  // columns are merged sequentially.
+  Tensor<double> C("C", {dim, dim}, {Dense, Dense});
+  C(i, j) = A(i, j) + B(i, j);
+  IndexStmt stmt = C.getAssignment().concretize();
+  stmt = stmt.mergeby(i, MergeStrategy::MergePath)
+             .parallelize(i, ParallelUnit::CPUThread, 
+                          OutputRaceStrategy::NoRaces);
+  C.compile(stmt);
+  C.evaluate();
+  Tensor<double> expected("expected", {dim, dim}, {Dense, Dense});
+  expected(i, j) = A(i, j) + B(i, j);
+  expected.evaluate();
+  ASSERT_TENSOR_EQ(expected, C);
+
+  // Merging loops are only parallelized when merged by merge path.
+  Tensor<double> y("y", {dim}, Dense);
+  y(i) = x(i) + z(i);
+  stmt = y.getAssignment().concretize();
+  ASSERT_THROW(stmt.parallelize(i, ParallelUnit::CPUThread, 
+                                OutputRaceStrategy::NoRaces), 
+               taco::TacoException);
+}
+
 TEST(scheduling, mergeby_gallop_error) {
   Tensor<double> x("x", {8}, Format({Sparse}));
   Tensor<double> y("y", {8}, Format({Dense}));
@@ -5,6 +5,7 @@
 
 #include "taco/tensor.h"
 #include "taco/format.h"
+#include "taco/storage/allocator.h"
 #include "taco/util/strings.h"
 
 typedef int                     IndexType;
@@ -487,3 +488,86 @@ INSTANTIATE_TEST_CASE_P(tensor3, storage,
                     )
            )
 );
+
+TEST(storage, alignedAllocator) {
+  taco::AlignedAllocator allocator(128);
+  ASSERT_EQ(128u, allocator.getAlignment());
+  for (size_t size : {1, 7, 100, 4096}) {
+    char* ptr = (char*)allocator.allocate(size);
+    ASSERT_EQ(0u, (uintptr_t)ptr % 128);
+    for (size_t i = 0; i < size; ++i) {
+      ptr[i] = (char)i;
+    }
+    // Resizing preserves the contents and the alignment
+    ptr = (char*)allocator.reallocate(ptr, 2 * size);
+    ASSERT_EQ(0u, (uintptr_t)ptr % 128);
+    for (size_t i = 0; i < size; ++i) {
+      ASSERT_EQ((char)i, ptr[i]);
+    }
+    allocator.deallocate(ptr);
+  }
+  allocator.deallocate(nullptr);
+}
+
+TEST(storage, arenaAllocator) {
+  taco::ArenaAllocator arena(64, 1024);
+  void* a = arena.allocate(100);
+  void* b = arena.allocate(100);
+  ASSERT_EQ(0u, (uintptr_t)a % 64);
+  ASSERT_EQ(0u, (uintptr_t)b % 64);
+  ASSERT_NE(a, b);
+  ASSERT_EQ(1024u, arena.getCapacity());
+
+  // Allocations that exceed the chunk size get a chunk of their own
+  arena.allocate(4096);
+  ASSERT_EQ(1024u + 4096u + 64u, arena.getCapacity());
+  arena.reset();
+  ASSERT_EQ(0u, arena.getCapacity());
+}
+
+TEST(storage, allocatorKernels) {
+  auto previous = taco::getAllocator();
+  taco::setAllocator(std::make_shared<taco::AlignedAllocator>(256));
+
+  const int N = 37;
+  Tensor<double> A("A", {N, N}, Format({Dense, Sparse}));
+  Tensor<double> x("x", {N}, Format({Dense}));
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if ((i + j) % 3 == 0) {
+        A.insert({i, j}, (double)(i + j));
+      }
+    }
+    x.insert({i}, (double)i);
+  }
+  A.pack();
+  x.pack();
+  ASSERT_EQ(0u, (uintptr_t)A.getStorage().getValues().getData() % 256);
+
+  // Kernels assume the alignment of the allocator
+  taco::IndexVar i, j;
+  Tensor<double> y("y", {N}, Format({Dense}));
+  y(i) = A(i,j) * x(j);
+  y.compile();
+  ASSERT_NE(std::string::npos,
+            y.getSource().find("__builtin_assume_aligned(A->vals, 256)"));
+
+  // Kernels keep allocating with the allocator they were compiled with
+  taco::setAllocator(previous);
+  y.assemble();
+  y.compute();
+  ASSERT_EQ(0u, (uintptr_t)y.getStorage().getValues().getData() % 256);
+
+  Tensor<double> expected("expected", {N}, Format({Dense}));
+  for (int i = 0; i < N; ++i) {
+    double sum = 0.0;
+    for (int j = 0; j < N; ++j) {
+      if ((i + j) % 3 == 0) {
+        sum += (double)(i + j) * j;
+      }
+    }
+    expected.insert({i}, sum);
+  }
+  expected.pack();
+  ASSERT_TENSOR_EQ(expected, y);
+}
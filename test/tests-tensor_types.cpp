@@ -21,7 +21,7 @@ TYPED_TEST_P(ScalarTensorTest, types) {
 }
 REGISTER_TYPED_TEST_CASE_P(ScalarTensorTest, types);
 
-typedef ::testing::Types<int8_t, int16_t, int32_t, int64_t, long long, uint8_t, uint16_t, uint32_t, uint64_t, unsigned long long, float, double, std::complex<float>, std::complex<double>> AllTypes;
+typedef ::testing::Types<int8_t, int16_t, int32_t, int64_t, long long, uint8_t, uint16_t, uint32_t, uint64_t, unsigned long long, float16, bfloat16, float, double, std::complex<float>, std::complex<double>> AllTypes;
 INSTANTIATE_TYPED_TEST_CASE_P(tensor_types, ScalarTensorTest, AllTypes);
 
 
@@ -281,6 +281,31 @@ TEST(tensor_types, complex_accumulate) {
   ASSERT_TRUE(equals(expected,a));
 }
 
+template <typename T> class HalfAccumulateTest : public ::testing::Test {};
+TYPED_TEST_CASE_P(HalfAccumulateTest);
+TYPED_TEST_P(HalfAccumulateTest, types) {
+  // Sums past 2048 (float16) or 256 (bfloat16) stop growing when accumulated 
+  // in 16 bits, so this checks that reductions accumulate in float.
+  Tensor<TypeParam> a("a", {4096}, Format({Dense}));
+  for (int i = 0; i < 4096; ++i) {
+    a.insert({i}, (TypeParam) 1.0f);
+  }
+  a.pack();
+
+  Tensor<TypeParam> s("s");
+  s() = a(i);
+  s.evaluate();
+  ASSERT_EQ(4096.0f, (float)s.begin()->second);
+
+  Tensor<TypeParam> b("b", {2}, Format({Dense}));
+  b(j) = a(i);
+  b.evaluate();
+  ASSERT_EQ(4096.0f, (float)b.begin()->second);
+}
+REGISTER_TYPED_TEST_CASE_P(HalfAccumulateTest, types);
+typedef ::testing::Types<float16, bfloat16> HalfTypes;
+INSTANTIATE_TYPED_TEST_CASE_P(tensor_types, HalfAccumulateTest, HalfTypes);
+
 template <typename T>
 bool equalsExact(Tensor<T> a, Tensor<T> b) {
   auto at = iterate<T>(a);
@@ -379,6 +404,38 @@ TEST(tensor_types, int_float_promotion) {
   ASSERT_TRUE(equalsExact(a, expected));
 }
 
+TEST(tensor_types, accumulator_type) {
+  // 1e8 + 1 rounds to 1e8 in float, so the ones only survive if the products 
+  // are accumulated in double.
+  Tensor<float> B("B", {2, 17}, Format({Dense, Sparse}));
+  Tensor<double> c("c", {17}, Format({Dense}));
+  for (int j = 0; j < 17; j++) {
+    B.insert({0, j}, (j == 0) ? 1e8f : 1.0f);
+    B.insert({1, j}, (j == 0) ? 1e8f : 1.0f);
+    c.insert({j}, 1.0);
+  }
+  B.pack();
+  c.pack();
+
+  Tensor<float> a("a", {2}, Format({Dense}));
+  a(i) = B(i, j) * c(j);
+  a.setAccumulatorType(Float64);
+  ASSERT_EQ(Float64, a.getAssignment().getAccumulatorType());
+  a.evaluate();
+
+  Tensor<float> expected("expected", {2}, Format({Dense}));
+  expected.insert({0}, 1e8f + 16);
+  expected.insert({1}, 1e8f + 16);
+  expected.pack();
+  ASSERT_TRUE(equalsExact(a, expected));
+
+  Tensor<float> s("s");
+  s() = B(i, j);
+  s.setAccumulatorType(Float64);
+  s.evaluate();
+  ASSERT_EQ(2e8f + 32, s.begin()->second);
+}
+
 TEST(DISABLED_tensor_types, coordinate_types) {
   TensorData<double> testData = TensorData<double>({5, 3, 2}, {
     {{0,0,0}, 0.0},
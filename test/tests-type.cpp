@@ -1,6 +1,8 @@
 #include "test.h"
 #include "taco/type.h"
 
+#include <cmath>
+
 using namespace taco;
 using namespace std;
 
@@ -43,9 +45,39 @@ TYPED_TEST_P(FloatTest, types) {
   ASSERT_EQ(sizeof(TypeParam),   (size_t)t.getNumBytes());
 }
 REGISTER_TYPED_TEST_CASE_P(FloatTest, types);
-typedef ::testing::Types<float, double> GenericFloat;
+typedef ::testing::Types<float16, bfloat16, float, double> GenericFloat;
 INSTANTIATE_TYPED_TEST_CASE_P(Generic, FloatTest, GenericFloat);
 
+TEST(type, float16) {
+  ASSERT_EQ(0x3c00, float16(1.0f).getBits());
+  ASSERT_EQ(0x3555, float16(1.0f/3).getBits());
+  ASSERT_EQ(0xc000, float16(-2.0f).getBits());
+  ASSERT_EQ(0x7bff, float16(65504.0f).getBits());
+  ASSERT_EQ(0x7c00, float16(65520.0f).getBits());
+  ASSERT_EQ(0x7c00, float16(1e30f).getBits());
+  ASSERT_EQ(0x0001, float16(6e-8f).getBits());
+  ASSERT_EQ(0x0000, float16(2e-8f).getBits());
+  ASSERT_EQ(0x3c00, float16(1.0f + 1.0f/2048).getBits());
+  ASSERT_EQ(0x3c02, float16(1.0f + 3.0f/2048).getBits());
+  ASSERT_EQ(65504.0f, (float)float16(65504.0f));
+  ASSERT_EQ(0.5f, (float)float16(0.5f));
+  ASSERT_TRUE(std::isnan((float)float16(NAN)));
+  ASSERT_EQ(Float16, Float(16));
+  ASSERT_EQ(Float16, type<float16>());
+}
+
+TEST(type, bfloat16) {
+  ASSERT_EQ(0x3f80, bfloat16(1.0f).getBits());
+  ASSERT_EQ(0x3eab, bfloat16(1.0f/3).getBits());
+  ASSERT_EQ(0x3f80, bfloat16(1.0f + 1.0f/256).getBits());
+  ASSERT_EQ(0x3f82, bfloat16(1.0f + 3.0f/256).getBits());
+  ASSERT_FALSE(std::isinf((float)bfloat16(1e30f)));
+  ASSERT_EQ(0.5f, (float)bfloat16(0.5f));
+  ASSERT_TRUE(std::isnan((float)bfloat16(NAN)));
+  ASSERT_EQ(BFloat16, type<bfloat16>());
+  ASSERT_NE(Float16, BFloat16);
+}
+
 TEST(type, equality) {
   Datatype fp32(Datatype::Float32);
   Datatype fp32_2(Datatype::Float32);
@@ -1,3 +1,5 @@
+#include <atomic>
+
 #include <taco/index_notation/transformations.h>
 #include <codegen/codegen_c.h>
 #include <codegen/codegen_cuda.h>
@@ -7,6 +9,8 @@
 #include "taco/index_notation/index_notation.h"
 #include "codegen/codegen.h"
 #include "taco/lower/lower.h"
+#include "taco/storage/allocator.h"
+#include "taco/index_notation/kernel.h"
 
 using namespace taco;
 
@@ -599,3 +603,341 @@ TEST(workspaces, tile_dotProduct_3) {
   expected.compute();
   ASSERT_TENSOR_EQ(expected, A);
 }
+
+TEST(workspaces, pooledAcceleratedWorkspace) {
+  Tensor<double> A("A", {10, 10}, CSR);
+  Tensor<double> B("B", {10, 10}, CSR);
+  for (int i = 0; i < 10; i++) {
+    A.insert({i, (i * 3) % 10}, (double) i);
+    A.insert({i, (i * 5) % 10}, 1.0);
+    B.insert({i, (i * 7) % 10}, 2.0);
+    B.insert({i, i}, (double) i);
+  }
+  A.pack();
+  B.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> expected("expected", {10, 10}, CSR);
+  expected(i, k) = A(i, j) * B(j, k);
+  expected.evaluate();
+
+  for (bool pooled : {false, true}) {
+    set_workspace_pool_enabled(pooled);
+
+    Tensor<double> C("C", {10, 10}, CSR);
+    C(i, k) = A(i, j) * B(j, k);
+    IndexStmt stmt = C.getAssignment().concretize();
+    Assignment assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+                            .as<Forall>().getStmt().as<Assignment>();
+    stmt = reorderLoopsTopologically(stmt);
+    TensorVar w("w", Type(Float64, {10}), taco::dense);
+    stmt = stmt.precompute(assign.getRhs(), k, k, w);
+    stmt = stmt.assemble(C.getTensorVar(), AssembleStrategy::Insert, true);
+    C.compile(stmt);
+    ASSERT_EQ(pooled, C.getSource().find("taco_workspace(&") != std::string::npos);
+
+    // Pooled workspaces are reused, so repeated invocations of the kernels
+    // must still see guard arrays that are cleared.
+    for (int rep = 0; rep < 3; rep++) {
+      C.assemble();
+      C.compute();
+      ASSERT_TENSOR_EQ(expected, C);
+    }
+  }
+  set_workspace_pool_enabled(false);
+}
+
+namespace {
+/// Counts the allocations that have not been deallocated.
+struct CountingAllocator : public MallocAllocator {
+  std::atomic<int> numLive{0};
+
+  void* allocate(size_t size) override {
+    numLive++;
+    return MallocAllocator::allocate(size);
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    if (ptr == nullptr) {
+      numLive++;
+    }
+    return MallocAllocator::reallocate(ptr, size);
+  }
+
+  void deallocate(void* ptr) override {
+    if (ptr != nullptr) {
+      numLive--;
+    }
+    MallocAllocator::deallocate(ptr);
+  }
+};
+}
+
+TEST(workspaces, pooledWorkspaceRelease) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  Tensor<double> A("A", {10, 10}, CSR);
+  Tensor<double> B("B", {10, 10}, CSR);
+  for (int i = 0; i < 10; i++) {
+    A.insert({i, (i * 3) % 10}, (double) i);
+    B.insert({i, (i * 7) % 10}, 2.0);
+  }
+  A.pack();
+  B.pack();
+
+  auto previous = getAllocator();
+  auto counting = std::make_shared<CountingAllocator>();
+  setAllocator(counting);
+  set_workspace_pool_enabled(true);
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> C("C", {10, 10}, Format({Dense, Dense}));
+  C(i, k) = A(i, j) * B(j, k);
+  IndexStmt stmt = C.getAssignment().concretize();
+  Assignment assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+                          .as<Forall>().getStmt().as<Assignment>();
+  stmt = reorderLoopsTopologically(stmt);
+  TensorVar w("w", Type(Float64, {10}), taco::dense);
+  stmt = stmt.precompute(assign.getRhs(), k, k, w);
+
+  // Pooled workspaces are released when the module of the kernel is destroyed
+  int numLive;
+  {
+    Kernel kernel = compile(stmt);
+    ASSERT_TRUE(kernel({C.getStorage(), A.getStorage(), B.getStorage()}));
+    numLive = counting->numLive;
+  }
+  ASSERT_GT(numLive, counting->numLive);
+
+  set_workspace_pool_enabled(false);
+  setAllocator(previous);
+}
+
+TEST(workspaces, threadPrivateAcceleratedWorkspace) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  Tensor<double> A("A", {10, 10}, CSR);
+  Tensor<double> B("B", {10, 10}, CSR);
+  for (int i = 0; i < 10; i++) {
+    A.insert({i, (i * 3) % 10}, (double) i);
+    A.insert({i, (i * 5) % 10}, 1.0);
+    B.insert({i, (i * 7) % 10}, 2.0);
+    B.insert({i, i}, (double) i);
+  }
+  A.pack();
+  B.pack();
+
+  IndexVar i("i"), j("j"), k("k"), i0("i0"), i1("i1");
+  Tensor<double> expected("expected", {10, 10}, CSR);
+  expected(i, k) = A(i, j) * B(j, k);
+  expected.evaluate();
+
+  Tensor<double> C("C", {10, 10}, CSR);
+  C(i, k) = A(i, j) * B(j, k);
+  IndexStmt stmt = C.getAssignment().concretize();
+  Assignment assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+                          .as<Forall>().getStmt().as<Assignment>();
+  stmt = reorderLoopsTopologically(stmt);
+  TensorVar w("w", Type(Float64, {10}), taco::dense);
+  stmt = stmt.precompute(assign.getRhs(), k, k, w);
+  stmt = stmt.assemble(C.getTensorVar(), AssembleStrategy::Insert, true);
+  stmt = stmt.split(i, i0, i1, 4)
+             .parallelize(i0, ParallelUnit::CPUThread, 
+                          OutputRaceStrategy::NoRaces);
+  C.compile(stmt);
+
+  // The workspace of the serial loop over i1 is allocated once per thread
+  // by the parallel loop over i0
+  std::string source = C.getSource();
+  source = source.substr(source.find("int compute("));
+  ASSERT_LT(source.find("w_already_set_all = taco_calloc("), 
+            source.find("for (int32_t i0"));
+  ASSERT_EQ(std::string::npos, source.find("w_already_set = taco_calloc("));
+
+  C.assemble();
+  C.compute();
+  ASSERT_TENSOR_EQ(expected, C);
+}
+
+TEST(workspaces, hashAndHeapWorkspaces) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  Tensor<double> A("A", {20, 20}, CSR);
+  Tensor<double> B("B", {20, 100}, CSR);
+  for (int i = 0; i < 20; i++) {
+    for (int j = 0; j < 20; j += 1 + i % 3) {
+      A.insert({i, j}, (double) (i + j));
+    }
+  }
+  for (int j = 0; j < 20; j++) {
+    for (int k = j % 4; k < 100; k += 2 + j % 5) {
+      B.insert({j, k}, 1.0 + k % 3);
+    }
+  }
+  A.pack();
+  B.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> expected("expected", {20, 100}, CSR);
+  expected(i, k) = A(i, j) * B(j, k);
+  expected.evaluate();
+
+  const std::vector<std::pair<WorkspaceStrategy,std::string>> strategies = {
+      {WorkspaceStrategy::Hash, "taco_hash_locate(w_hash_keys"},
+      {WorkspaceStrategy::Heap, "taco_heap_push(w_heap"}};
+  for (const auto& strategy : strategies) {
+    for (bool insert : {false, true}) {
+      SCOPED_TRACE(std::string(WorkspaceStrategy_NAMES[(int)strategy.first]) + 
+                   (insert ? " insert" : " append"));
+      Tensor<double> C("C", {20, 100}, CSR);
+      C(i, k) = A(i, j) * B(j, k);
+      IndexStmt stmt = C.getAssignment().concretize();
+      Assignment assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+                              .as<Forall>().getStmt().as<Assignment>();
+      stmt = reorderLoopsTopologically(stmt);
+      TensorVar w("w", Type(Float64, {100}), taco::dense);
+      stmt = stmt.precompute(assign.getRhs(), k, k, w)
+                 .wsstrategy(w, strategy.first);
+      if (insert) {
+        stmt = stmt.assemble(C.getTensorVar(), AssembleStrategy::Insert, true);
+      }
+      C.compile(stmt);
+
+      // Rows have more nonzeros than fit in the initial hash tables and heaps,
+      // which therefore grow
+      ASSERT_NE(std::string::npos, C.getSource().find(strategy.second));
+      ASSERT_EQ(std::string::npos, C.getSource().find("w_already_set"));
+
+      C.assemble();
+      C.compute();
+      ASSERT_TENSOR_EQ(expected, C);
+    }
+  }
+
+  ASSERT_EQ(WorkspaceStrategy::Dense, chooseWorkspaceStrategy(8, 1000));
+  ASSERT_EQ(WorkspaceStrategy::Dense, chooseWorkspaceStrategy(1 << 16, 1 << 20));
+  ASSERT_EQ(WorkspaceStrategy::Heap, chooseWorkspaceStrategy(8, 1 << 20));
+  ASSERT_EQ(WorkspaceStrategy::Hash, chooseWorkspaceStrategy(1000, 1 << 20));
+}
+
+TEST(workspaces, chooseStrategyCooOperand) {
+  // Row sizes are also estimated for operands whose indices have no size
+  Format COO({ModeFormat::Compressed(ModeFormat::NOT_UNIQUE),
+              ModeFormat::Singleton});
+  Tensor<double> A("A", {20, 20}, CSR);
+  Tensor<double> B("B", {20, 30}, COO);
+  Tensor<double> Bcsr("Bcsr", {20, 30}, CSR);
+  for (int i = 0; i < 20; i++) {
+    for (int j = i % 2; j < 20; j += 2) {
+      A.insert({i, j}, (double) (i + j));
+    }
+  }
+  for (int j = 0; j < 20; j++) {
+    for (int k = j % 3; k < 30; k += 3) {
+      B.insert({j, k}, 1.0 + k % 4);
+      Bcsr.insert({j, k}, 1.0 + k % 4);
+    }
+  }
+  A.pack();
+  B.pack();
+  Bcsr.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> expected("expected", {20, 30}, CSR);
+  expected(i, k) = A(i, j) * Bcsr(j, k);
+  expected.evaluate();
+
+  Tensor<double> C("C", {20, 30}, CSR);
+  C(i, k) = A(i, j) * B(j, k);
+  C.evaluate();
+  ASSERT_TENSOR_EQ(expected, C);
+}
+
+TEST(workspaces, hashedWorkspaceFormat) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  Tensor<double> A("A", {20, 20}, CSR);
+  Tensor<double> B("B", {20, 100}, CSR);
+  for (int i = 0; i < 20; i++) {
+    for (int j = i % 2; j < 20; j += 2) {
+      A.insert({i, j}, (double) (i + j));
+    }
+  }
+  for (int j = 0; j < 20; j++) {
+    for (int k = j % 3; k < 100; k += 3) {
+      B.insert({j, k}, 1.0 + k % 4);
+    }
+  }
+  A.pack();
+  B.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> expected("expected", {20, 100}, CSR);
+  expected(i, k) = A(i, j) * B(j, k);
+  expected.evaluate();
+
+  for (bool insert : {false, true}) {
+    SCOPED_TRACE(insert ? "insert" : "append");
+    Tensor<double> C("C", {20, 100}, CSR);
+    C(i, k) = A(i, j) * B(j, k);
+    IndexStmt stmt = C.getAssignment().concretize();
+    Assignment assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+                            .as<Forall>().getStmt().as<Assignment>();
+    stmt = reorderLoopsTopologically(stmt);
+    TensorVar w("w", Type(Float64, {100}), Format({Hashed}));
+    stmt = stmt.precompute(assign.getRhs(), k, k, w);
+    if (insert) {
+      stmt = stmt.assemble(C.getTensorVar(), AssembleStrategy::Insert, true)
+                 .parallelize(i, ParallelUnit::CPUThread, 
+                              OutputRaceStrategy::NoRaces);
+    }
+    C.compile(stmt);
+
+    // The hashed workspace accumulates into a hash table, whose coordinates
+    // are sorted before they are appended to the result
+    ASSERT_NE(std::string::npos, C.getSource().find("taco_hash_locate(w_hash_keys"));
+    ASSERT_NE(std::string::npos, C.getSource().find("qsort(w_index_list"));
+
+    C.assemble();
+    C.compute();
+    ASSERT_TENSOR_EQ(expected, C);
+  }
+}
+
+TEST(workspaces, hashedWorkspaceUnsupported) {
+  if (should_use_CUDA_codegen()) {
+    return;
+  }
+  Tensor<double> A("A", {20, 20}, CSR);
+  Tensor<double> B("B", {20, 100}, CSR);
+  A.insert({1, 2}, 1.0);
+  B.insert({2, 3}, 2.0);
+  A.pack();
+  B.pack();
+
+  IndexVar i("i"), j("j"), k("k");
+  Tensor<double> C("C", {20, 100}, {Dense, Dense});
+  C(i, k) = A(i, j) * B(j, k);
+  IndexStmt stmt = C.getAssignment().concretize();
+  Assignment assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+                          .as<Forall>().getStmt().as<Assignment>();
+
+  // Hashed workspaces of higher order are not supported
+  TensorVar w2("w2", Type(Float64, {20, 100}), Format({Dense, Hashed}));
+  ASSERT_THROW(C.compile(stmt.precompute(assign.getRhs(), {i, k}, {i, k}, w2)),
+               taco::TacoException);
+
+  // Nor are hashed workspace vectors whose values are copied to dense results
+  Tensor<double> D("D", {20, 100}, {Dense, Dense});
+  D(i, k) = A(i, j) * B(j, k);
+  stmt = reorderLoopsTopologically(D.getAssignment().concretize());
+  assign = stmt.as<Forall>().getStmt().as<Forall>().getStmt()
+               .as<Forall>().getStmt().as<Assignment>();
+  TensorVar w("w", Type(Float64, {100}), Format({Hashed}));
+  ASSERT_THROW(D.compile(stmt.precompute(assign.getRhs(), k, k, w)),
+               taco::TacoException);
+}
@@ -190,7 +190,11 @@ static void printUsageInfo() {
   cout << endl;
   printFlag("cuda", "Generate CUDA code for NVIDIA GPUs");
   cout << endl;
-  printFlag("schedule", "Specify parallel execution schedule");
+  printFlag("schedule", "Specify parallel execution schedule: static, "
+            "dynamic, or balanced, optionally followed by a chunk size. The "
+            "balanced schedule gives every thread the same number of "
+            "nonzeros and its chunk size is a number of nonzeros. "
+            "Examples: dynamic,16, balanced,4096.");
   cout << endl;
   printFlag("nthreads", "Specify number of threads for parallel execution");
   cout << endl;
@@ -232,7 +236,18 @@ static void printSchedulingHelp() {
     printFlag("s=split(i, i0, i1, factor)", "Splits (strip-mines) an index "
               "variable `i` into two nested index variables `i0` and `i1`. The "
               "size of the inner index variable `i1` is then held constant at "
-              "`factor`, which must be a positive integer.");
+              "`factor`, which must be a positive integer. An optional fifth "
+              "parameter selects how iterations past the end of `i` are "
+              "handled: GuardWithIf (the default) guards every iteration of "
+              "`i1`, while Peel guards a copy of the `i1` loop that only runs "
+              "when the loop does not fit.");
+    cout << endl;
+    printFlag("s=divide(i, i0, i1, n)", "Divides an index variable `i` "
+              "into two nested index variables `i0` and `i1`. The size of the "
+              "outer index variable `i0` is then held constant at `n`, which "
+              "must be a positive integer. An optional fifth parameter "
+              "selects how iterations past the end of `i` are handled, as for "
+              "`split`.");
     cout << endl;
     printFlag("s=precompute(expr, i, iw)", "Leverages scratchpad memories and "
               "reorders computations to increase locality.  Given a subexpression "
@@ -255,7 +270,9 @@ static void printSchedulingHelp() {
     cout << endl;
     printFlag("s=unroll(index, factor)", "Unrolls the loop corresponding to an "
               "index variable `i` by `factor` number of iterations, where "
-              "`factor` is a positive integer.");
+              "`factor` is a positive integer. Loops nested in the unrolled "
+              "loop whose bounds do not depend on `i` are jammed, so that "
+              "they run all unrolled iterations together.");
     cout << endl;
     printFlag("s=parallelize(i, u, strat)", "tags an index variable `i` for "
               "parallel execution on hardware type `u`. Data races are handled by "
@@ -321,6 +338,16 @@ static bool setSchedulingCommands(vector<vector<string>> scheduleCommands, parse
     abort(); // to silence a warning: control reaches end of non-void function
   };
 
+  // The optional fifth parameter of split and divide
+  auto parseTailStrategy = [](const vector<string>& scheduleCommand) {
+    if (scheduleCommand.size() < 5 || scheduleCommand[4] == "GuardWithIf") {
+      return TailStrategy::GuardWithIf;
+    }
+    taco_uassert(scheduleCommand[4] == "Peel")
+        << "Tail strategy '" << scheduleCommand[4] << "' not defined.";
+    return TailStrategy::Peel;
+  };
+
   bool isGPU = false;
 
   for(vector<string> scheduleCommand : scheduleCommands) {
@@ -353,8 +380,8 @@ static bool setSchedulingCommands(vector<vector<string>> scheduleCommands, parse
       stmt = stmt.fuse(findVar(i), findVar(j), fused);
 
     } else if (command == "split") {
-      taco_uassert(scheduleCommand.size() == 4)
-          << "'split' scheduling directive takes 4 parameters: split(i, i1, i2, splitFactor)";
+      taco_uassert(scheduleCommand.size() == 4 || scheduleCommand.size() == 5)
+          << "'split' scheduling directive takes 4 or 5 parameters: split(i, i1, i2, splitFactor [, tailStrategy])";
       string i, i1, i2;
       size_t splitFactor;
       i = scheduleCommand[0];
@@ -365,10 +392,11 @@ static bool setSchedulingCommands(vector<vector<string>> scheduleCommands, parse
 
       IndexVar split1(i1);
       IndexVar split2(i2);
-      stmt = stmt.split(findVar(i), split1, split2, splitFactor);
+      stmt = stmt.split(findVar(i), split1, split2, splitFactor,
+                        parseTailStrategy(scheduleCommand));
     } else if (command == "divide") {
-      taco_uassert(scheduleCommand.size() == 4)
-          << "'divide' scheduling directive takes 4 parameters: divide(i, i1, i2, divFactor)";
+      taco_uassert(scheduleCommand.size() == 4 || scheduleCommand.size() == 5)
+          << "'divide' scheduling directive takes 4 or 5 parameters: divide(i, i1, i2, divFactor [, tailStrategy])";
       string i, i1, i2;
       i = scheduleCommand[0];
       i1 = scheduleCommand[1];
@@ -380,7 +408,8 @@ static bool setSchedulingCommands(vector<vector<string>> scheduleCommands, parse
 
       IndexVar divide1(i1);
       IndexVar divide2(i2);
-      stmt = stmt.divide(findVar(i), divide1, divide2, divideFactor);
+      stmt = stmt.divide(findVar(i), divide1, divide2, divideFactor,
+                         parseTailStrategy(scheduleCommand));
     } else if (command == "precompute") {
       string exprStr, i, iw, name;
       vector<string> i_vars, iw_vars;
@@ -506,6 +535,8 @@ static bool setSchedulingCommands(vector<vector<string>> scheduleCommands, parse
         strategy = MergeStrategy::TwoFinger;
       } else if (strat == "Gallop") {
         strategy = MergeStrategy::Gallop;
+      } else if (strat == "MergePath") {
+        strategy = MergeStrategy::MergePath;
       } else {
         taco_uerror << "Merge strategy not defined.";
         goto end;
@@ -996,6 +1027,8 @@ int main(int argc, char* argv[]) {
         sched = ParallelSchedule::Static;
       } else if (descriptor[0] == "dynamic") {
         sched = ParallelSchedule::Dynamic;
+      } else if (descriptor[0] == "balanced") {
+        sched = ParallelSchedule::Balanced;
       } else {
         return reportError("Incorrect -schedule usage", 3);
       }